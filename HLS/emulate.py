@@ -0,0 +1,428 @@
+"""Turn a design point's ACCEL pragmas into CPU parallelism for emulation.
+
+Reads a kernel from data/sources and one design point from data/designs,
+resolves every auto{...} placeholder to the point's value and, in front of each
+loop with PARALLEL FACTOR > 1, adds the closest CPU directive that keeps the
+loop's semantics:
+
+  - `#pragma omp simd` on an innermost loop whose iterations are independent,
+  - `#pragma omp parallel for` on the outermost such loop of a nest,
+  - `#pragma GCC unroll <factor>` (at most MAX_UNROLL) otherwise, which is
+    always legal.
+
+Independence is checked conservatively on the loop body: every array the body
+writes must be accessed with one subscript list that contains the bare loop
+variable, and every scalar it writes must either be assigned, from an
+expression that does not read it, before use in each iteration (made private)
+or be a sum reduction. Bodies with calls, jumps or
+pointer accesses are never parallelised. PIPELINE and TILE have no CPU
+counterpart and are only resolved. Sum reductions under omp reassociate the
+additions, as the hardware does, so results match the original within
+floating-point tolerance rather than bitwise.
+
+Usage: python3 emulate.py <kernel> <design point key or index>
+           [--designs ../data/designs/v18] [-o output.c]
+       python3 emulate.py --check
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+SOURCES_DIR = "../data/sources"
+DESIGNS_DIR = "../data/designs/v18"
+
+# data/designs names that differ from the data/sources file stem.
+SOURCE_STEMS = {
+    "stencil": "stencil_stencil2d",
+}
+
+# Unrolling further only grows the code; hardware factors reach the trip count.
+MAX_UNROLL = 16
+
+MATH_FUNCTIONS = {"sqrt", "pow", "fabs", "exp", "log"}
+KEYWORDS = {"for", "if", "else", "while", "do", "switch", "sizeof", "return"}
+TYPE_WORDS = {"int", "long", "double", "float", "char", "unsigned", "short", "const"}
+ASSIGN_OPS = {"=", "+=", "-=", "*=", "/=", "%=", "<<=", ">>=", "&=", "|=", "^="}
+
+TOKEN = re.compile(
+    r"\s*(?:(\d+\.?\d*(?:[eE][-+]?\d+)?[LlUuFf]*)|(\w+)|"
+    r"(<<=|>>=|->|\+\+|--|\+=|-=|\*=|/=|%=|&=|\|=|\^=|==|!=|<=|>=|&&|\|\||.))"
+)
+
+
+def blank_comments(code):
+    """Replace comments by spaces so that offsets stay valid."""
+
+    def blank(m):
+        return re.sub(r"[^\n]", " ", m.group(0))
+
+    return re.sub(r"//[^\n]*|/\*.*?\*/", blank, code, flags=re.DOTALL)
+
+
+def tokenize(code, base=0):
+    """Return (token, offset) pairs; offsets are shifted by base."""
+    return [
+        (m.group(m.lastindex), base + m.start(m.lastindex))
+        for m in TOKEN.finditer(code)
+        if m.lastindex
+    ]
+
+
+def match_close(code, pos, open_ch, close_ch):
+    """Offset just past the bracket closing the one at code[pos]."""
+    depth = 0
+    for i in range(pos, len(code)):
+        if code[i] == open_ch:
+            depth += 1
+        elif code[i] == close_ch:
+            depth -= 1
+            if depth == 0:
+                return i + 1
+    raise ValueError("unbalanced brackets")
+
+
+class Loop:
+    def __init__(self, code, start):
+        self.start = start  # offset of 'for'
+        lparen = code.index("(", start)
+        rparen = match_close(code, lparen, "(", ")")
+        self.header = code[lparen + 1 : rparen - 1]
+        body = rparen
+        while code[body].isspace():
+            body += 1
+        if code[body] == "{":
+            self.body_start, self.end = body + 1, match_close(code, body, "{", "}")
+            self.body = code[self.body_start : self.end - 1]
+        else:
+            self.body_start, self.end = body, code.index(";", body) + 1
+            self.body = code[self.body_start : self.end]
+        self.pragmas = []  # resolved ACCEL pragmas in front of the loop
+        self.factor = 1
+        self.parent = None
+        self.children = []
+        self.tail = ""  # code after the loop up to the end of its function
+        self.directive = None
+        self.var = self.canonical_var()
+
+    def canonical_var(self):
+        parts = self.header.split(";")
+        if len(parts) != 3:
+            return None
+        init = re.match(r"\s*(?:(?:int|long)\s+)?(\w+)\s*=", parts[0])
+        if not init:
+            return None
+        var = init.group(1)
+        if not re.match(rf"\s*{var}\s*(<|<=)", parts[1]):
+            return None
+        if not re.fullmatch(rf"\s*({var}\s*\+\+|\+\+\s*{var}|{var}\s*\+=\s*1)\s*", parts[2]):
+            return None
+        return var
+
+    def contains(self, other):
+        return self.body_start <= other.start < self.end
+
+    def innermost(self):
+        return re.search(r"\bfor\s*\(", self.body) is None
+
+
+def accesses(tokens):
+    """Yield (name, subscripts, kind, index, end, depth, opens) per access.
+
+    kind is 'write' for the target of an assignment or increment, 'decl' for a
+    variable declared in the body and 'read' otherwise. index and end delimit
+    the access in tokens, depth is its brace depth and opens tells whether it
+    starts a statement (or the init clause of a for).
+    """
+    depth = 0
+    for i, tok in enumerate(tokens):
+        if tok == "{":
+            depth += 1
+        elif tok == "}":
+            depth -= 1
+        if not re.match(r"[A-Za-z_]\w*$", tok) or tok in KEYWORDS or tok in TYPE_WORDS:
+            continue
+        if i + 1 < len(tokens) and tokens[i + 1] == "(":
+            continue  # function call, checked separately
+        j, subscripts = i + 1, []
+        while j < len(tokens) and tokens[j] == "[":
+            k, level = j, 0
+            while True:
+                level += {"[": 1, "]": -1}.get(tokens[k], 0)
+                if level == 0:
+                    break
+                k += 1
+            subscripts.append(tuple(tokens[j + 1 : k]))
+            j = k + 1
+        prev = tokens[i - 1] if i else ";"
+        following = tokens[j] if j < len(tokens) else ";"
+        if prev in TYPE_WORDS or (prev == "," and declared_list(tokens, i)):
+            kind = "decl"
+        elif following in ASSIGN_OPS or following in ("++", "--") or prev in ("++", "--"):
+            kind = "write"
+        else:
+            kind = "read"
+        opens = prev in (";", "{", "}") or (
+            prev == "(" and i >= 2 and tokens[i - 2] == "for"
+        )
+        yield tok, tuple(subscripts), kind, i, j, depth, opens
+
+
+def declared_list(tokens, i):
+    """Whether tokens[i] follows a comma inside a declaration statement."""
+    k = i - 1
+    while k >= 0 and tokens[k] not in (";", "{", "}"):
+        k -= 1
+    return k + 1 < len(tokens) and tokens[k + 1] in TYPE_WORDS
+
+
+def body_accesses(loop):
+    """Return (tokens, {name: [access...]}) for the loop body, or None when the
+    body contains constructs that are never parallelised."""
+    tokens = tokenize(loop.body, loop.body_start)
+    texts = [t for t, _ in tokens]
+    for i, tok in enumerate(texts):
+        if tok in ("return", "break", "continue", "goto", "while", "->"):
+            return None
+        if tok == "(" and i and re.match(r"\w+$", texts[i - 1]):
+            name = texts[i - 1]
+            if name not in KEYWORDS and name not in MATH_FUNCTIONS:
+                return None
+        if tok == "*" and (i == 0 or texts[i - 1] in (";", "{", "}", "(", "=", ",")):
+            return None  # pointer dereference
+
+    occurrences, locals_ = {}, set()
+    for name, subs, kind, i, end, depth, opens in accesses(texts):
+        if kind == "decl":
+            locals_.add(name)
+        elif name not in locals_:
+            access = (subs, kind, i, end, depth, opens, tokens[i][1])
+            occurrences.setdefault(name, []).append(access)
+    return texts, occurrences
+
+
+def analyse(loop):
+    """Return (private, reductions) if the loop's iterations are independent."""
+    accessed = body_accesses(loop)
+    if accessed is None:
+        return None
+    texts, occurrences = accessed
+
+    private, reductions = [], []
+    for name, occ in occurrences.items():
+        if not any(a[1] == "write" for a in occ):
+            continue
+        if name == loop.var:
+            return None  # the loop variable is modified in the body
+        if any(a[0] for a in occ):
+            first = occ[0][0]
+            if any(a[0] != first for a in occ) or (loop.var,) not in first:
+                return None
+            continue
+        role = scalar_role(loop, name, texts, occ)
+        if role is None:
+            return None
+        (private if role == "private" else reductions).append(name)
+    if used_after(loop.var, loop.tail):
+        return None
+    return private, reductions
+
+
+def scalar_role(loop, name, texts, occ):
+    """'reduction', 'private' or None for a scalar written in the loop body."""
+    if is_reduction(texts, occ):
+        return "reduction"
+    if used_after(name, loop.tail):
+        return None
+    _, kind, _, end, depth, opens, _ = occ[0]
+    if kind == "write" and depth == 0 and opens and texts[end] == "=":
+        # Private only if the assignment does not read the previous value,
+        # as in the recurrence `s = s * 2.0 + A[i]`.
+        stop = texts.index(";", end)
+        if any(end < a[2] < stop for a in occ):
+            return None
+        return "private"
+    # A scalar confined to one inner loop and private there is private here.
+    for inner in loop.children:
+        if all(inner.start <= a[6] < inner.end for a in occ):
+            accessed = body_accesses(inner)
+            if accessed is None or name not in accessed[1]:
+                return None
+            inner_texts, inner_occurrences = accessed
+            role = scalar_role(inner, name, inner_texts, inner_occurrences[name])
+            return role if role == "private" else None
+    return None
+
+
+def is_reduction(tokens, occ):
+    """Every access is `s += e` or `s = s + e` with s not otherwise read."""
+    writes = [o for o in occ if o[1] == "write"]
+    reads = [o for o in occ if o[1] == "read"]
+    for _, _, i, end, _, _, _ in writes:
+        op = tokens[end]
+        if op == "+=":
+            continue
+        if op == "=" and end + 2 < len(tokens) and tokens[end + 1] == tokens[i] and tokens[end + 2] == "+":
+            continue
+        return False
+    # The only reads allowed are the right-hand `s` of `s = s + e`.
+    allowed = {end + 1 for _, _, _, end, _, _, _ in writes if tokens[end] == "="}
+    return all(i in allowed for _, _, i, _, _, _, _ in reads)
+
+
+def used_after(name, tail):
+    """Whether code after the loop reads `name` before assigning it."""
+    for m in re.finditer(rf"\b{name}\b(\s*(=(?!=))?)", tail):
+        return not m.group(2)
+    return False
+
+
+def resolve(code, point):
+    """Substitute auto{__X__} placeholders with the design point's values."""
+
+    def value(m):
+        key = m.group(1)
+        if key.startswith("__PARA__") or key.startswith("__TILE__"):
+            return str(point.get(key, 1))
+        return str(point.get(key, "off"))
+
+    return re.sub(r"auto\{(__\w+__\w+)\}", value, code)
+
+
+def transform(code, point):
+    code = resolve(code, point)
+    commented = blank_comments(code)
+    plain = re.sub(r"^[ \t]*#[^\n]*", lambda m: " " * len(m.group(0)), commented, flags=re.MULTILINE)
+    loops = [Loop(plain, m.start()) for m in re.finditer(r"\bfor\s*\(", plain)]
+    function_ends = [m.start() for m in re.finditer(r"^\}", plain, re.MULTILINE)]
+    for loop in loops:
+        enclosing = [outer for outer in loops if outer is not loop and outer.contains(loop)]
+        loop.parent = max(enclosing, key=lambda outer: outer.start, default=None)
+        if loop.parent is not None:
+            loop.parent.children.append(loop)
+        end = min((e for e in function_ends if e >= loop.end), default=len(plain))
+        loop.tail = plain[loop.end : end]
+
+    # Attach every ACCEL pragma to the first loop after it.
+    for m in re.finditer(r"^[ \t]*#pragma ACCEL (PARALLEL|PIPELINE|TILE)\b[^\n]*", commented, re.MULTILINE):
+        loop = next((l for l in loops if l.start > m.end()), None)
+        if loop is None:
+            continue
+        loop.pragmas.append(m.group(0).strip())
+        factor = re.search(r"FACTOR=(\d+)", m.group(0))
+        if m.group(1) == "PARALLEL" and factor:
+            loop.factor = max(loop.factor, int(factor.group(1)))
+
+    for loop in loops:
+        if loop.factor <= 1:
+            continue
+        legal = loop.var is not None and analyse(loop)
+        ancestors, outer = [], loop.parent
+        while outer is not None:
+            ancestors.append(outer)
+            outer = outer.parent
+        threaded = any(a.directive and "parallel" in a.directive for a in ancestors)
+        if legal and loop.innermost():
+            loop.directive = "omp simd" + clauses(*legal)
+        elif legal and not threaded:
+            loop.directive = "omp parallel for" + clauses(*legal)
+        else:
+            loop.directive = f"GCC unroll {min(loop.factor, MAX_UNROLL)}"
+
+    out, last = [], 0
+    for loop in loops:
+        if loop.directive is None:
+            continue
+        prefix = code[code.rfind("\n", 0, loop.start) + 1 : loop.start]
+        out.append(code[last : loop.start])
+        if prefix.strip():
+            # Something precedes the loop on its line; the pragma needs its own.
+            out.append(f"\n#pragma {loop.directive}\n{' ' * len(prefix)}")
+        else:
+            out.append(f"#pragma {loop.directive}\n{prefix}")
+        last = loop.start
+    out.append(code[last:])
+    return "".join(out), loops
+
+
+def clauses(private, reductions):
+    text = ""
+    if private:
+        text += f" private({', '.join(private)})"
+    if reductions:
+        text += f" reduction(+:{', '.join(reductions)})"
+    return text
+
+
+def load_point(designs_dir, kernel, key):
+    with open(os.path.join(designs_dir, f"{kernel}.json")) as f:
+        designs = json.load(f)
+    if key not in designs:
+        key = list(designs)[int(key)]
+    return key, designs[key]["point"]
+
+
+# Loop bodies over A and B with a scalar s declared outside the loop, and the
+# directive a PARALLEL FACTOR=4 on the loop must give.
+REGRESSIONS = [
+    ("s = A[i] * 2.0; B[i] = s;", "omp simd private(s)"),
+    ("s = s + A[i];", "omp simd reduction(+:s)"),
+    # Loop-carried recurrences: s is read before it is assigned.
+    ("s = s * 2.0 + A[i]; B[i] = s;", "GCC unroll 4"),
+    ("s = s + A[i]; B[i] = s;", "GCC unroll 4"),
+]
+
+
+def check():
+    """Run REGRESSIONS and return the number of wrong directives."""
+    errors = 0
+    for body, expected in REGRESSIONS:
+        code = (
+            "void f(double A[64], double B[64]) {\n  double s = 0.0;\n  int i;\n"
+            "#pragma ACCEL PARALLEL FACTOR=4\n"
+            f"  for (i = 0; i < 64; i++) {{\n    {body}\n  }}\n}}\n"
+        )
+        directive = transform(code, {})[1][0].directive
+        if directive != expected:
+            print(f"{body}: {directive} instead of {expected}", file=sys.stderr)
+            errors += 1
+    return errors
+
+
+def main():
+    if sys.argv[1:] == ["--check"]:
+        errors = check()
+        if errors:
+            print(f"Found {errors} error{'s' if errors > 1 else ''}", file=sys.stderr)
+            print("FAIL", file=sys.stderr)
+            sys.exit(1)
+        print("PASS", file=sys.stderr)
+        return
+
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("kernel", help="data/designs name, e.g. gemm-p")
+    parser.add_argument("point", help="design point key or index in the designs file")
+    parser.add_argument("--designs", default=DESIGNS_DIR)
+    parser.add_argument("-o", "--output", help="write the source here instead of stdout")
+    args = parser.parse_args()
+
+    key, point = load_point(args.designs, args.kernel, args.point)
+    stem = SOURCE_STEMS.get(args.kernel, args.kernel)
+    with open(os.path.join(SOURCES_DIR, f"{stem}_kernel.c")) as f:
+        code, loops = transform(f.read(), point)
+
+    print(f"design point {key}", file=sys.stderr)
+    for loop in loops:
+        if loop.factor > 1:
+            print(f"  loop {loop.var or '?'} (factor {loop.factor}): {loop.directive}", file=sys.stderr)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(code)
+    else:
+        sys.stdout.write(code)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,240 @@
+"""Generate lib/kernels-registry.cpp from the kernels in data/sources.
+
+Each kernel source is compiled into its own namespace and described by the
+signature of its top-level function: argument names, element types and array
+shapes. Argument value domains that cannot be read from the signature (index
+arrays, sequences, scalar parameters) are listed in the tables below.
+
+Usage: python3 gen_kernels.py  (run from the HLS directory)
+"""
+
+import os
+import re
+
+SOURCES_DIR = "../data/sources"
+OUTPUT_FILE = "lib/kernels-registry.cpp"
+
+# Registry names follow data/designs, which differ from the file stem only for
+# the 2D stencil.
+NAMES = {
+    "stencil_stencil2d": "stencil",
+}
+
+TYPES = {
+    "char": "kChar",
+    "unsigned char": "kUChar",
+    "int": "kInt",
+    "long": "kLong",
+    "double": "kDouble",
+}
+
+# Scalar arguments. Problem sizes are baked into the kernel bodies, so the size
+# scalars only document the dimensions; the remaining values match the
+# verification harnesses.
+SCALARS = {
+    "ni": None,
+    "nj": None,
+    "nk": None,
+    "nl": None,
+    "nm": None,
+    "alpha": "1.5",
+    "beta": "1.2",
+    "C0": "2",
+    "C1": "-1",
+}
+KERNEL_SCALARS = {
+    "2mm": {"ni": "40", "nj": "50", "nk": "70", "nl": "80"},
+    "3mm": {"ni": "40", "nj": "50", "nk": "60", "nl": "70", "nm": "80"},
+    "adi": {"tsteps": "40", "n": "60"},
+    "atax": {"m": "116", "n": "124"},
+    "bicg": {"m": "124", "n": "116"},
+    "bicg-medium": {"m": "410", "n": "390"},
+    "bicg-large": {"m": "410", "n": "390"},
+    "covariance": {"m": "80", "n": "100", "float_n": "100.0"},
+    "correlation": {"float_n": "100.0"},
+    "doitgen": {"nr": "25", "nq": "20", "np": "30"},
+    "fdtd-2d": {"tmax": "40", "nx": "60", "ny": "80"},
+    "fdtd-2d-large": {"tmax": "100", "nx": "200", "ny": "240"},
+    "gemm-p": {"ni": "60", "nj": "70", "nk": "80"},
+    "gemm-p-large": {"ni": "200", "nj": "220", "nk": "240"},
+    "gemver": {"n": "120"},
+    "gemver-medium": {"n": "400"},
+    "gesummv": {"n": "90"},
+    "heat-3d": {"tsteps": "40", "n": "20"},
+    "jacobi-1d": {"tsteps": "40", "n": "120"},
+    "jacobi-2d": {"tsteps": "40", "n": "90"},
+    "seidel-2d": {"tsteps": "40", "n": "120"},
+}
+
+# Array arguments whose values must stay inside an index domain, as C++
+# statements over {data}, {count} and rng. lib/fuzz.cpp's kDomains keeps the
+# same arguments in range when it reshapes inputs; add an entry there with
+# each index domain added here.
+DOMAINS = {
+    ("md", "NL"): "FillIndex({data}, {count}, 256, rng)",
+    ("spmv-crs", "cols"): "FillIndex({data}, {count}, 494, rng)",
+    ("spmv-crs", "rowDelimiters"): "FillRowDelimiters({data}, 494, 1666, rng)",
+    ("spmv-ellpack", "cols"): "FillIndex({data}, {count}, 494, rng)",
+    ("nw", "SEQA"): "FillSequence({data}, {count}, rng)",
+    ("nw", "SEQB"): "FillSequence({data}, {count}, rng)",
+}
+
+# stencil3d writes sol[] with the padded 34x34x34 indexing of orig[], past the
+# 32768 elements its signature declares, so sol is allocated like orig.
+SHAPES = {
+    ("stencil-3d", "sol"): ["39304"],
+}
+
+SIGNATURE = re.compile(r"^void\s+(\w+)\s*\(([^)]*)\)", re.MULTILINE)
+PARAM = re.compile(r"^(unsigned char|char|int|long|double|\w+)\s*(\*?)\s*(\w+)((?:\[\d+\])*)$")
+
+
+def parse_signature(code):
+    match = SIGNATURE.search(code)
+    function, params = match.group(1), match.group(2)
+    args = []
+    for param in params.split(","):
+        param = " ".join(param.split())
+        m = PARAM.match(param)
+        if not m:
+            raise ValueError(f"cannot parse parameter '{param}' of {function}")
+        ctype, pointer, name, dims = m.groups()
+        args.append(
+            {
+                "ctype": ctype,
+                "struct": ctype not in TYPES,
+                "pointer": bool(pointer),
+                "name": name,
+                "shape": re.findall(r"\[(\d+)\]", dims),
+            }
+        )
+    return function, args
+
+
+def cxx_param_type(arg, ns):
+    if arg["struct"]:
+        return f"{ns}::{arg['ctype']}*"
+    shape = arg["shape"]
+    if not shape and not arg["pointer"]:
+        return arg["ctype"]
+    if len(shape) <= 1:
+        return f"{arg['ctype']}*"
+    inner = "".join(f"[{d}]" for d in shape[1:])
+    return f"{arg['ctype']}(*){inner}"
+
+
+def emit_args(name, ns, args, rewrite=lambda text: text, scalars=None):
+    """Returns the ArgSpec initialisers, Init statements and Run call arguments
+    of a kernel. `rewrite` is applied to shapes and the DOMAINS and `scalars`
+    overrides scalar values, for gen_sized.py to put template parameters in the
+    place of the sizes."""
+    specs, calls, fills = [], [], []
+    for i, arg in enumerate(args):
+        if arg["struct"]:
+            ctype = "kUChar"
+            shape = [f"static_cast<int>(sizeof({ns}::{arg['ctype']}))"]
+        else:
+            ctype = TYPES[arg["ctype"]]
+            shape = [rewrite(d) for d in SHAPES.get((name, arg["name"]), arg["shape"])]
+        specs.append(f"{{\"{arg['name']}\", Type::{ctype}, {{{', '.join(shape)}}}}}")
+
+        param_type = cxx_param_type(dict(arg, shape=shape), ns)
+        if not shape:
+            calls.append(f"args.Value<{arg['ctype']}>({i})")
+            value = (scalars or {}).get(arg["name"])
+            if value is None:
+                value = KERNEL_SCALARS.get(name, {}).get(arg["name"], SCALARS.get(arg["name"]))
+            if value is None:
+                raise ValueError(f"no value for scalar '{arg['name']}' of {name}")
+            fills.append(f"  args.Value<{arg['ctype']}>({i}) = {value};")
+            continue
+        calls.append(f"args.Ptr<{param_type}>({i})")
+        elem = "unsigned char" if arg["struct"] else arg["ctype"]
+        domain = DOMAINS.get((name, arg["name"]))
+        if domain is not None:
+            domain = rewrite(domain)
+        else:
+            domain = {
+                "double": "FillUniform({data}, {count}, rng)",
+                "int": "FillInt({data}, {count}, -100, 100, rng)",
+                "long": "FillInt({data}, {count}, -100L, 100L, rng)",
+                "char": "FillSequence({data}, {count}, rng)",
+                "unsigned char": "FillBytes({data}, {count}, rng)",
+            }[elem]
+        fills.append(
+            "  "
+            + domain.format(data=f"args.Ptr<{elem}*>({i})", count=f"args.Count({i})")
+            + ";"
+        )
+    return specs, calls, fills
+
+
+def emit_kernel(stem, file_name):
+    name = NAMES.get(stem, stem)
+    ns = "k_" + name.replace("-", "_")
+    with open(os.path.join(SOURCES_DIR, file_name)) as f:
+        function, args = parse_signature(f.read())
+    specs, calls, fills = emit_args(name, ns, args)
+
+    body = (
+        f"namespace {ns} {{\n"
+        f'#include "../../data/sources/{file_name}"\n'
+        "\n"
+        "void Init(Args& args, Rng& rng) {\n"
+        + "\n".join(fills)
+        + "\n}\n\n"
+        "void Run(Args& args) {\n"
+        f"  {function}(\n      "
+        + ",\n      ".join(calls)
+        + ");\n}\n\n"
+        "void Call(void (*function)(), Args& args) {\n"
+        f"  reinterpret_cast<decltype(&{function})>(function)(\n      "
+        + ",\n      ".join(calls)
+        + ");\n}\n"
+        f"}}  // namespace {ns}\n"
+    )
+    entry = (
+        "      {\n"
+        f'          "{name}",\n'
+        f'          "{file_name}",\n'
+        f'          "{function}",\n'
+        "          {\n"
+        + "".join(f"              {spec},\n" for spec in specs)
+        + "          },\n"
+        f"          {ns}::Init,\n"
+        f"          {ns}::Run,\n"
+        f"          {ns}::Call,\n"
+        "      },\n"
+    )
+    return name, body, entry
+
+
+def main():
+    files = sorted(f for f in os.listdir(SOURCES_DIR) if f.endswith("_kernel.c"))
+    kernels = [emit_kernel(f[: -len("_kernel.c")], f) for f in files]
+    kernels.sort(key=lambda k: k[0])
+
+    with open(OUTPUT_FILE, "w") as out:
+        out.write(
+            "// Generated by gen_kernels.py from data/sources. Do not edit.\n"
+            "\n"
+            "// Kernel sources include <math.h> themselves; pull it in at global\n"
+            "// scope first so that the per-kernel namespaces only hold kernel code.\n"
+            "#include <math.h>\n"
+            "\n"
+            '#include "kernels.h"\n'
+            "\n"
+            "namespace kernels {\n"
+            "\n"
+        )
+        for _, body, _ in kernels:
+            out.write(body + "\n")
+        out.write("const std::vector<Kernel>& Registry() {\n")
+        out.write("  static const std::vector<Kernel> registry = {\n")
+        for _, _, entry in kernels:
+            out.write(entry)
+        out.write("  };\n  return registry;\n}\n\n}  // namespace kernels\n")
+
+
+if __name__ == "__main__":
+    main()
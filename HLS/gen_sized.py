@@ -0,0 +1,316 @@
+"""Generate lib/kernels-sized.h, or one kernel source at other problem sizes.
+
+The kernels in data/sources have their problem sizes baked in as integer
+literals. The tables below name the sizes of every kernel and the expressions
+over them that other literals stand for (n - 1, n * n, ...). Each literal of a
+kernel body is matched against the values of these expressions at the sizes of
+the source, so the same kernel can be written out at any size:
+
+  - as a C++ template over the sizes, in lib/kernels-sized.h, with argument
+    specs and initialisers from gen_kernels.py that scale with it;
+  - as a C source with the literals of the requested sizes, for the HLS flow.
+
+Usage: python3 gen_sized.py                       (writes lib/kernels-sized.h)
+       python3 gen_sized.py <kernel> [size=value...] > <file>_kernel.c
+Run from the HLS directory.
+"""
+
+import os
+import re
+import sys
+
+import gen_kernels
+from gen_kernels import NAMES, SOURCES_DIR
+
+OUTPUT_FILE = "lib/kernels-sized.h"
+
+# The problem sizes of each kernel, in template parameter order, with the values
+# of its source. Sizes that are also scalar arguments share their names.
+SIZES = {
+    "2mm": [("ni", 40), ("nj", 50), ("nk", 70), ("nl", 80)],
+    "3mm": [("ni", 40), ("nj", 50), ("nk", 60), ("nl", 70), ("nm", 80)],
+    "adi": [("tsteps", 40), ("n", 60)],
+    "atax": [("m", 116), ("n", 124)],
+    "atax-medium": [("m", 390), ("n", 410)],
+    "bicg": [("m", 124), ("n", 116)],
+    "bicg-large": [("m", 410), ("n", 390)],
+    "bicg-medium": [("m", 410), ("n", 390)],
+    "correlation": [("m", 80), ("n", 100)],
+    "covariance": [("m", 80), ("n", 100)],
+    "doitgen": [("nr", 25), ("nq", 20), ("np", 30)],
+    "doitgen-red": [("nr", 25), ("nq", 20), ("np", 30)],
+    "fdtd-2d": [("tmax", 40), ("nx", 60), ("ny", 80)],
+    "fdtd-2d-large": [("tmax", 100), ("nx", 200), ("ny", 240)],
+    "gemm-blocked": [("n", 64)],
+    "gemm-ncubed": [("n", 64)],
+    "gemm-p": [("ni", 60), ("nj", 70), ("nk", 80)],
+    "gemm-p-large": [("ni", 200), ("nj", 220), ("nk", 240)],
+    "gemver": [("n", 120)],
+    "gemver-medium": [("n", 400)],
+    "gesummv": [("n", 90)],
+    "gesummv-medium": [("n", 250)],
+    "heat-3d": [("tsteps", 40), ("n", 20)],
+    "jacobi-1d": [("tsteps", 40), ("n", 120)],
+    "jacobi-2d": [("tsteps", 40), ("n", 90)],
+    "md": [("atoms", 256), ("neighbours", 16)],
+    "mvt": [("n", 120)],
+    "mvt-medium": [("n", 400)],
+    "nw": [("n", 128)],
+    "seidel-2d": [("tsteps", 40), ("n", 120)],
+    "spmv-crs": [("n", 494), ("nnz", 1666)],
+    "spmv-ellpack": [("n", 494), ("l", 10)],
+    "stencil": [("rows", 128), ("cols", 64)],
+    "stencil-3d": [("n", 32)],
+    "symm": [("m", 60), ("n", 80)],
+    "symm-opt": [("m", 60), ("n", 80)],
+    "symm-opt-medium": [("m", 200), ("n", 240)],
+    "syr2k": [("m", 60), ("n", 80)],
+    "syrk": [("m", 60), ("n", 80)],
+    "trmm": [("m", 60), ("n", 80)],
+    "trmm-opt": [("m", 60), ("n", 80)],
+}
+
+# Literals that are expressions of the sizes, in C syntax over their names.
+DERIVED = {
+    "adi": ["n - 1", "n - 2", "n - 3"],
+    "fdtd-2d": ["nx - 1", "ny - 1"],
+    "gemm-blocked": ["n * n", "n - 8", "n / 8 - 1"],
+    "gemm-ncubed": ["n * n"],
+    "jacobi-2d": ["n - 1"],
+    "md": ["atoms * neighbours"],
+    "nw": ["(n + 1) * (n + 1)", "2 * n"],
+    "seidel-2d": ["tsteps - 1", "n - 2"],
+    "spmv-crs": ["n + 1"],
+    "spmv-ellpack": ["n * l"],
+    "stencil": ["rows * cols"],
+    "stencil-3d": ["n - 1", "n + 1", "n + 2", "n * n * n", "(n + 2) * (n + 2) * (n + 2)"],
+}
+
+# Literals of 10 and above that are not sizes: the pointer codes of nw.
+KEEP = {
+    "nw": [60, 92, 94],
+}
+
+# Conditions on the sizes, in C syntax: bbgemm steps through 8x8 blocks.
+CONSTRAINTS = {
+    "gemm-blocked": ["n % 8 == 0"],
+}
+
+# Scalar arguments derived from the sizes rather than the verification values.
+SCALARS = {
+    "correlation": {"float_n": "static_cast<double>(kN)"},
+    "covariance": {"float_n": "static_cast<double>(kN)"},
+}
+
+# aes256_encrypt_ecb has the fixed block and key sizes of AES-256.
+UNSIZED = {"aes"}
+
+NUMBER = re.compile(r"(?<![\w.])\d+(?![\w.])")
+# Comments, string and character literals and preprocessor lines, which are
+# kept as they are, or an integer literal to rewrite.
+TOKEN = re.compile(
+    r"(//[^\n]*|/\*.*?\*/|\"(?:\\.|[^\"\\])*\"|'(?:\\.|[^'\\])*'|^[ \t]*#[^\n]*)"
+    r"|" + NUMBER.pattern,
+    re.DOTALL | re.MULTILINE,
+)
+IDENTIFIER = re.compile(r"\b[a-z_]\w*\b")
+
+
+def template_name(size):
+    return "k" + size[0].upper() + size[1:]
+
+
+def evaluate(expr, values):
+    """Value of a C expression over positive sizes."""
+    return eval(expr.replace("/", "//"), {"__builtins__": {}}, dict(values))
+
+
+def to_cxx(expr, sizes):
+    names = {name for name, _ in sizes}
+    cxx = IDENTIFIER.sub(
+        lambda m: template_name(m.group(0)) if m.group(0) in names else m.group(0), expr
+    )
+    return cxx if cxx.isidentifier() else f"({cxx})"
+
+
+def literal_map(name, sizes):
+    """Maps each size literal of the source to the expression it stands for."""
+    exprs = {}
+    defaults = dict(sizes)
+    for expr in [size for size, _ in sizes] + DERIVED.get(name, []):
+        value = evaluate(expr, defaults)
+        if value in exprs:
+            raise ValueError(f"'{expr}' and '{exprs[value]}' of {name} are both {value}")
+        exprs[value] = expr
+    return exprs
+
+
+def rewrite(code, name, exprs, replace):
+    """Replaces the size literals of a piece of kernel code."""
+
+    def token(m):
+        if m.group(1) is not None:
+            return m.group(0)
+        value = int(m.group(0))
+        if value in exprs:
+            return replace(exprs[value])
+        if value >= 10 and value not in KEEP.get(name, []):
+            raise ValueError(f"literal {value} of {name} is not a size")
+        return m.group(0)
+
+    return TOKEN.sub(token, code)
+
+
+def read_source(name):
+    stem = next((s for s, n in NAMES.items() if n == name), name)
+    file_name = stem + "_kernel.c"
+    with open(os.path.join(SOURCES_DIR, file_name)) as f:
+        return file_name, f.read()
+
+
+def emit_template(name):
+    sizes = SIZES[name]
+    ns = "k_" + name.replace("-", "_")
+    file_name, code = read_source(name)
+    function, args = gen_kernels.parse_signature(code)
+    exprs = literal_map(name, sizes)
+    cxx = lambda expr: to_cxx(expr, sizes)
+
+    start = gen_kernels.SIGNATURE.search(code).start()
+    for line in code[:start].splitlines():
+        if line.strip() not in ("", "#include <math.h>", "#pragma ACCEL kernel"):
+            raise ValueError(f"unexpected line before {function} in {file_name}: {line}")
+    body = rewrite(code[start:], name, exprs, cxx).rstrip() + "\n"
+    checks = "".join(
+        f'  static_assert({to_cxx(c, sizes)}, "{name}: {c}");\n'
+        for c in CONSTRAINTS.get(name, [])
+    )
+    if checks:
+        brace = body.index("{") + 1
+        body = body[:brace] + "\n" + checks.rstrip("\n") + body[brace:]
+
+    params = ", ".join(f"int {template_name(s)}" for s, _ in sizes)
+    defaults = ", ".join(f"int {template_name(s)} = {v}" for s, v in sizes)
+    names = ", ".join(template_name(s) for s, _ in sizes)
+    scalars = {s: template_name(s) for s, _ in sizes}
+    scalars.update(SCALARS.get(name, {}))
+    specs, calls, fills = gen_kernels.emit_args(
+        name, ns, args, lambda text: rewrite(text, name, exprs, cxx), scalars
+    )
+    return (
+        f"namespace {ns} {{\n"
+        f"template <{params}>\n"
+        + body
+        + "\n"
+        f"template <{params}>\n"
+        "void Init(Args& args, Rng& rng) {\n"
+        + "\n".join(fills)
+        + "\n}\n\n"
+        f"template <{params}>\n"
+        "void Run(Args& args) {\n"
+        f"  {function}<{names}>(\n      "
+        + ",\n      ".join(calls)
+        + ");\n}\n\n"
+        f"template <{params}>\n"
+        "void Call(void (*function)(), Args& args) {\n"
+        f"  reinterpret_cast<decltype(&{function}<{names}>)>(function)(\n      "
+        + ",\n      ".join(calls)
+        + ");\n}\n\n"
+        f"template <{defaults}>\n"
+        "Kernel Instance() {\n"
+        "  return {\n"
+        f'      Name("{name}", {{{names}}}),\n'
+        f'      "{file_name}",\n'
+        f'      "{function}",\n'
+        "      {\n"
+        + "".join(f"          {spec},\n" for spec in specs)
+        + "      },\n"
+        f"      Init<{names}>,\n"
+        f"      Run<{names}>,\n"
+        f"      Call<{names}>,\n"
+        "  };\n"
+        "}\n"
+        f"}}  // namespace {ns}\n"
+    )
+
+
+def write_header():
+    stems = sorted(f[: -len("_kernel.c")] for f in os.listdir(SOURCES_DIR) if f.endswith("_kernel.c"))
+    names = sorted(NAMES.get(stem, stem) for stem in stems)
+    missing = [name for name in names if name not in SIZES and name not in UNSIZED]
+    if missing:
+        raise ValueError(f"no sizes for {', '.join(missing)}")
+    names = [name for name in names if name in SIZES]
+
+    with open(OUTPUT_FILE, "w") as out:
+        out.write(
+            "// Generated by gen_sized.py from data/sources. Do not edit.\n"
+            "\n"
+            "#ifndef KERNELS_SIZED_H_\n"
+            "#define KERNELS_SIZED_H_\n"
+            "\n"
+            "#include <math.h>\n"
+            "\n"
+            "#include <initializer_list>\n"
+            "#include <string>\n"
+            "#include <vector>\n"
+            "\n"
+            '#include "kernels.h"\n'
+            "\n"
+            "// The kernels of data/sources with their problem sizes as template\n"
+            "// parameters, so that the optimiser still sees constants at any size.\n"
+            "// k_<kernel>::Instance<sizes...>() describes one instantiation like a\n"
+            "// registry entry, with initialisers that scale with it; the default\n"
+            "// sizes are those of the source.\n"
+            "namespace kernels {\n"
+            "namespace sized {\n"
+            "\n"
+            '// The name of an instance, e.g. "atax-390x410".\n'
+            "inline std::string Name(const char* kernel, std::initializer_list<int> sizes) {\n"
+            "  std::string name = kernel;\n"
+            "  char separator = '-';\n"
+            "  for (int size : sizes) {\n"
+            "    name += separator + std::to_string(size);\n"
+            "    separator = 'x';\n"
+            "  }\n"
+            "  return name;\n"
+            "}\n"
+            "\n"
+        )
+        for name in names:
+            out.write(emit_template(name) + "\n")
+        out.write("// Every sized kernel at the sizes of its source, sorted by name.\n")
+        out.write("inline std::vector<Kernel> Defaults() {\n  return {\n")
+        for name in names:
+            out.write(f"      k_{name.replace('-', '_')}::Instance<>(),\n")
+        out.write(
+            "  };\n}\n\n}  // namespace sized\n}  // namespace kernels\n\n#endif\n"
+        )
+
+
+def write_source(name, settings):
+    if name not in SIZES:
+        raise SystemExit(f"unknown or unsized kernel '{name}'")
+    sizes = dict(SIZES[name])
+    for setting in settings:
+        size, _, value = setting.partition("=")
+        if size not in sizes or not value.isdigit() or int(value) == 0:
+            raise SystemExit(f"bad size '{setting}' for {name}: sizes are {', '.join(sizes)}")
+        sizes[size] = int(value)
+    for constraint in CONSTRAINTS.get(name, []):
+        if not evaluate(constraint, sizes):
+            raise SystemExit(f"{name} needs {constraint}")
+    _, code = read_source(name)
+    exprs = literal_map(name, SIZES[name])
+    sys.stdout.write(rewrite(code, name, exprs, lambda expr: str(evaluate(expr, sizes))))
+
+
+def main():
+    if len(sys.argv) > 1:
+        write_source(sys.argv[1], sys.argv[2:])
+    else:
+        write_header()
+
+
+if __name__ == "__main__":
+    main()
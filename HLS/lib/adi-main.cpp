@@ -0,0 +1,118 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "adi.h"
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using Grids = check::Arrays;  // u, v, p, q
+
+namespace {
+
+// The sizes of the n x n grids u, v, p and q.
+vector<size_t> Sizes(int n) {
+  return vector<size_t>(4, static_cast<size_t>(n) * n);
+}
+
+}  // namespace
+
+// Checks the batched ADI solver bit for bit against kernel_adi and the
+// reference loops on several grids, then times both on larger grids:
+//   adi [n tsteps]...
+int main(int argc, char** argv) {
+  vector<std::pair<int, int>> sizes;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    sizes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1])});
+  }
+  for (auto [n, tsteps] : sizes) {
+    if (n < 3 || tsteps < 1) argc = 0;
+  }
+  if (argc % 2 == 0) {
+    clog << "Usage: " << argv[0] << " [n tsteps]...\n";
+    return EXIT_FAILURE;
+  }
+  if (sizes.empty()) sizes = {{500, 10}, {1000, 10}, {2000, 5}};
+
+  int error = 0;
+  const kernels::Kernel& kernel = *kernels::FindKernel("adi");
+  kernels::Rng rng(42);
+  for (adi::Isa isa : {adi::Isa::kGeneric, adi::Isa::kAvx512}) {
+    if (!adi::SetIsa(isa)) continue;
+    clog << "Check " << adi::IsaName(isa) << endl;
+    for (int seed = 1; seed <= 3; ++seed) {
+      kernels::Args args = kernels::MakeArgs(kernel, seed);
+      const int n = args.Value<int>(1);
+      Grids g;
+      for (int i = 2; i < 6; ++i) {
+        const double* data = args.Ptr<double*>(i);
+        g.emplace_back(data, data + args.Count(i));
+      }
+      Grids reference = g;
+      check::Call<4>(adi::Reference, reference, args.Value<int>(0), n);
+      check::Call<4>(adi::Solve, g, args.Value<int>(0), n);
+      kernel.run(args);
+      Grids expected;
+      for (int i = 2; i < 6; ++i) {
+        const double* data = args.Ptr<double*>(i);
+        expected.emplace_back(data, data + args.Count(i));
+      }
+      if (!check::Same(reference, expected)) {
+        clog << "adi seed " << seed << ": reference differs from kernel_adi"
+             << endl;
+        ++error;
+      }
+      if (!check::Same(g, expected)) {
+        clog << "adi seed " << seed << ": batched solver differs" << endl;
+        ++error;
+      }
+    }
+
+    for (auto [n, tsteps] : {std::pair<int, int>{3, 1}, {4, 3}, {9, 2},
+                             {17, 5}, {61, 7}, {150, 4}, {300, 2}}) {
+      Grids g = check::Random(Sizes(n), rng);
+      Grids expected = g;
+      check::Call<4>(adi::Reference, expected, tsteps, n);
+      check::Call<4>(adi::Solve, g, tsteps, n);
+      if (!check::Same(g, expected)) {
+        clog << "n " << n << ", tsteps " << tsteps
+             << ": batched solver differs" << endl;
+        ++error;
+      }
+    }
+  }
+  adi::SetIsa(adi::BestIsa());
+
+  for (auto [n, tsteps] : sizes) {
+    const Grids input = check::Random(Sizes(n), rng);
+    Grids reference_result, g;
+    bench::Timing reference = bench::Measure(
+        0, 1, [&] { reference_result = input; },
+        [&] { check::Call<4>(adi::Reference, reference_result, tsteps, n); });
+    bench::Timing batched =
+        bench::Measure(0, 3, [&] { g = input; },
+                       [&] { check::Call<4>(adi::Solve, g, tsteps, n); });
+    if (!check::Same(g, reference_result)) {
+      clog << "n " << n << ": batched solver differs" << endl;
+      ++error;
+    }
+    cout << "n " << n << ", " << tsteps << " steps: reference "
+         << reference.median << " s, batched " << batched.median
+         << " s, speedup " << reference.median / batched.median << "x"
+         << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
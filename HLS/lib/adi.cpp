@@ -0,0 +1,303 @@
+#include "adi.h"
+
+#include <immintrin.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace adi {
+
+namespace {
+
+// The coefficients of kernel_adi: a, b, c on the diagonals of the column
+// systems, d, e, f on those of the row systems.
+struct Constants {
+  double a, b, c, d, e, f;
+
+  Constants(int tsteps, int n) {
+    const double DX = 1.0 / static_cast<double>(n);
+    const double DY = 1.0 / static_cast<double>(n);
+    const double DT = 1.0 / static_cast<double>(tsteps);
+    const double B1 = 2.0;
+    const double B2 = 1.0;
+    const double mul1 = B1 * DT / (DX * DX);
+    const double mul2 = B2 * DT / (DY * DY);
+    a = -mul1 / 2.0;
+    b = 1.0 + mul1;
+    c = a;
+    d = -mul2 / 2.0;
+    e = 1.0 + mul2;
+    f = d;
+  }
+};
+
+// Fewest systems per thread in the column sweep.
+const int kMinTask = 64;
+
+// One sweep in the form of the column sweep: for system i and step j,
+//   q[j][i] = (lower * in[j][i - 1] + diag * in[j][i] - upper * in[j][i + 1]
+//              - sub * q[j - 1][i]) / den[j],
+// den[j] = pa * p[j - 1] + pb and p[j] = pnum / den[j], then
+//   out[j][i] = p[j] * out[j + 1][i] + q[j][i].
+struct Sweep {
+  double lower, diag, upper, sub;
+  double pnum, pa, pb;
+  std::vector<double> p;
+  std::vector<double> den;
+
+  Sweep(int n, double lower, double diag, double upper, double sub,
+        double pnum, double pa, double pb)
+      : lower(lower), diag(diag), upper(upper), sub(sub), pnum(pnum), pa(pa),
+        pb(pb), p(n, 0.0), den(n, 0.0) {
+    for (int j = 1; j < n - 1; j++) {
+      den[j] = pa * p[j - 1] + pb;
+      p[j] = pnum / den[j];
+    }
+  }
+};
+
+// Step j of the forward pass for systems i0..i1, without contraction so that
+// every lane rounds like the scalar loop.
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+ForwardAvx512(const Sweep& s, int i0, int i1, const double* in,
+              const double* q_prev, double den, double* q) {
+  const __m512d lower = _mm512_set1_pd(s.lower);
+  const __m512d diag = _mm512_set1_pd(s.diag);
+  const __m512d upper = _mm512_set1_pd(s.upper);
+  const __m512d sub = _mm512_set1_pd(s.sub);
+  const __m512d den_v = _mm512_set1_pd(den);
+  int i = i0;
+  for (; i + 8 <= i1; i += 8) {
+    __m512d x = _mm512_add_pd(
+        _mm512_mul_pd(lower, _mm512_loadu_pd(in + i - 1)),
+        _mm512_mul_pd(diag, _mm512_loadu_pd(in + i)));
+    x = _mm512_sub_pd(x, _mm512_mul_pd(upper, _mm512_loadu_pd(in + i + 1)));
+    x = _mm512_sub_pd(x, _mm512_mul_pd(sub, _mm512_loadu_pd(q_prev + i)));
+    _mm512_storeu_pd(q + i, _mm512_div_pd(x, den_v));
+  }
+  for (; i < i1; ++i) {
+    q[i] = (s.lower * in[i - 1] + s.diag * in[i] - s.upper * in[i + 1] -
+            s.sub * q_prev[i]) /
+           den;
+  }
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+BackwardAvx512(int i0, int i1, double p, const double* out_next,
+               const double* q, double* out) {
+  const __m512d p_v = _mm512_set1_pd(p);
+  int i = i0;
+  for (; i + 8 <= i1; i += 8) {
+    __m512d x = _mm512_mul_pd(p_v, _mm512_loadu_pd(out_next + i));
+    _mm512_storeu_pd(out + i, _mm512_add_pd(x, _mm512_loadu_pd(q + i)));
+  }
+  for (; i < i1; ++i) out[i] = p * out_next[i] + q[i];
+}
+
+void ForwardGeneric(const Sweep& s, int i0, int i1, const double* in,
+                    const double* q_prev, double den, double* q) {
+  for (int i = i0; i < i1; ++i) {
+    q[i] = (s.lower * in[i - 1] + s.diag * in[i] - s.upper * in[i + 1] -
+            s.sub * q_prev[i]) /
+           den;
+  }
+}
+
+void BackwardGeneric(int i0, int i1, double p, const double* out_next,
+                     const double* q, double* out) {
+  for (int i = i0; i < i1; ++i) out[i] = p * out_next[i] + q[i];
+}
+
+struct Engine {
+  Isa isa;
+  void (*forward)(const Sweep& s, int i0, int i1, const double* in,
+                  const double* q_prev, double den, double* q);
+  void (*backward)(int i0, int i1, double p, const double* out_next,
+                   const double* q, double* out);
+};
+
+const Engine kEngines[] = {
+    {Isa::kGeneric, ForwardGeneric, BackwardGeneric},
+    {Isa::kAvx512, ForwardAvx512, BackwardAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa; read by Solve, which may run on another thread.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+// Solves the systems of columns 1..n-2 of `in` into `out`, q[j][i] holding
+// the q of system i. Each thread takes a band of columns and walks it down
+// the rows, so the rows of in, out and q stream through the cache.
+void RunColumns(const Sweep& s, int n, const double* in, double* out,
+                double* q) {
+  const Engine& engine = Selected();
+  const int systems = n - 2;
+  const int tasks =
+      std::max(1, std::min(omp_get_max_threads(), systems / kMinTask));
+  const int width = (systems + tasks - 1) / tasks;
+#pragma omp parallel for schedule(static)
+  for (int t = 0; t < tasks; ++t) {
+    const int i0 = 1 + t * width;
+    const int i1 = std::min(n - 1, i0 + width);
+    for (int i = i0; i < i1; ++i) {
+      out[i] = 1.0;
+      q[i] = 1.0;
+    }
+    for (int j = 1; j < n - 1; j++) {
+      engine.forward(s, i0, i1, in + j * n, q + (j - 1) * n, s.den[j],
+                     q + j * n);
+    }
+    for (int i = i0; i < i1; ++i) out[(n - 1) * n + i] = 1.0;
+    for (int j = n - 2; j >= 1; j--) {
+      engine.backward(i0, i1, s.p[j], out + (j + 1) * n, q + j * n,
+                      out + j * n);
+    }
+  }
+}
+
+// The row sweep, in bands of kBand rows. A band's rows i - 1 .. i + kBand of
+// `in` are copied into a buffer with one row of kWidth values per column, so
+// that the systems of the band lie side by side as in the column sweep and
+// share its kernels. The solution is copied back into the band's rows of
+// `out`; on the last step the q of each system goes to q, as in kernel_adi.
+const int kBand = 16;
+const int kWidth = kBand + 2;
+
+void RunRows(const Sweep& s, int n, const double* in, double* out, double* q,
+             bool last) {
+  const Engine& engine = Selected();
+  const int bands = (n - 2 + kBand - 1) / kBand;
+#pragma omp parallel
+  {
+    std::vector<double> in_b(static_cast<size_t>(n) * kWidth);
+    std::vector<double> q_b(in_b.size()), out_b(in_b.size());
+#pragma omp for schedule(static)
+    for (int band = 0; band < bands; ++band) {
+      const int i0 = 1 + band * kBand;
+      const int rows = std::min(kBand, n - 1 - i0);
+      for (int r = 0; r < rows + 2; ++r) {
+        const double* row = in + (i0 - 1 + r) * n;
+        for (int j = 0; j < n; ++j) in_b[j * kWidth + r] = row[j];
+      }
+      for (int l = 1; l <= rows; ++l) {
+        out_b[l] = 1.0;
+        q_b[l] = 1.0;
+      }
+      for (int j = 1; j < n - 1; j++) {
+        engine.forward(s, 1, 1 + rows, in_b.data() + j * kWidth,
+                       q_b.data() + (j - 1) * kWidth, s.den[j],
+                       q_b.data() + j * kWidth);
+      }
+      for (int l = 1; l <= rows; ++l) out_b[(n - 1) * kWidth + l] = 1.0;
+      for (int j = n - 2; j >= 1; j--) {
+        engine.backward(1, 1 + rows, s.p[j], out_b.data() + (j + 1) * kWidth,
+                        q_b.data() + j * kWidth, out_b.data() + j * kWidth);
+      }
+      for (int l = 1; l <= rows; ++l) {
+        double* row = out + (i0 - 1 + l) * n;
+        for (int j = 0; j < n; ++j) row[j] = out_b[j * kWidth + l];
+        if (!last) continue;
+        for (int j = 0; j < n - 1; ++j) {
+          q[(i0 - 1 + l) * n + j] = q_b[j * kWidth + l];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void Reference(int tsteps, int n, double* u, double* v, double* p,
+               double* q) {
+  const Constants k(tsteps, n);
+  const double a = k.a, b = k.b, c = k.c, d = k.d, e = k.e, f = k.f;
+  for (int t = 1; t <= tsteps; t++) {
+    for (int i = 1; i < n - 1; i++) {
+      v[i] = 1.0;
+      p[i * n] = 0.0;
+      q[i * n] = v[i];
+      for (int j = 1; j < n - 1; j++) {
+        p[i * n + j] = -c / (a * p[i * n + j - 1] + b);
+        q[i * n + j] =
+            (-d * u[j * n + i - 1] + (1.0 + 2.0 * d) * u[j * n + i] -
+             f * u[j * n + i + 1] - a * q[i * n + j - 1]) /
+            (a * p[i * n + j - 1] + b);
+      }
+      v[(n - 1) * n + i] = 1.0;
+      for (int j = n - 2; j >= 1; j--) {
+        v[j * n + i] = p[i * n + j] * v[(j + 1) * n + i] + q[i * n + j];
+      }
+    }
+    for (int i = 1; i < n - 1; i++) {
+      u[i * n] = 1.0;
+      p[i * n] = 0.0;
+      q[i * n] = u[i * n];
+      for (int j = 1; j < n - 1; j++) {
+        p[i * n + j] = -f / (d * p[i * n + j - 1] + e);
+        q[i * n + j] =
+            (-a * v[(i - 1) * n + j] + (1.0 + 2.0 * a) * v[i * n + j] -
+             c * v[(i + 1) * n + j] - d * q[i * n + j - 1]) /
+            (d * p[i * n + j - 1] + e);
+      }
+      u[i * n + n - 1] = 1.0;
+      for (int j = n - 2; j >= 1; j--) {
+        u[i * n + j] = p[i * n + j] * u[i * n + j + 1] + q[i * n + j];
+      }
+    }
+  }
+}
+
+void Solve(int tsteps, int n, double* u, double* v, double* p, double* q) {
+  if (tsteps < 1 || n < 3) return;
+  const Constants k(tsteps, n);
+  const double a = k.a, b = k.b, c = k.c, d = k.d, e = k.e, f = k.f;
+  const Sweep columns(n, -d, 1.0 + 2.0 * d, f, a, -c, a, b);
+  const Sweep rows(n, -a, 1.0 + 2.0 * a, c, d, -f, d, e);
+
+  std::vector<double> q_columns(static_cast<size_t>(n) * n);
+  for (int t = 1; t <= tsteps; t++) {
+    RunColumns(columns, n, u, v, q_columns.data());
+    RunRows(rows, n, v, u, q, t == tsteps);
+  }
+  for (int i = 1; i < n - 1; i++) {
+    for (int j = 0; j < n - 1; j++) p[i * n + j] = rows.p[j];
+  }
+}
+
+}  // namespace adi
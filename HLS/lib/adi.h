@@ -0,0 +1,38 @@
+#ifndef ADI_H_
+#define ADI_H_
+
+// Alternating-direction implicit solver of data/sources/adi_kernel.c for an
+// n x n row-major grid. With DX = DY = 1 / n and DT = 1 / tsteps, as in
+// PolyBench, n = 60 and tsteps = 40 give the constants of kernel_adi.
+// Both versions leave u, v, p and q exactly as kernel_adi does.
+namespace adi {
+
+// The loop nest of kernel_adi: every timestep, a column sweep solves one
+// tridiagonal system per column for v, then a row sweep one per row for u,
+// each with the Thomas algorithm and p, q as scratch.
+void Reference(int tsteps, int n, double* u, double* v, double* p, double* q);
+
+// The systems of a sweep advance together: step j of the forward and the
+// backward pass is one loop over neighbouring systems in SIMD lanes, and
+// groups of systems are spread over the OpenMP threads. The column sweep
+// runs on the rows of u and v as they are; the row sweep copies bands of
+// rows into a transposed buffer first, so that its systems lie side by side
+// the same way. p does not depend on the data, so it is computed once per
+// sweep. Every value is computed by the same operations as in kernel_adi, so
+// the results are bitwise identical.
+void Solve(int tsteps, int n, double* u, double* v, double* p, double* q);
+
+enum class Isa { kGeneric, kAvx512 };
+
+// The widest instruction set the sweep kernels can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace adi
+
+#endif
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "aes.h"
+#include "bench.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+namespace {
+
+// aes256_encrypt_ecb on each block in turn, expanding the key every time.
+void Reference(kernels::Args& args, const uint8_t* key, size_t blocks,
+               const uint8_t* in, uint8_t* out) {
+  static const kernels::Kernel& kernel = *kernels::FindKernel("aes");
+  uint8_t* k = args.Ptr<uint8_t*>(1);
+  uint8_t* buf = args.Ptr<uint8_t*>(2);
+  for (size_t b = 0; b < blocks; ++b) {
+    std::memcpy(k, key, aes::kKeyBytes);
+    std::memcpy(buf, in + b * aes::kBlock, aes::kBlock);
+    kernel.run(args);
+    std::memcpy(out + b * aes::kBlock, buf, aes::kBlock);
+  }
+}
+
+vector<aes::Core> SupportedCores() {
+  vector<aes::Core> cores;
+  for (aes::Core core :
+       {aes::Core::kTable, aes::Core::kAesNi, aes::Core::kVaes}) {
+    if (aes::SetCore(core)) cores.push_back(core);
+  }
+  aes::SetCore(aes::BestCore());
+  return cores;
+}
+
+}  // namespace
+
+// Checks every AES core byte for byte against aes256_encrypt_ecb and the
+// FIPS-197 example, then compares their throughput with the per-block
+// reference:
+//   aes [megabytes]
+int main(int argc, char** argv) {
+  const long megabytes = argc > 1 ? std::atol(argv[1]) : 64;
+  if (argc > 2 || megabytes <= 0) {
+    clog << "Usage: " << argv[0] << " [megabytes]\n";
+    return EXIT_FAILURE;
+  }
+
+  int error = 0;
+  kernels::Rng rng(42);
+  kernels::Args args = kernels::MakeArgs(*kernels::FindKernel("aes"));
+  const vector<aes::Core> cores = SupportedCores();
+
+  // FIPS-197 appendix C.3.
+  uint8_t key[aes::kKeyBytes], plain[aes::kBlock];
+  for (int i = 0; i < aes::kKeyBytes; ++i) key[i] = i;
+  for (int i = 0; i < aes::kBlock; ++i) plain[i] = 0x11 * i;
+  const uint8_t cipher[aes::kBlock] = {0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67,
+                                       0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90,
+                                       0x4b, 0x49, 0x60, 0x89};
+  const aes::Schedule fips = aes::ExpandKey(key);
+  for (aes::Core core : cores) {
+    aes::SetCore(core);
+    uint8_t out[aes::kBlock];
+    aes::EncryptEcb(fips, 1, plain, out);
+    if (std::memcmp(out, cipher, aes::kBlock)) {
+      clog << aes::CoreName(core) << ": FIPS-197 example differs" << endl;
+      ++error;
+    }
+  }
+
+  // Many keys, each with batches of every length up to 40 blocks, and the
+  // context aes256_encrypt_ecb leaves behind.
+  for (int trial = 0; trial < 200; ++trial) {
+    kernels::FillBytes(key, aes::kKeyBytes, rng);
+    const size_t blocks = trial % 40 + 1;
+    vector<uint8_t> in(blocks * aes::kBlock), expected(in.size());
+    kernels::FillBytes(in.data(), in.size(), rng);
+    Reference(args, key, blocks, in.data(), expected.data());
+    const aes::Schedule schedule = aes::ExpandKey(key);
+    const uint8_t* ctx = args.Ptr<uint8_t*>(0);
+    const uint8_t* last = schedule.bytes + 7 * aes::kKeyBytes;
+    if (std::memcmp(ctx, last, aes::kKeyBytes) ||
+        std::memcmp(ctx + aes::kKeyBytes, key, aes::kKeyBytes) ||
+        std::memcmp(ctx + 2 * aes::kKeyBytes, last, aes::kKeyBytes)) {
+      clog << "key schedule differs from the context of trial " << trial
+           << endl;
+      ++error;
+    }
+    for (aes::Core core : cores) {
+      aes::SetCore(core);
+      vector<uint8_t> out(in.size());
+      aes::EncryptEcb(schedule, blocks, in.data(), out.data());
+      if (out != expected) {
+        clog << aes::CoreName(core) << ": " << blocks
+             << " blocks differ in trial " << trial << endl;
+        ++error;
+      }
+    }
+  }
+
+  // One key over a large buffer, encrypted in place and out of place.
+  const size_t blocks = megabytes * (1 << 20) / aes::kBlock;
+  vector<uint8_t> in(blocks * aes::kBlock), out(in.size());
+  kernels::FillBytes(in.data(), in.size(), rng);
+  kernels::FillBytes(key, aes::kKeyBytes, rng);
+  const size_t sample = std::min<size_t>(blocks, 1 << 16);
+  vector<uint8_t> expected(sample * aes::kBlock);
+  bench::Timing reference = bench::Measure(0, 3, [] {}, [&] {
+    Reference(args, key, sample, in.data(), expected.data());
+  });
+  const double reference_rate = sample * aes::kBlock / reference.median / 1e6;
+  cout << "reference: " << reference_rate << " MB/s" << endl;
+  const aes::Schedule schedule = aes::ExpandKey(key);
+  for (aes::Core core : cores) {
+    aes::SetCore(core);
+    bench::Timing timing = bench::Measure(1, 3, [] {}, [&] {
+      aes::EncryptEcb(schedule, blocks, in.data(), out.data());
+    });
+    vector<uint8_t> in_place(in.begin(), in.begin() + expected.size());
+    aes::EncryptEcb(schedule, sample, in_place.data(), in_place.data());
+    if (!std::equal(expected.begin(), expected.end(), out.begin()) ||
+        in_place != expected) {
+      clog << aes::CoreName(core) << ": " << megabytes << " MB differ" << endl;
+      ++error;
+    }
+    const double rate = blocks * aes::kBlock / timing.median / 1e6;
+    cout << aes::CoreName(core) << ": " << rate << " MB/s, speedup "
+         << rate / reference_rate << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+#include "aes.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace aes {
+
+namespace {
+
+// Blocks per parallel task.
+const size_t kTask = 4096;
+
+uint8_t Xtime(uint8_t x) {
+  return static_cast<uint8_t>(x & 0x80 ? (x << 1) ^ 0x1b : x << 1);
+}
+
+uint32_t Rotl8(uint32_t x) { return x << 8 | x >> 24; }
+
+// The S-box and the T-tables of the portable core, built once: Te[k][s] is
+// column k of MixColumns applied to sbox[s], bytes in row order from the
+// least significant end.
+struct Tables {
+  uint8_t sbox[256];
+  uint32_t te[4][256];
+
+  Tables() {
+    // sbox[x] is the affine transform of the inverse of x in GF(2^8); p and
+    // q walk the powers of 3 and 1/3 together.
+    uint8_t p = 1, q = 1;
+    do {
+      p = p ^ Xtime(p);
+      q ^= q << 1;
+      q ^= q << 2;
+      q ^= q << 4;
+      if (q & 0x80) q ^= 0x09;
+      const uint8_t x = q ^ (q << 1 | q >> 7) ^ (q << 2 | q >> 6) ^
+                        (q << 3 | q >> 5) ^ (q << 4 | q >> 4);
+      sbox[p] = x ^ 0x63;
+    } while (p != 1);
+    sbox[0] = 0x63;
+    for (int s = 0; s < 256; ++s) {
+      const uint32_t b = sbox[s];
+      const uint32_t b2 = Xtime(sbox[s]);
+      te[0][s] = b2 | b << 8 | b << 16 | (b2 ^ b) << 24;
+      for (int k = 1; k < 4; ++k) te[k][s] = Rotl8(te[k - 1][s]);
+    }
+  }
+};
+
+const Tables& T() {
+  static const Tables tables;
+  return tables;
+}
+
+uint32_t Load32(const uint8_t* p) {
+  uint32_t x;
+  std::memcpy(&x, p, 4);
+  return x;
+}
+
+void Store32(uint8_t* p, uint32_t x) { std::memcpy(p, &x, 4); }
+
+// Four blocks in lockstep to overlap their table lookups. Columns are
+// little-endian words, row r in byte r.
+const int kTableWays = 4;
+
+template <int kWays>
+void BlocksTable(const Schedule& schedule, const uint8_t* in, uint8_t* out) {
+  const Tables& t = T();
+  uint32_t rk[60];
+  for (int i = 0; i < 60; ++i) rk[i] = Load32(schedule.bytes + 4 * i);
+  uint32_t s[kWays][4], n[kWays][4];
+  for (int w = 0; w < kWays; ++w) {
+    for (int c = 0; c < 4; ++c) {
+      s[w][c] = Load32(in + w * kBlock + 4 * c) ^ rk[c];
+    }
+  }
+  for (int r = 1; r < 14; ++r) {
+    for (int w = 0; w < kWays; ++w) {
+      for (int c = 0; c < 4; ++c) {
+        n[w][c] = t.te[0][s[w][c] & 0xff] ^
+                  t.te[1][s[w][(c + 1) & 3] >> 8 & 0xff] ^
+                  t.te[2][s[w][(c + 2) & 3] >> 16 & 0xff] ^
+                  t.te[3][s[w][(c + 3) & 3] >> 24] ^ rk[4 * r + c];
+      }
+    }
+    std::memcpy(s, n, sizeof(s));
+  }
+  auto sub = [&](uint32_t x) { return uint32_t{t.sbox[x & 0xff]}; };
+  for (int w = 0; w < kWays; ++w) {
+    for (int c = 0; c < 4; ++c) {
+      const uint32_t x = sub(s[w][c]) | sub(s[w][(c + 1) & 3] >> 8) << 8 |
+                         sub(s[w][(c + 2) & 3] >> 16) << 16 |
+                         sub(s[w][(c + 3) & 3] >> 24) << 24;
+      Store32(out + w * kBlock + 4 * c, x ^ rk[56 + c]);
+    }
+  }
+}
+
+void EncryptTable(const Schedule& schedule, size_t blocks, const uint8_t* in,
+                  uint8_t* out) {
+  size_t b = 0;
+  for (; b + kTableWays <= blocks; b += kTableWays) {
+    BlocksTable<kTableWays>(schedule, in + b * kBlock, out + b * kBlock);
+  }
+  for (; b < blocks; ++b) {
+    BlocksTable<1>(schedule, in + b * kBlock, out + b * kBlock);
+  }
+}
+
+// Eight blocks in flight hide the latency of aesenc.
+const int kNiWays = 8;
+
+template <int kWays>
+__attribute__((target("aes,sse4.1"))) void BlocksAesNi(const __m128i* rk,
+                                                       const uint8_t* in,
+                                                       uint8_t* out) {
+  __m128i s[kWays];
+  for (int w = 0; w < kWays; ++w) {
+    s[w] = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + w * kBlock)),
+        rk[0]);
+  }
+  for (int r = 1; r < 14; ++r) {
+    for (int w = 0; w < kWays; ++w) s[w] = _mm_aesenc_si128(s[w], rk[r]);
+  }
+  for (int w = 0; w < kWays; ++w) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + w * kBlock),
+                     _mm_aesenclast_si128(s[w], rk[14]));
+  }
+}
+
+__attribute__((target("aes,sse4.1"))) void EncryptAesNi(
+    const Schedule& schedule, size_t blocks, const uint8_t* in,
+    uint8_t* out) {
+  __m128i rk[15];
+  for (int r = 0; r < 15; ++r) {
+    rk[r] = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(schedule.bytes + 16 * r));
+  }
+  size_t b = 0;
+  for (; b + kNiWays <= blocks; b += kNiWays) {
+    BlocksAesNi<kNiWays>(rk, in + b * kBlock, out + b * kBlock);
+  }
+  for (; b < blocks; ++b) {
+    BlocksAesNi<1>(rk, in + b * kBlock, out + b * kBlock);
+  }
+}
+
+// Four 512-bit registers of four blocks each.
+const int kVaesWays = 4;
+
+__attribute__((target("vaes,avx512f,aes,sse4.1"))) void EncryptVaes(
+    const Schedule& schedule, size_t blocks, const uint8_t* in,
+    uint8_t* out) {
+  __m512i rk[15];
+  for (int r = 0; r < 15; ++r) {
+    rk[r] = _mm512_broadcast_i32x4(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(schedule.bytes + 16 * r)));
+  }
+  const size_t group = 4 * kVaesWays;
+  size_t b = 0;
+  for (; b + group <= blocks; b += group) {
+    __m512i s[kVaesWays];
+    for (int w = 0; w < kVaesWays; ++w) {
+      s[w] = _mm512_xor_si512(
+          _mm512_loadu_si512(in + (b + 4 * w) * kBlock), rk[0]);
+    }
+    for (int r = 1; r < 14; ++r) {
+      for (int w = 0; w < kVaesWays; ++w) {
+        s[w] = _mm512_aesenc_epi128(s[w], rk[r]);
+      }
+    }
+    for (int w = 0; w < kVaesWays; ++w) {
+      _mm512_storeu_si512(out + (b + 4 * w) * kBlock,
+                          _mm512_aesenclast_epi128(s[w], rk[14]));
+    }
+  }
+  if (b < blocks) {
+    EncryptAesNi(schedule, blocks - b, in + b * kBlock, out + b * kBlock);
+  }
+}
+
+using Encrypt = void (*)(const Schedule&, size_t, const uint8_t*, uint8_t*);
+
+const Encrypt kCores[] = {EncryptTable, EncryptAesNi, EncryptVaes};
+
+bool Supported(Core core) {
+  switch (core) {
+    case Core::kTable: return true;
+    case Core::kAesNi:
+      return __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse4.1");
+    case Core::kVaes:
+      return Supported(Core::kAesNi) && __builtin_cpu_supports("vaes") &&
+             __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetCore, -1 until then; EncryptEcb may read it on another thread.
+std::atomic<int> forced{-1};
+
+Core Selected() {
+  static const Core best = BestCore();
+  const int core = forced.load(std::memory_order_acquire);
+  return core >= 0 ? static_cast<Core>(core) : best;
+}
+
+}  // namespace
+
+Schedule ExpandKey(const uint8_t key[kKeyBytes]) {
+  const uint8_t* sbox = T().sbox;
+  Schedule schedule;
+  std::memcpy(schedule.bytes, key, kKeyBytes);
+  uint8_t rcon = 1;
+  for (int e = 1; e < 8; ++e) {
+    const uint8_t* p = schedule.bytes + (e - 1) * kKeyBytes;
+    uint8_t* k = schedule.bytes + e * kKeyBytes;
+    k[0] = p[0] ^ sbox[p[29]] ^ rcon;
+    k[1] = p[1] ^ sbox[p[30]];
+    k[2] = p[2] ^ sbox[p[31]];
+    k[3] = p[3] ^ sbox[p[28]];
+    rcon = Xtime(rcon);
+    for (int i = 4; i < 16; ++i) k[i] = p[i] ^ k[i - 4];
+    for (int i = 16; i < 20; ++i) k[i] = p[i] ^ sbox[k[i - 4]];
+    for (int i = 20; i < 32; ++i) k[i] = p[i] ^ k[i - 4];
+  }
+  return schedule;
+}
+
+Core BestCore() {
+  if (Supported(Core::kVaes)) return Core::kVaes;
+  if (Supported(Core::kAesNi)) return Core::kAesNi;
+  return Core::kTable;
+}
+
+Core CurrentCore() { return Selected(); }
+
+bool SetCore(Core core) {
+  if (!Supported(core)) return false;
+  forced.store(static_cast<int>(core), std::memory_order_release);
+  return true;
+}
+
+const char* CoreName(Core core) {
+  switch (core) {
+    case Core::kTable: return "table";
+    case Core::kAesNi: return "aes-ni";
+    case Core::kVaes: return "vaes";
+  }
+  return "?";
+}
+
+void EncryptEcb(const Schedule& schedule, size_t blocks, const uint8_t* in,
+                uint8_t* out) {
+  const Encrypt encrypt = kCores[static_cast<int>(Selected())];
+  if (blocks <= kTask) {
+    encrypt(schedule, blocks, in, out);
+    return;
+  }
+  const long tasks = static_cast<long>((blocks + kTask - 1) / kTask);
+#pragma omp parallel for schedule(static)
+  for (long t = 0; t < tasks; ++t) {
+    const size_t first = t * kTask;
+    encrypt(schedule, std::min(kTask, blocks - first), in + first * kBlock,
+            out + first * kBlock);
+  }
+}
+
+}  // namespace aes
@@ -0,0 +1,45 @@
+#ifndef AES_H_
+#define AES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Batched AES-256 encryption with the cipher of data/sources/aes_kernel.c.
+// aes256_encrypt_ecb expands the key again for every 16-byte block; here the
+// key is expanded once and any number of blocks is encrypted with it, by a
+// core selected at run time (VAES, AES-NI or portable T-tables).
+namespace aes {
+
+const int kBlock = 16;
+const int kKeyBytes = 32;
+
+// The key schedule as aes_expandEncKey_1 produces it: the key followed by
+// seven expansions of 32 bytes. Round key r is bytes 16r .. 16r + 15 for
+// r = 0..14; the last 32 bytes are what aes256_encrypt_ecb leaves in
+// ctx->key and ctx->deckey.
+struct Schedule {
+  uint8_t bytes[8 * kKeyBytes];
+};
+
+Schedule ExpandKey(const uint8_t key[kKeyBytes]);
+
+enum class Core { kTable, kAesNi, kVaes };
+
+// The fastest core the CPU supports.
+Core BestCore();
+// The core in use, BestCore() unless overridden.
+Core CurrentCore();
+// Forces a core, e.g. to test every path on one machine. Returns false and
+// keeps the current one when the CPU lacks the instructions.
+bool SetCore(Core core);
+const char* CoreName(Core core);
+
+// Encrypts `blocks` consecutive 16-byte blocks from `in` to `out` in ECB
+// mode; in and out may be the same buffer. Large batches are spread over the
+// OpenMP threads.
+void EncryptEcb(const Schedule& schedule, size_t blocks, const uint8_t* in,
+                uint8_t* out);
+
+}  // namespace aes
+
+#endif
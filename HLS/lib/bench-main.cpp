@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using kernels::Args;
+using kernels::Kernel;
+
+// Times every kernel of data/sources (or the named ones) on the CPU and prints
+// one JSON object per kernel, keyed by the data/designs name.
+int main(int argc, char** argv) {
+  int warmup = 3;
+  int reps = 20;
+  vector<const Kernel*> selected;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+      warmup = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+      reps = atoi(argv[++i]);
+    } else if (const Kernel* kernel = kernels::FindKernel(argv[i])) {
+      selected.push_back(kernel);
+    } else {
+      clog << "Usage: " << argv[0] << " [-w warmup] [-r reps] [kernel...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (reps < 1) reps = 1;
+  if (selected.empty()) {
+    for (const Kernel& kernel : kernels::Registry()) selected.push_back(&kernel);
+  }
+
+  cout << "[" << endl;
+  for (size_t k = 0; k < selected.size(); ++k) {
+    const Kernel& kernel = *selected[k];
+    bench::Cost cost;
+    if (!bench::KernelCost(kernel.name, &cost)) {
+      clog << "No cost model for " << kernel.name << endl;
+      return EXIT_FAILURE;
+    }
+    clog << "Benchmark " << kernel.name << endl;
+
+    const Args input = kernels::MakeArgs(kernel);
+    Args args = input;
+    bench::Timing t = bench::Measure(
+        warmup, reps, [&] { args = input; }, [&] { kernel.run(args); });
+
+    cout << "  {\"kernel\": \"" << kernel.name << "\", \"source\": \""
+         << kernel.source << "\", \"warmup\": " << warmup
+         << ", \"reps\": " << reps << ", \"time_min_s\": " << t.min
+         << ", \"time_median_s\": " << t.median
+         << ", \"time_mean_s\": " << t.mean << ", \"flops\": " << cost.flops
+         << ", \"bytes\": " << cost.bytes
+         << ", \"gflops\": " << cost.flops / t.median * 1e-9
+         << ", \"gbps\": " << cost.bytes / t.median * 1e-9 << "}"
+         << (k + 1 < selected.size() ? "," : "") << endl;
+  }
+  cout << "]" << endl;
+  return EXIT_SUCCESS;
+}
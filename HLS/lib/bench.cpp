@@ -0,0 +1,95 @@
+#include "bench.h"
+
+#include <map>
+#include <set>
+
+#include "kernels.h"
+
+namespace bench {
+
+namespace {
+
+struct Work {
+  double flops;
+  std::set<std::string> outputs;  // array arguments the kernel writes
+};
+
+// Operation counts follow the loop nests of data/sources one to one.
+const std::map<std::string, Work>& WorkTable() {
+  static const std::map<std::string, Work> table = {
+      {"2mm", {3.0 * 40 * 50 * 70 + 40 * 80 + 2.0 * 40 * 80 * 50,
+               {"tmp", "D"}}},
+      {"3mm", {2.0 * (40 * 50 * 60 + 50 * 70 * 80 + 40 * 70 * 50),
+               {"E", "F", "G"}}},
+      // Per timestep, two sweeps of 58 systems of 58 unknowns: 13 flops per
+      // forward-elimination step and 2 per back-substitution step.
+      {"adi", {40.0 * 2 * 58 * 58 * (13 + 2), {"u", "v", "p", "q"}}},
+      {"aes", {0.0, {"ctx", "buf"}}},
+      {"atax", {4.0 * 116 * 124, {"y", "tmp"}}},
+      {"atax-medium", {4.0 * 390 * 410, {"y", "tmp"}}},
+      {"bicg", {4.0 * 124 * 116, {"s", "q"}}},
+      {"bicg-large", {4.0 * 410 * 390, {"s", "q"}}},
+      {"bicg-medium", {4.0 * 410 * 390, {"s", "q"}}},
+      // Mean, variance, centring and the strict upper triangle of data^T data.
+      {"correlation", {100.0 * 80 + 80 + 3.0 * 100 * 80 + 2 * 80 +
+                           4.0 * 100 * 80 + 2.0 * 100 * (80 * 79 / 2),
+                       {"data", "corr", "mean", "stddev"}}},
+      {"covariance", {100.0 * 80 + 80 + 100.0 * 80 +
+                          (2.0 * 100 + 2) * (80 * 81 / 2),
+                      {"data", "cov", "mean"}}},
+      {"doitgen", {2.0 * 25 * 20 * 30 * 30, {"A", "sum"}}},
+      {"doitgen-red", {2.0 * 25 * 20 * 30 * 30, {"A", "sum"}}},
+      {"fdtd-2d", {40.0 * (3 * 59 * 80 + 3 * 60 * 79 + 5 * 59 * 79),
+                   {"ex", "ey", "hz"}}},
+      {"fdtd-2d-large", {100.0 * (3 * 199 * 240 + 3 * 200 * 239 + 5 * 199 * 239),
+                         {"ex", "ey", "hz"}}},
+      {"gemm-blocked", {2.0 * 64 * 64 * 64, {"prod"}}},
+      {"gemm-ncubed", {2.0 * 64 * 64 * 64, {"prod"}}},
+      {"gemm-p", {60.0 * 70 + 3.0 * 60 * 80 * 70, {"C"}}},
+      {"gemm-p-large", {200.0 * 220 + 3.0 * 200 * 240 * 220, {"C"}}},
+      {"gemver", {10.0 * 120 * 120 + 120, {"A", "w", "x"}}},
+      {"gemver-medium", {10.0 * 400 * 400 + 400, {"A", "w", "x"}}},
+      {"gesummv", {4.0 * 90 * 90 + 3 * 90, {"tmp", "y"}}},
+      {"gesummv-medium", {4.0 * 250 * 250 + 3 * 250, {"tmp", "y"}}},
+      {"heat-3d", {40.0 * 2 * 18 * 18 * 18 * 15, {"A", "B"}}},
+      {"jacobi-1d", {40.0 * 2 * 118 * 3, {"A", "B"}}},
+      {"jacobi-2d", {40.0 * 2 * 88 * 88 * 5, {"A", "B"}}},
+      {"md", {21.0 * 256 * 16, {"force_x", "force_y", "force_z"}}},
+      {"mvt", {4.0 * 120 * 120, {"x1", "x2"}}},
+      {"mvt-medium", {4.0 * 400 * 400, {"x1", "x2"}}},
+      {"nw", {0.0, {"M", "ptr"}}},
+      {"seidel-2d", {40.0 * 118 * 118 * 9, {"A"}}},
+      {"spmv-crs", {2.0 * 1666, {"out"}}},
+      {"spmv-ellpack", {2.0 * 4940, {"out"}}},
+      {"stencil", {2.0 * 9 * 126 * 62, {"sol"}}},
+      {"stencil-3d", {9.0 * 32 * 32 * 32, {"sol"}}},
+      // The k < i triangle holds 60 * 59 / 2 updates per column of C.
+      {"symm", {80.0 * (5 * (60 * 59 / 2) + 6 * 60), {"C"}}},
+      {"symm-opt", {80.0 * (5 * (60 * 59 / 2) + 6 * 60), {"C"}}},
+      {"symm-opt-medium", {240.0 * (5 * (200 * 199 / 2) + 6 * 200), {"C"}}},
+      {"syr2k", {(80.0 * 81 / 2) * (1 + 6 * 60), {"C"}}},
+      {"syrk", {(80.0 * 81 / 2) * (1 + 3 * 60), {"C"}}},
+      {"trmm", {80.0 * 2 * (60 * 59 / 2) + 60 * 80, {"B"}}},
+      {"trmm-opt", {80.0 * 2 * (60 * 59 / 2) + 60 * 80, {"B"}}},
+  };
+  return table;
+}
+
+}  // namespace
+
+bool KernelCost(const std::string& name, Cost* cost) {
+  auto it = WorkTable().find(name);
+  const kernels::Kernel* kernel = kernels::FindKernel(name);
+  if (it == WorkTable().end() || kernel == nullptr) return false;
+
+  cost->flops = it->second.flops;
+  cost->bytes = 0;
+  for (const kernels::ArgSpec& arg : kernel->args) {
+    if (arg.shape.empty()) continue;
+    cost->bytes += arg.Bytes();
+    if (it->second.outputs.count(arg.name)) cost->bytes += arg.Bytes();
+  }
+  return true;
+}
+
+}  // namespace bench
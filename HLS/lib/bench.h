@@ -0,0 +1,56 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// CPU benchmarking of the data/sources kernels: analytic work counts and a
+// warmup/repetition timer.
+namespace bench {
+
+// Analytic work of one kernel invocation. flops counts the arithmetic
+// operations of the reference loops (integer operations for the integer
+// kernels, none for aes and nw); bytes is the compulsory traffic, i.e. every
+// array argument read once plus every output array written back once.
+struct Cost {
+  double flops;
+  double bytes;
+};
+
+// Returns false when the kernel has no entry in the cost table.
+bool KernelCost(const std::string& name, Cost* cost);
+
+struct Timing {
+  double min;     // seconds
+  double median;  // seconds
+  double mean;    // seconds
+};
+
+// Runs `setup` then `run` warmup + reps times and times `run` only, so that
+// kernels updating their inputs in place can be restored between runs.
+template <typename Setup, typename Run>
+Timing Measure(int warmup, int reps, Setup setup, Run run) {
+  using std::chrono::steady_clock;
+  for (int i = 0; i < warmup; ++i) {
+    setup();
+    run();
+  }
+  std::vector<double> seconds;
+  for (int i = 0; i < reps; ++i) {
+    setup();
+    auto begin = steady_clock::now();
+    run();
+    auto end = steady_clock::now();
+    seconds.push_back(std::chrono::duration<double>(end - begin).count());
+  }
+  std::sort(seconds.begin(), seconds.end());
+  Timing timing = {seconds.front(), seconds[seconds.size() / 2], 0.0};
+  for (double s : seconds) timing.mean += s / seconds.size();
+  return timing;
+}
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,178 @@
+#include "cache.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace cache {
+
+namespace {
+
+bool IsWord(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool IsOperator(char c) {
+  return c != '\0' && std::strchr("+-*/%&|<>=!^.:#", c) != nullptr;
+}
+
+// Whether a space between a and b keeps them from reading as one token,
+// e.g. in "int x", "a - -b" or L "s".
+bool Separates(char a, char b) {
+  return (IsWord(a) && (IsWord(b) || b == '"' || b == '\'')) ||
+         (IsOperator(a) && IsOperator(b));
+}
+
+// A temporary file in `dir` for writing an entry that is then renamed into
+// place.
+std::string TempFile(const std::string& dir) {
+  std::string name = dir + "/tmp-XXXXXX";
+  const int fd = mkstemp(name.data());
+  if (fd < 0) throw std::system_error(errno, std::generic_category(), name);
+  close(fd);
+  return name;
+}
+
+}  // namespace
+
+std::string Normalize(const std::string& code) {
+  std::string out;
+  bool space = false;       // whitespace or a comment since the last character
+  bool newline = false;     // a preprocessor line starts or ended there
+  bool line_start = true;   // nothing but whitespace since the last newline
+  bool directive = false;   // in a preprocessor line, where spaces all count
+  auto put = [&](char c) {
+    if (!out.empty() && out.back() != '\n') {
+      if (newline) {
+        out += '\n';
+      } else if (space && (directive || Separates(out.back(), c))) {
+        out += ' ';
+      }
+    }
+    out += c;
+    space = newline = line_start = false;
+  };
+  const size_t n = code.size();
+  size_t i = 0;
+  while (i < n) {
+    const char c = code[i];
+    const char next = i + 1 < n ? code[i + 1] : '\0';
+    if (c == '\\' && next == '\n') {
+      i += 2;  // a spliced line
+    } else if (c == '/' && next == '/') {
+      while (i < n && code[i] != '\n') ++i;
+      space = true;
+    } else if (c == '/' && next == '*') {
+      const size_t end = code.find("*/", i + 2);
+      i = end == std::string::npos ? n : end + 2;
+      space = true;
+    } else if (c == '"' || c == '\'') {
+      put(c);
+      for (++i; i < n && code[i] != c && code[i] != '\n'; ++i) {
+        out += code[i];
+        if (code[i] == '\\' && i + 1 < n) out += code[++i];
+      }
+      if (i < n && code[i] == c) out += code[i++];
+    } else if (c == '\n') {
+      if (directive) newline = true;
+      directive = false;
+      line_start = space = true;
+      ++i;
+    } else if (std::isspace(static_cast<unsigned char>(c))) {
+      space = true;
+      ++i;
+    } else {
+      if (c == '#' && line_start) {
+        directive = true;
+        newline = true;
+      }
+      put(c);
+      ++i;
+    }
+  }
+  return out;
+}
+
+Hasher& Hasher::Add(const void* data, size_t bytes) {
+  const unsigned __int128 prime =
+      (static_cast<unsigned __int128>(1) << 88) | 0x13b;
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < bytes; ++i) {
+    state_ ^= p[i];
+    state_ *= prime;
+  }
+  return *this;
+}
+
+Hasher& Hasher::Add(const std::string& text) {
+  const unsigned long long size = text.size();
+  Add(&size, sizeof(size));
+  return Add(text.data(), text.size());
+}
+
+std::string Hasher::Hex() const {
+  static const char digits[] = "0123456789abcdef";
+  std::string hex(32, '0');
+  unsigned __int128 state = state_;
+  for (int i = 31; i >= 0; --i, state >>= 4) hex[i] = digits[state & 0xf];
+  return hex;
+}
+
+std::string Key(const std::string& code, const std::string& flags) {
+  return Hasher().Add(Normalize(code)).Add(flags).Hex();
+}
+
+Store::Store(const std::string& dir) : dir_(dir) {
+  fs::create_directories(fs::path(dir_) / "objects");
+  fs::create_directories(fs::path(dir_) / "outcomes");
+}
+
+std::string Store::Object(const std::string& key) const {
+  return dir_ + "/objects/" + key + ".so";
+}
+
+bool Store::HasObject(const std::string& key) const {
+  return fs::exists(Object(key));
+}
+
+void Store::PutObject(const std::string& key,
+                      const std::string& object) const {
+  // Copied rather than renamed, as `object` may be on another file system.
+  const std::string temp = TempFile(dir_);
+  fs::copy_file(object, temp, fs::copy_options::overwrite_existing);
+  fs::rename(temp, Object(key));
+  fs::remove(object);
+}
+
+bool Store::GetOutcome(const std::string& key, std::string* outcome) const {
+  std::ifstream in(dir_ + "/outcomes/" + key);
+  if (!in) return false;
+  std::stringstream text;
+  text << in.rdbuf();
+  *outcome = text.str();
+  return true;
+}
+
+void Store::PutOutcome(const std::string& key,
+                       const std::string& outcome) const {
+  const std::string temp = TempFile(dir_);
+  {
+    std::ofstream out(temp);
+    out << outcome;
+    if (!out) {
+      throw std::system_error(EIO, std::generic_category(), temp);
+    }
+  }
+  fs::rename(temp, dir_ + "/outcomes/" + key);
+}
+
+}  // namespace cache
@@ -0,0 +1,62 @@
+#ifndef CACHE_H_
+#define CACHE_H_
+
+#include <cstddef>
+#include <string>
+
+// Content-addressed store of build products and verdicts, so that runs over
+// transformed_sources only compile and check what they have not seen before.
+// Sources are keyed by their text with comments and layout removed, since many
+// responses repeat another one or differ from it only in comments.
+namespace cache {
+
+// C source text without its comments, with each run of whitespace dropped or
+// reduced to the one space or newline that keeps the tokens and preprocessor
+// lines apart. Sources that differ only in comments and layout normalise to
+// the same text.
+std::string Normalize(const std::string& code);
+
+// 128-bit FNV-1a, printed as 32 hex digits.
+class Hasher {
+ public:
+  Hasher& Add(const void* data, size_t bytes);
+  // Adds the length first, so that ("ab", "c") and ("a", "bc") differ.
+  Hasher& Add(const std::string& text);
+  std::string Hex() const;
+
+ private:
+  unsigned __int128 state_ = (static_cast<unsigned __int128>(
+                                  0x6c62272e07bb0142ull) << 64) |
+                             0x62b821756295c58dull;
+};
+
+// The key of an object built from `code` with `flags`, which should name
+// everything besides the source that goes into the object, such as the compiler
+// and its options.
+std::string Key(const std::string& code, const std::string& flags);
+
+// A cache directory of objects/<key>.so and outcomes/<key>. Entries are
+// written to a temporary file and renamed into place, so several threads and
+// processes can share one store. Delete the directory to start afresh.
+class Store {
+ public:
+  // Creates the directory if need be.
+  explicit Store(const std::string& dir);
+
+  // Where the object of `key` is or would go.
+  std::string Object(const std::string& key) const;
+  bool HasObject(const std::string& key) const;
+  // Moves the file `object` into the store as the object of `key`.
+  void PutObject(const std::string& key, const std::string& object) const;
+
+  // False when no outcome was stored under `key`.
+  bool GetOutcome(const std::string& key, std::string* outcome) const;
+  void PutOutcome(const std::string& key, const std::string& outcome) const;
+
+ private:
+  std::string dir_;
+};
+
+}  // namespace cache
+
+#endif
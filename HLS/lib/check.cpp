@@ -0,0 +1,57 @@
+#include "check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace check {
+
+namespace {
+
+// Whether x and y have as many arrays, of the same sizes.
+bool SameShape(const Arrays& x, const Arrays& y) {
+  if (x.size() != y.size()) return false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (x[i].size() != y[i].size()) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+Arrays Random(const std::vector<size_t>& sizes, kernels::Rng& rng) {
+  Arrays arrays;
+  for (size_t size : sizes) {
+    arrays.emplace_back(size);
+    kernels::FillUniform(arrays.back().data(), size, rng);
+  }
+  return arrays;
+}
+
+bool Same(const Arrays& x, const Arrays& y) {
+  if (!SameShape(x, y)) return false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (std::memcmp(x[i].data(), y[i].data(), x[i].size() * sizeof(double))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double Error(const Arrays& x, const Arrays& reference) {
+  if (!SameShape(x, reference)) return INFINITY;
+  double error = 0.0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    for (size_t j = 0; j < x[i].size(); ++j) {
+      const double r = reference[i][j];
+      if (x[i][j] == r || (std::isnan(x[i][j]) && std::isnan(r))) continue;
+      const double diff = std::fabs(x[i][j] - r) / std::max(1.0, std::fabs(r));
+      // A NaN on one side only, or unequal infinities.
+      if (std::isnan(diff)) return INFINITY;
+      error = std::max(error, diff);
+    }
+  }
+  return error;
+}
+
+}  // namespace check
@@ -0,0 +1,45 @@
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "kernels.h"
+
+// Helpers of the engine drivers (lib/<engine>-main.cpp), which run an engine
+// and its reference loops on the same double arrays and compare what they
+// leave behind.
+namespace check {
+
+using Arrays = std::vector<std::vector<double>>;
+
+// Arrays of the given sizes with values from kernels::FillUniform.
+Arrays Random(const std::vector<size_t>& sizes, kernels::Rng& rng);
+
+// Bit for bit, for engines that keep the order of the reference loops. False
+// when the arrays differ in number or size.
+bool Same(const Arrays& x, const Arrays& y);
+
+// Largest difference over all arrays relative to max(1, |reference|), for
+// engines that reassociate sums. Infinite for a NaN on one side only, unequal
+// infinities, or arrays that differ in number or size.
+double Error(const Arrays& x, const Arrays& reference);
+
+template <typename Run, size_t... I, typename... Scalars>
+void CallWith(Run run, Arrays& arrays, std::index_sequence<I...>,
+              Scalars... scalars) {
+  run(scalars..., arrays[I].data()...);
+}
+
+// Calls run(scalars..., arrays[0].data(), ..., arrays[N - 1].data()), the
+// signature of the engines and their reference loops: sizes and scalars,
+// then the arrays.
+template <size_t N, typename Run, typename... Scalars>
+void Call(Run run, Arrays& arrays, Scalars... scalars) {
+  CallWith(run, arrays, std::make_index_sequence<N>(), scalars...);
+}
+
+}  // namespace check
+
+#endif
@@ -19,6 +19,17 @@ using std::isfinite;
 using std::max;
 using std::string;
 
+// The input-channel reduction is split into kReduceGroups contiguous groups of
+// channels. Each group is summed in order into its own partial buffer and the
+// partials are combined with a fixed pairwise tree, so the summation order (and
+// therefore the result) is the same for any number of threads.
+const int kReduceGroups = 16;
+const int kGroupSize = kNum / kReduceGroups;
+static_assert(kNum % kReduceGroups == 0,
+              "kNum must be a multiple of kReduceGroups");
+static_assert((kReduceGroups & (kReduceGroups - 1)) == 0,
+              "kReduceGroups must be a power of two");
+
 // Sequential CNN implementation
 void CnnSequential(
     const float input[kNum][kInImSize][kInImSize],
@@ -28,6 +39,7 @@ void CnnSequential(
   ) {
   // Allocate memory on heap to avoid stack overflow.
   static float C[kNum][kImSize][kImSize];
+  static float partial[kReduceGroups][kImSize][kImSize];
 
   for (int i = 0; i < kNum; ++i) {
     for (int h = 0; h < kImSize; ++h) {
@@ -39,17 +51,44 @@ void CnnSequential(
 
   // Convolution
   for (int i = 0; i < kNum; ++i) {
-    for (int j = 0; j < kNum; ++j) {
+#pragma omp parallel for schedule(static)
+    for (int g = 0; g < kReduceGroups; ++g) {
       for (int h = 0; h < kImSize; ++h) {
         for (int w = 0; w < kImSize; ++w) {
-          for (int p = 0; p < kKernel; ++p) {
-            for (int q = 0; q < kKernel; ++q) {
-              C[i][h][w] += weight[i][j][p][q] * input[j][h + p][w + q];
+          partial[g][h][w] = 0.f;
+        }
+      }
+      for (int j = g * kGroupSize; j < (g + 1) * kGroupSize; ++j) {
+        for (int h = 0; h < kImSize; ++h) {
+          for (int w = 0; w < kImSize; ++w) {
+            for (int p = 0; p < kKernel; ++p) {
+              for (int q = 0; q < kKernel; ++q) {
+                partial[g][h][w] += weight[i][j][p][q] * input[j][h + p][w + q];
+              }
             }
           }
         }
       }
     }
+
+    // Pairwise tree over the group partials; the tree shape depends only on
+    // kReduceGroups, never on the thread count.
+    for (int stride = 1; stride < kReduceGroups; stride *= 2) {
+#pragma omp parallel for schedule(static)
+      for (int h = 0; h < kImSize; ++h) {
+        for (int g = 0; g < kReduceGroups; g += 2 * stride) {
+          for (int w = 0; w < kImSize; ++w) {
+            partial[g][h][w] += partial[g + stride][h][w];
+          }
+        }
+      }
+    }
+
+    for (int h = 0; h < kImSize; ++h) {
+      for (int w = 0; w < kImSize; ++w) {
+        C[i][h][w] += partial[0][h][w];
+      }
+    }
   }
 
   // ReLU
@@ -0,0 +1,173 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "compare.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+const double kInf = std::numeric_limits<double>::infinity();
+
+// x moved by `steps` doubles towards +inf, or -inf when negative.
+double Step(double x, int steps) {
+  for (int i = 0; i < std::abs(steps); ++i) {
+    x = std::nextafter(x, steps > 0 ? kInf : -kInf);
+  }
+  return x;
+}
+
+// Expected values around 1 and 1e6 with some zeros, and actual values that
+// are mostly the same, some a few ULPs away, some far away, and some NaN,
+// infinite or zeros of the other sign.
+void Perturbed(size_t count, kernels::Rng& rng, vector<double>* expected,
+               vector<double>* actual) {
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::uniform_int_distribution<int> kind(0, 15);
+  std::uniform_int_distribution<int> steps(-40, 40);
+  expected->resize(count);
+  actual->resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    double e = value(rng) * (kind(rng) < 8 ? 1.0 : 1e6);
+    if (kind(rng) == 0) e = 0.0;
+    if (kind(rng) == 0) e = kind(rng) < 8 ? kNaN : -kInf;
+    double a = e;
+    switch (kind(rng)) {
+      case 0: a = Step(e, steps(rng)); break;
+      case 1: a = e + value(rng) * 1e-3; break;
+      case 2: a = kNaN; break;
+      case 3: a = kInf; break;
+      case 4: a = e == 0.0 ? -0.0 : -e; break;
+      case 5: a = Step(e, 1); break;
+      default: break;
+    }
+    (*expected)[i] = e;
+    (*actual)[i] = a;
+  }
+}
+
+bool Same(double x, double y) {
+  return std::memcmp(&x, &y, sizeof(x)) == 0;
+}
+
+bool Same(const compare::Stats& x, const compare::Stats& y) {
+  return x.count == y.count && x.differing == y.differing &&
+         x.beyond_absolute == y.beyond_absolute && x.beyond == y.beyond &&
+         x.nan_mismatches == y.nan_mismatches &&
+         x.inf_mismatches == y.inf_mismatches && x.max_ulps == y.max_ulps &&
+         Same(x.max_absolute, y.max_absolute) &&
+         Same(x.max_relative, y.max_relative) && x.worst == y.worst &&
+         x.worst_ulps == y.worst_ulps &&
+         Same(x.worst_expected, y.worst_expected) &&
+         Same(x.worst_actual, y.worst_actual);
+}
+
+int CheckUlps(double expected, double actual, uint64_t ulps) {
+  const uint64_t got = compare::Ulps(expected, actual);
+  if (got == ulps) return 0;
+  clog << "Ulps(" << expected << ", " << actual << ") is " << got
+       << " instead of " << ulps << endl;
+  return 1;
+}
+
+}  // namespace
+
+// Checks ULP distances of special values, then the vectorised comparison
+// against the element-by-element one on perturbed arrays of every tail
+// length, and times both on `count` elements:
+//   compare [count]
+int main(int argc, char** argv) {
+  const long count = argc > 1 ? std::atol(argv[1]) : 1L << 22;
+  if (argc > 2 || count <= 0) {
+    clog << "Usage: " << argv[0] << " [count]\n";
+    return EXIT_FAILURE;
+  }
+
+  int error = 0;
+  error += CheckUlps(1.0, 1.0, 0);
+  error += CheckUlps(0.0, -0.0, 0);
+  error += CheckUlps(kNaN, -kNaN, 0);
+  error += CheckUlps(kInf, kInf, 0);
+  error += CheckUlps(1.0, Step(1.0, 1), 1);
+  error += CheckUlps(1.0, Step(1.0, -3), 3);
+  error += CheckUlps(-DBL_TRUE_MIN, DBL_TRUE_MIN, 2);
+  error += CheckUlps(DBL_MAX, -DBL_MAX, 0xffdffffffffffffeull);
+  error += CheckUlps(kNaN, 1.0, compare::kMaxUlps);
+  error += CheckUlps(DBL_MAX, kInf, compare::kMaxUlps);
+  error += CheckUlps(kInf, -kInf, compare::kMaxUlps);
+
+  kernels::Rng rng(42);
+  const compare::Tolerance tolerances[] = {{}, {1e-6, 16}, {0.0, 0}};
+  vector<double> expected, actual;
+  for (size_t n = 0; n < 80; ++n) {
+    for (const compare::Tolerance& tolerance : tolerances) {
+      Perturbed(n, rng, &expected, &actual);
+      const compare::Stats reference = compare::CompareReference(
+          expected.data(), actual.data(), n, tolerance);
+      const compare::Stats fast =
+          compare::Compare(expected.data(), actual.data(), n, tolerance);
+      if (!Same(reference, fast)) {
+        clog << n << " elements, " << tolerance.ulps
+             << " ULPs: stats differ from the reference" << endl;
+        ++error;
+      }
+    }
+  }
+  const vector<int> shape = {4, 5, 6};
+  if (compare::Coordinates(3 * 30 + 2 * 6 + 5, shape) != "[3][2][5]") {
+    clog << "Coordinates of 107 in 4x5x6 are "
+         << compare::Coordinates(107, shape) << endl;
+    ++error;
+  }
+
+  // Rounding noise everywhere: the slow path of both.
+  expected.resize(count);
+  actual.resize(count);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  for (long i = 0; i < count; ++i) {
+    expected[i] = value(rng);
+    actual[i] = Step(expected[i], static_cast<int>(i % 5) - 2);
+  }
+  const compare::Tolerance tolerance{1e-6, 4};
+  compare::Stats reference, fast;
+  const bench::Timing slow = bench::Measure(1, 5, [] {}, [&] {
+    reference = compare::CompareReference(expected.data(), actual.data(),
+                                          count, tolerance);
+  });
+  const bench::Timing quick = bench::Measure(1, 5, [] {}, [&] {
+    fast = compare::Compare(expected.data(), actual.data(), count, tolerance);
+  });
+  if (!Same(reference, fast)) {
+    clog << count << " elements of noise: stats differ from the reference"
+         << endl;
+    ++error;
+  }
+  const double bytes = 2.0 * sizeof(double) * count;
+  cout << count << " elements, " << fast.differing << " differing, max "
+       << fast.max_ulps << " ULPs: reference " << bytes / slow.median * 1e-9
+       << " GB/s, vectorised " << bytes / quick.median * 1e-9
+       << " GB/s, speedup " << slow.median / quick.median << "x" << endl;
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,376 @@
+#include "compare.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace compare {
+
+namespace {
+
+constexpr int64_t kMagnitude = 0x7fffffffffffffff;
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// The bits of x as an integer ordered like the doubles, with -0 at 0.
+int64_t Key(double x) {
+  int64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits < 0 ? -(bits & kMagnitude) : bits;
+}
+
+// The element with the most ULPs seen so far; the first of equals.
+struct Tracker {
+  uint64_t ulps = 0;
+  size_t index = 0;
+
+  void Offer(uint64_t u, size_t i) {
+    if (u > ulps || (u == ulps && u > 0 && i < index)) {
+      ulps = u;
+      index = i;
+    }
+  }
+};
+
+// Stats of a range of the arrays, before the worst element is picked.
+struct Partial {
+  Stats stats;
+  Tracker all;
+  Tracker beyond;
+
+  void Add(const Partial& other) {
+    stats.count += other.stats.count;
+    stats.differing += other.stats.differing;
+    stats.beyond_absolute += other.stats.beyond_absolute;
+    stats.beyond += other.stats.beyond;
+    stats.nan_mismatches += other.stats.nan_mismatches;
+    stats.inf_mismatches += other.stats.inf_mismatches;
+    stats.max_absolute = std::max(stats.max_absolute, other.stats.max_absolute);
+    stats.max_relative = std::max(stats.max_relative, other.stats.max_relative);
+    all.Offer(other.all.ulps, other.all.index);
+    beyond.Offer(other.beyond.ulps, other.beyond.index);
+  }
+
+  Stats Finish(const double* expected, const double* actual) const {
+    Stats s = stats;
+    s.max_ulps = all.ulps;
+    const Tracker& worst = s.beyond > 0 ? beyond : all;
+    s.worst = worst.index;
+    s.worst_ulps = worst.ulps;
+    if (s.count > 0) {
+      s.worst_expected = expected[s.worst];
+      s.worst_actual = actual[s.worst];
+    }
+    return s;
+  }
+};
+
+void Elements(const double* expected, const double* actual, size_t begin,
+              size_t end, const Tolerance& tolerance, Partial* p) {
+  p->stats.count += end - begin;
+  for (size_t i = begin; i < end; ++i) {
+    const double e = expected[i];
+    const double a = actual[i];
+    const uint64_t ulps = Ulps(e, a);
+    if (ulps == 0) continue;
+    ++p->stats.differing;
+    const bool nan = std::isnan(e) != std::isnan(a);
+    const bool inf = !nan && (std::isinf(e) || std::isinf(a));
+    p->stats.nan_mismatches += nan;
+    p->stats.inf_mismatches += inf;
+    const bool within_absolute = !nan && !inf &&
+                                 std::fabs(e - a) <= tolerance.absolute;
+    const bool within = within_absolute ||
+                        (!nan && !inf && ulps <= tolerance.ulps);
+    p->stats.beyond_absolute += !within_absolute;
+    p->stats.beyond += !within;
+    if (!nan) {
+      const double absolute = std::fabs(e - a);
+      const double relative = inf ? kInf : absolute / std::fabs(e);
+      p->stats.max_absolute = std::max(p->stats.max_absolute, absolute);
+      p->stats.max_relative = std::max(p->stats.max_relative, relative);
+    }
+    p->all.Offer(ulps, i);
+    if (!within) p->beyond.Offer(ulps, i);
+  }
+}
+
+// Lane by lane the same steps as Elements. Lanes keep the first of equal ULPs
+// and Offer prefers the lower index across lanes, so the worst element is the
+// one Elements finds.
+__attribute__((target("avx512f,avx512dq"))) size_t BlocksAvx512(
+    const double* expected, const double* actual, size_t count,
+    const Tolerance& tolerance, Partial* p) {
+  const size_t blocks = count / 8 * 8;
+  const __m512i magnitude = _mm512_set1_epi64(kMagnitude);
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i max_ulps = _mm512_set1_epi64(-1);
+  const __m512i tol_ulps = _mm512_set1_epi64(tolerance.ulps);
+  const __m512d tol_absolute = _mm512_set1_pd(tolerance.absolute);
+  const __m512d inf = _mm512_set1_pd(kInf);
+  __m512i index = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+  const __m512i step = _mm512_set1_epi64(8);
+  __m512i all_ulps = zero, all_index = zero;
+  __m512i beyond_ulps = zero, beyond_index = zero;
+  __m512d max_absolute = _mm512_setzero_pd();
+  __m512d max_relative = _mm512_setzero_pd();
+  for (size_t i = 0; i < blocks;
+       i += 8, index = _mm512_add_epi64(index, step)) {
+    const __m512d e = _mm512_loadu_pd(expected + i);
+    const __m512d a = _mm512_loadu_pd(actual + i);
+    const __m512i be = _mm512_castpd_si512(e);
+    const __m512i ba = _mm512_castpd_si512(a);
+    const __m512i me = _mm512_and_si512(be, magnitude);
+    const __m512i ma = _mm512_and_si512(ba, magnitude);
+    const __m512i ke = _mm512_mask_sub_epi64(me, _mm512_movepi64_mask(be),
+                                             zero, me);
+    const __m512i ka = _mm512_mask_sub_epi64(ma, _mm512_movepi64_mask(ba),
+                                             zero, ma);
+    const __mmask8 nan_e = _mm512_cmp_pd_mask(e, e, _CMP_UNORD_Q);
+    const __mmask8 nan_a = _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q);
+    const __m512d abs_e = _mm512_abs_pd(e);
+    const __mmask8 inf_any = _mm512_cmp_pd_mask(abs_e, inf, _CMP_EQ_OQ) |
+                             _mm512_cmp_pd_mask(_mm512_abs_pd(a), inf,
+                                                _CMP_EQ_OQ);
+    const __mmask8 nan = nan_e ^ nan_a;
+    const __mmask8 inf_mismatch =
+        inf_any & ~_mm512_cmp_pd_mask(e, a, _CMP_EQ_OQ) & ~nan;
+    const __mmask8 special = nan | inf_mismatch;
+
+    __m512i ulps = _mm512_mask_sub_epi64(_mm512_sub_epi64(ke, ka),
+                                         _mm512_cmpgt_epi64_mask(ka, ke), ka,
+                                         ke);
+    ulps = _mm512_mask_mov_epi64(ulps, special, max_ulps);
+    ulps = _mm512_maskz_mov_epi64(~(nan_e & nan_a), ulps);
+    const __mmask8 identical = _mm512_cmpeq_epi64_mask(ulps, zero);
+    if (identical == 0xff) continue;
+
+    const __m512d absolute = _mm512_abs_pd(_mm512_sub_pd(e, a));
+    __m512d relative = _mm512_div_pd(absolute, abs_e);
+    relative = _mm512_mask_mov_pd(relative, inf_mismatch, inf);
+    const __mmask8 within_absolute =
+        (_mm512_cmp_pd_mask(absolute, tol_absolute, _CMP_LE_OQ) | identical) &
+        ~special;
+    const __mmask8 within =
+        within_absolute |
+        (_mm512_cmple_epu64_mask(ulps, tol_ulps) & ~special);
+    const __mmask8 differing = ~identical;
+    p->stats.differing += __builtin_popcount(differing);
+    p->stats.beyond_absolute +=
+        __builtin_popcount(static_cast<__mmask8>(~within_absolute));
+    p->stats.beyond += __builtin_popcount(static_cast<__mmask8>(~within));
+    p->stats.nan_mismatches += __builtin_popcount(nan);
+    p->stats.inf_mismatches += __builtin_popcount(inf_mismatch);
+    const __mmask8 measured = differing & ~nan;
+    max_absolute =
+        _mm512_mask_max_pd(max_absolute, measured, absolute, max_absolute);
+    max_relative =
+        _mm512_mask_max_pd(max_relative, measured, relative, max_relative);
+
+    const __mmask8 more = _mm512_cmpgt_epu64_mask(ulps, all_ulps);
+    all_ulps = _mm512_mask_mov_epi64(all_ulps, more, ulps);
+    all_index = _mm512_mask_mov_epi64(all_index, more, index);
+    const __mmask8 more_beyond =
+        _mm512_mask_cmpgt_epu64_mask(~within, ulps, beyond_ulps);
+    beyond_ulps = _mm512_mask_mov_epi64(beyond_ulps, more_beyond, ulps);
+    beyond_index = _mm512_mask_mov_epi64(beyond_index, more_beyond, index);
+  }
+  p->stats.count += blocks;
+  alignas(64) uint64_t lanes[4][8];
+  alignas(64) double maxima[2][8];
+  _mm512_store_si512(lanes[0], all_ulps);
+  _mm512_store_si512(lanes[1], all_index);
+  _mm512_store_si512(lanes[2], beyond_ulps);
+  _mm512_store_si512(lanes[3], beyond_index);
+  _mm512_store_pd(maxima[0], max_absolute);
+  _mm512_store_pd(maxima[1], max_relative);
+  for (int l = 0; l < 8; ++l) {
+    p->all.Offer(lanes[0][l], lanes[1][l]);
+    p->beyond.Offer(lanes[2][l], lanes[3][l]);
+    p->stats.max_absolute = std::max(p->stats.max_absolute, maxima[0][l]);
+    p->stats.max_relative = std::max(p->stats.max_relative, maxima[1][l]);
+  }
+  return blocks;
+}
+
+// The lanes of an AVX2 mask that are set.
+__attribute__((target("avx2"))) int CountLanes(__m256i mask) {
+  return __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+}
+
+// AVX2 has no unsigned or masked 64-bit comparisons; lanes of all ones stand
+// for the masks and unsigned order is signed order with the sign bit flipped.
+__attribute__((target("avx2"))) size_t BlocksAvx2(const double* expected,
+                                                  const double* actual,
+                                                  size_t count,
+                                                  const Tolerance& tolerance,
+                                                  Partial* p) {
+  const size_t blocks = count / 4 * 4;
+  const __m256i magnitude = _mm256_set1_epi64x(kMagnitude);
+  const __m256i sign = _mm256_set1_epi64x(~kMagnitude);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi64x(-1);
+  const __m256i tol_ulps =
+      _mm256_xor_si256(_mm256_set1_epi64x(tolerance.ulps), sign);
+  const __m256d tol_absolute = _mm256_set1_pd(tolerance.absolute);
+  const __m256d inf = _mm256_set1_pd(kInf);
+  const __m256d abs_mask = _mm256_castsi256_pd(magnitude);
+  __m256i index = _mm256_set_epi64x(3, 2, 1, 0);
+  const __m256i step = _mm256_set1_epi64x(4);
+  // Best ULPs with the sign bit flipped, from the least unsigned value.
+  __m256i all_ulps = sign, all_index = zero;
+  __m256i beyond_ulps = sign, beyond_index = zero;
+  __m256d max_absolute = _mm256_setzero_pd();
+  __m256d max_relative = _mm256_setzero_pd();
+  for (size_t i = 0; i < blocks;
+       i += 4, index = _mm256_add_epi64(index, step)) {
+    const __m256d e = _mm256_loadu_pd(expected + i);
+    const __m256d a = _mm256_loadu_pd(actual + i);
+    const __m256i be = _mm256_castpd_si256(e);
+    const __m256i ba = _mm256_castpd_si256(a);
+    const __m256i me = _mm256_and_si256(be, magnitude);
+    const __m256i ma = _mm256_and_si256(ba, magnitude);
+    const __m256i ke = _mm256_blendv_epi8(me, _mm256_sub_epi64(zero, me),
+                                          _mm256_cmpgt_epi64(zero, be));
+    const __m256i ka = _mm256_blendv_epi8(ma, _mm256_sub_epi64(zero, ma),
+                                          _mm256_cmpgt_epi64(zero, ba));
+    const __m256i nan_e =
+        _mm256_castpd_si256(_mm256_cmp_pd(e, e, _CMP_UNORD_Q));
+    const __m256i nan_a =
+        _mm256_castpd_si256(_mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+    const __m256d abs_e = _mm256_and_pd(e, abs_mask);
+    const __m256i inf_any = _mm256_castpd_si256(_mm256_or_pd(
+        _mm256_cmp_pd(abs_e, inf, _CMP_EQ_OQ),
+        _mm256_cmp_pd(_mm256_and_pd(a, abs_mask), inf, _CMP_EQ_OQ)));
+    const __m256i nan = _mm256_xor_si256(nan_e, nan_a);
+    const __m256i inf_mismatch = _mm256_andnot_si256(
+        nan, _mm256_andnot_si256(
+                 _mm256_castpd_si256(_mm256_cmp_pd(e, a, _CMP_EQ_OQ)),
+                 inf_any));
+    const __m256i special = _mm256_or_si256(nan, inf_mismatch);
+
+    __m256i ulps = _mm256_blendv_epi8(_mm256_sub_epi64(ke, ka),
+                                      _mm256_sub_epi64(ka, ke),
+                                      _mm256_cmpgt_epi64(ka, ke));
+    ulps = _mm256_or_si256(ulps, special);
+    ulps = _mm256_andnot_si256(_mm256_and_si256(nan_e, nan_a), ulps);
+    const __m256i identical = _mm256_cmpeq_epi64(ulps, zero);
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(identical)) == 0xf) continue;
+
+    const __m256d absolute = _mm256_and_pd(_mm256_sub_pd(e, a), abs_mask);
+    __m256d relative = _mm256_div_pd(absolute, abs_e);
+    relative = _mm256_blendv_pd(relative, inf,
+                                _mm256_castsi256_pd(inf_mismatch));
+    const __m256i within_absolute = _mm256_andnot_si256(
+        special,
+        _mm256_or_si256(_mm256_castpd_si256(_mm256_cmp_pd(
+                            absolute, tol_absolute, _CMP_LE_OQ)),
+                        identical));
+    const __m256i flipped = _mm256_xor_si256(ulps, sign);
+    const __m256i within_ulps = _mm256_andnot_si256(
+        _mm256_cmpgt_epi64(flipped, tol_ulps), ones);
+    const __m256i within = _mm256_or_si256(
+        within_absolute, _mm256_andnot_si256(special, within_ulps));
+    const __m256i differing = _mm256_xor_si256(identical, ones);
+    p->stats.differing += CountLanes(differing);
+    p->stats.beyond_absolute += 4 - CountLanes(within_absolute);
+    p->stats.beyond += 4 - CountLanes(within);
+    p->stats.nan_mismatches += CountLanes(nan);
+    p->stats.inf_mismatches += CountLanes(inf_mismatch);
+    const __m256d measured =
+        _mm256_castsi256_pd(_mm256_andnot_si256(nan, differing));
+    max_absolute = _mm256_blendv_pd(
+        max_absolute, _mm256_max_pd(absolute, max_absolute), measured);
+    max_relative = _mm256_blendv_pd(
+        max_relative, _mm256_max_pd(relative, max_relative), measured);
+
+    const __m256i more = _mm256_cmpgt_epi64(flipped, all_ulps);
+    all_ulps = _mm256_blendv_epi8(all_ulps, flipped, more);
+    all_index = _mm256_blendv_epi8(all_index, index, more);
+    const __m256i more_beyond = _mm256_andnot_si256(
+        within, _mm256_cmpgt_epi64(flipped, beyond_ulps));
+    beyond_ulps = _mm256_blendv_epi8(beyond_ulps, flipped, more_beyond);
+    beyond_index = _mm256_blendv_epi8(beyond_index, index, more_beyond);
+  }
+  p->stats.count += blocks;
+  alignas(32) uint64_t lanes[4][4];
+  alignas(32) double maxima[2][4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]),
+                     _mm256_xor_si256(all_ulps, sign));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), all_index);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]),
+                     _mm256_xor_si256(beyond_ulps, sign));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), beyond_index);
+  _mm256_store_pd(maxima[0], max_absolute);
+  _mm256_store_pd(maxima[1], max_relative);
+  for (int l = 0; l < 4; ++l) {
+    p->all.Offer(lanes[0][l], lanes[1][l]);
+    p->beyond.Offer(lanes[2][l], lanes[3][l]);
+    p->stats.max_absolute = std::max(p->stats.max_absolute, maxima[0][l]);
+    p->stats.max_relative = std::max(p->stats.max_relative, maxima[1][l]);
+  }
+  return blocks;
+}
+
+using Blocks = size_t (*)(const double* expected, const double* actual,
+                          size_t count, const Tolerance& tolerance,
+                          Partial* p);
+
+Blocks Selected() {
+  static const Blocks blocks =
+      __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+          ? BlocksAvx512
+      : __builtin_cpu_supports("avx2") ? BlocksAvx2
+                                       : nullptr;
+  return blocks;
+}
+
+}  // namespace
+
+uint64_t Ulps(double expected, double actual) {
+  const bool nan_e = std::isnan(expected);
+  const bool nan_a = std::isnan(actual);
+  if (nan_e || nan_a) return nan_e && nan_a ? 0 : kMaxUlps;
+  if (expected == actual) return 0;
+  if (std::isinf(expected) || std::isinf(actual)) return kMaxUlps;
+  const int64_t ke = Key(expected);
+  const int64_t ka = Key(actual);
+  // In unsigned arithmetic, so that opposite extremes do not overflow.
+  return ke > ka ? static_cast<uint64_t>(ke) - static_cast<uint64_t>(ka)
+                 : static_cast<uint64_t>(ka) - static_cast<uint64_t>(ke);
+}
+
+Stats CompareReference(const double* expected, const double* actual,
+                       size_t count, const Tolerance& tolerance) {
+  Partial p;
+  Elements(expected, actual, 0, count, tolerance, &p);
+  return p.Finish(expected, actual);
+}
+
+Stats Compare(const double* expected, const double* actual, size_t count,
+              const Tolerance& tolerance) {
+  Partial p;
+  size_t done = 0;
+  if (const Blocks blocks = Selected()) {
+    done = blocks(expected, actual, count, tolerance, &p);
+  }
+  Partial tail;
+  Elements(expected, actual, done, count, tolerance, &tail);
+  p.Add(tail);
+  return p.Finish(expected, actual);
+}
+
+std::string Coordinates(size_t index, const std::vector<int>& shape) {
+  std::vector<size_t> subscripts(shape.size());
+  for (size_t d = shape.size(); d-- > 0;) {
+    subscripts[d] = index % shape[d];
+    index /= shape[d];
+  }
+  std::string text;
+  for (size_t s : subscripts) text += "[" + std::to_string(s) + "]";
+  return text;
+}
+
+}  // namespace compare
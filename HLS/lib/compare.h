@@ -0,0 +1,66 @@
+#ifndef COMPARE_H_
+#define COMPARE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Comparison of a double array computed by a transformed kernel with the one
+// of the original, in units in the last place as well as absolute and relative
+// error, so that the rounding differences of reassociated sums can be told
+// from wrong results, and the worst element be pointed at.
+namespace compare {
+
+// The distance of a NaN on one side only, or of unequal infinities.
+constexpr uint64_t kMaxUlps = ~uint64_t{0};
+
+// How far an element may be from the original's: within `absolute`, as the
+// test_<kernel>.c harnesses allow, or else within `ulps` units in the last
+// place.
+struct Tolerance {
+  double absolute = 1e-6;
+  uint64_t ulps = 0;
+};
+
+// Elements are identical when their bits match, when both are NaN, or when
+// they are zeros of either sign. A NaN on one side only and unequal infinities
+// are never within tolerance.
+struct Stats {
+  size_t count = 0;
+  size_t differing = 0;          // not identical
+  size_t beyond_absolute = 0;    // differing by more than tolerance.absolute
+  size_t beyond = 0;             // beyond both tolerance.absolute and .ulps
+  size_t nan_mismatches = 0;     // NaN on one side only
+  size_t inf_mismatches = 0;     // an infinity on one side, not both the same
+  uint64_t max_ulps = 0;
+  double max_absolute = 0.0;     // over the elements that are not NaN
+  double max_relative = 0.0;     // of the original's value; inf if that is 0
+  // The element beyond tolerance with the most ULPs or, when there is none,
+  // the element with the most ULPs; the first of equals.
+  size_t worst = 0;
+  uint64_t worst_ulps = 0;
+  double worst_expected = 0.0;
+  double worst_actual = 0.0;
+};
+
+// The distance between two doubles in ULPs: how many steps apart they are
+// along the ordered doubles, with both zeros as one. 0 for identical elements
+// and kMaxUlps for the mismatches above.
+uint64_t Ulps(double expected, double actual);
+
+// Element by element.
+Stats CompareReference(const double* expected, const double* actual,
+                       size_t count, const Tolerance& tolerance);
+
+// Four or eight elements at a time with AVX2 or AVX-512, where the CPU has
+// them; the same Stats as CompareReference.
+Stats Compare(const double* expected, const double* actual, size_t count,
+              const Tolerance& tolerance);
+
+// An index of an array of the given shape as subscripts, e.g. "[3][14]".
+std::string Coordinates(size_t index, const std::vector<int>& shape);
+
+}  // namespace compare
+
+#endif
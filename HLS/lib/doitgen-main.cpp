@@ -0,0 +1,140 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "doitgen.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using check::Arrays;
+
+namespace {
+
+// The GEMM reassociates and contracts the sums.
+const double kTolerance = 1e-9;
+
+struct Shape {
+  int nr, nq, np;
+};
+
+// The sizes of A, C4 and sum.
+vector<size_t> Sizes(const Shape& s) {
+  return {static_cast<size_t>(s.nr) * s.nq * s.np,
+          static_cast<size_t>(s.np) * s.np, static_cast<size_t>(s.np)};
+}
+
+int CheckPacked(const string& name, const Shape& s, Arrays v,
+                const Arrays& expected) {
+  check::Call<3>(doitgen::Packed, v, s.nr, s.nq, s.np);
+  const double e = check::Error(v, expected);
+  if (!(e <= kTolerance)) {
+    clog << name << ": packed GEMM differs, error " << e << endl;
+    return 1;
+  }
+  return 0;
+}
+
+string Name(const Shape& s) {
+  return std::to_string(s.nr) + " x " + std::to_string(s.nq) + " x " +
+         std::to_string(s.np);
+}
+
+}  // namespace
+
+// Checks the packed-GEMM doitgen against kernel_doitgen, doitgen-red and
+// the reference loops, then times both on larger arrays:
+//   doitgen [nr nq np]...
+int main(int argc, char** argv) {
+  vector<Shape> sizes;
+  for (int i = 1; i + 2 < argc; i += 3) {
+    sizes.push_back(
+        {std::atoi(argv[i]), std::atoi(argv[i + 1]), std::atoi(argv[i + 2])});
+  }
+  for (const Shape& s : sizes) {
+    if (s.nr < 1 || s.nq < 1 || s.np < 1) argc = 0;
+  }
+  if (argc % 3 != 1) {
+    clog << "Usage: " << argv[0] << " [nr nq np]...\n";
+    return EXIT_FAILURE;
+  }
+  if (sizes.empty()) sizes = {{25, 20, 30}, {128, 128, 128}, {64, 64, 512}};
+
+  int error = 0;
+  for (const string name : {"doitgen", "doitgen-red"}) {
+    const kernels::Kernel& kernel = *kernels::FindKernel(name);
+    for (int seed = 1; seed <= 3; ++seed) {
+      kernels::Args args = kernels::MakeArgs(kernel, seed);
+      const int first = args.Size() - 3;
+      const vector<int>& shape = args.Spec(first).shape;
+      const Shape s{shape[0], shape[1], shape[2]};
+      Arrays v;
+      for (int i = first; i < args.Size(); ++i) {
+        const double* data = args.Ptr<double*>(i);
+        v.emplace_back(data, data + args.Count(i));
+      }
+      Arrays reference = v;
+      check::Call<3>(doitgen::Reference, reference, s.nr, s.nq, s.np);
+      kernel.run(args);
+      Arrays expected;
+      for (int i = first; i < args.Size(); ++i) {
+        const double* data = args.Ptr<double*>(i);
+        expected.emplace_back(data, data + args.Count(i));
+      }
+      const string label = name + " seed " + std::to_string(seed);
+      if (!check::Same(reference, expected)) {
+        clog << label << ": reference differs from kernel_doitgen" << endl;
+        ++error;
+      }
+      error += CheckPacked(label, s, v, expected);
+    }
+  }
+
+  kernels::Rng rng(42);
+  for (const Shape& s : {Shape{1, 1, 1}, {1, 3, 7}, {3, 5, 2}, {7, 37, 9},
+                         {2, 100, 65}, {9, 30, 300}}) {
+    Arrays v = check::Random(Sizes(s), rng);
+    Arrays expected = v;
+    check::Call<3>(doitgen::Reference, expected, s.nr, s.nq, s.np);
+    error += CheckPacked(Name(s), s, v, expected);
+  }
+
+  for (const Shape& s : sizes) {
+    const Arrays input = check::Random(Sizes(s), rng);
+    Arrays reference_result, v;
+    bench::Timing reference = bench::Measure(
+        0, 3, [&] { reference_result = input; },
+        [&] {
+          check::Call<3>(doitgen::Reference, reference_result, s.nr, s.nq,
+                         s.np);
+        });
+    bench::Timing packed = bench::Measure(
+        1, 5, [&] { v = input; },
+        [&] { check::Call<3>(doitgen::Packed, v, s.nr, s.nq, s.np); });
+    const double e = check::Error(v, reference_result);
+    if (!(e <= kTolerance)) {
+      clog << Name(s) << ": packed GEMM differs, error " << e << endl;
+      ++error;
+    }
+    const double flops = 2.0 * s.nr * s.nq * s.np * s.np;
+    cout << Name(s) << ": reference " << flops / reference.median * 1e-9
+         << " GFLOP/s, packed GEMM " << flops / packed.median * 1e-9
+         << " GFLOP/s, speedup " << reference.median / packed.median << "x"
+         << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#include "doitgen.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gemm.h"
+
+namespace doitgen {
+
+namespace {
+
+using gemm::Trans;
+
+// Rows of A per band.
+const int kBand = 128;
+
+}  // namespace
+
+void Reference(int nr, int nq, int np, double* a, const double* c4,
+               double* sum) {
+  for (int r = 0; r < nr; r++) {
+    for (int q = 0; q < nq; q++) {
+      double* row = a + (static_cast<long>(r) * nq + q) * np;
+      for (int p = 0; p < np; p++) {
+        sum[p] = 0.0;
+        for (int s = 0; s < np; s++) sum[p] += row[s] * c4[s * np + p];
+      }
+      for (int p = 0; p < np; p++) row[p] = sum[p];
+    }
+  }
+}
+
+void Packed(int nr, int nq, int np, double* a, const double* c4,
+            double* sum) {
+  const int rows = nr * nq;
+  if (rows <= 0 || np <= 0) return;
+  const int bands = (rows + kBand - 1) / kBand;
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < bands; ++b) {
+    thread_local std::vector<double> copy;
+    const int i0 = b * kBand;
+    const int height = std::min(kBand, rows - i0);
+    double* band = a + static_cast<long>(i0) * np;
+    copy.assign(band, band + static_cast<long>(height) * np);
+    gemm::Dgemm(Trans::kNo, Trans::kNo, height, np, np, 1.0, copy.data(), np,
+                c4, np, 0.0, band, np);
+  }
+  const double* last = a + static_cast<long>(rows - 1) * np;
+  std::copy(last, last + np, sum);
+}
+
+}  // namespace doitgen
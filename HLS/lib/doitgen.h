@@ -0,0 +1,26 @@
+#ifndef DOITGEN_H_
+#define DOITGEN_H_
+
+// The multiresolution analysis kernel of data/sources/doitgen_kernel.c (and
+// doitgen-red) for any nr x nq x np array A and np x np matrix C4, both
+// row-major. Each A[r][q] is replaced by A[r][q] * C4; sum is left holding
+// the last of those products, as in kernel_doitgen.
+namespace doitgen {
+
+// The loop nest of kernel_doitgen: one vector-matrix product per (r, q),
+// through sum.
+void Reference(int nr, int nq, int np, double* a, const double* c4,
+               double* sum);
+
+// A as an (nr * nq) x np matrix times C4 on the packed GEMM engine. Bands of
+// rows are copied aside and their product written back over them, so A is
+// updated in place with one band of scratch per thread, and the bands are
+// spread over the OpenMP threads. The GEMM reassociates and contracts the
+// sums, so results agree with the kernel to rounding rather than bit for
+// bit.
+void Packed(int nr, int nq, int np, double* a, const double* c4,
+            double* sum);
+
+}  // namespace doitgen
+
+#endif
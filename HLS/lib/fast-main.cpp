@@ -0,0 +1,116 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "fast.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using kernels::Args;
+using kernels::Kernel;
+using kernels::Type;
+
+namespace {
+
+// Reassociated sums differ from the originals in the last bits only.
+const double kTolerance = 1e-9;
+
+// Largest difference between two runs over all array arguments, relative to
+// the magnitude of the reference value (absolute below 1). Non-double arrays
+// must match exactly; a mismatch there or in NaN-ness counts as infinity.
+double MaxError(const Args& ref, const Args& out) {
+  double error = 0.0;
+  for (int i = 0; i < ref.Size(); ++i) {
+    if (ref.Spec(i).shape.empty()) continue;
+    if (ref.Spec(i).type != Type::kDouble) {
+      if (std::memcmp(ref.Data(i), out.Data(i), ref.Bytes(i)) != 0) {
+        return INFINITY;
+      }
+      continue;
+    }
+    const double* r = static_cast<const double*>(ref.Data(i));
+    const double* o = static_cast<const double*>(out.Data(i));
+    for (size_t j = 0; j < ref.Count(i); ++j) {
+      if (std::isnan(r[j]) || std::isnan(o[j])) {
+        if (std::isnan(r[j]) != std::isnan(o[j])) return INFINITY;
+        continue;
+      }
+      double diff = std::fabs(r[j] - o[j]) / std::fmax(1.0, std::fabs(r[j]));
+      if (!(diff <= error)) error = diff;
+    }
+  }
+  return error;
+}
+
+}  // namespace
+
+// Checks every fast variant (or the named ones) against its original kernel on
+// several seeds and times both.
+int main(int argc, char** argv) {
+  int reps = 20;
+  vector<const fast::Variant*> selected;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+      reps = atoi(argv[++i]);
+    } else if (const fast::Variant* variant = fast::FindVariant(argv[i])) {
+      selected.push_back(variant);
+    } else {
+      clog << "Usage: " << argv[0] << " [-r reps] [kernel...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (reps < 1) reps = 1;
+  if (selected.empty()) {
+    for (const fast::Variant& variant : fast::Variants()) {
+      selected.push_back(&variant);
+    }
+  }
+
+  int error = 0;
+  for (const fast::Variant* variant : selected) {
+    const Kernel& kernel = *kernels::FindKernel(variant->name);
+    double max_error = 0.0;
+    for (unsigned seed = 1; seed <= 3; ++seed) {
+      Args ref = kernels::MakeArgs(kernel, seed);
+      Args out = ref;
+      kernel.run(ref);
+      variant->run(out);
+      max_error = std::fmax(max_error, MaxError(ref, out));
+    }
+    bool ok = variant->exact ? max_error == 0.0 : max_error <= kTolerance;
+    if (!ok) {
+      clog << "Variant " << variant->name << " differs from the original by "
+           << max_error << endl;
+      ++error;
+    }
+
+    const Args input = kernels::MakeArgs(kernel);
+    Args args = input;
+    bench::Timing original = bench::Measure(
+        1, reps, [&] { args = input; }, [&] { kernel.run(args); });
+    bench::Timing fast = bench::Measure(
+        1, reps, [&] { args = input; }, [&] { variant->run(args); });
+    cout << std::left << std::setw(16) << variant->name << std::setw(10)
+         << variant->engine << std::right << std::scientific
+         << std::setprecision(3) << " original " << original.median
+         << " s  fast " << fast.median << " s  error " << max_error
+         << std::fixed << std::setprecision(1) << "  speedup "
+         << original.median / fast.median << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
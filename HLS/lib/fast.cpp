@@ -0,0 +1,288 @@
+#include "fast.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "adi.h"
+#include "aes.h"
+#include "doitgen.h"
+#include "gemm.h"
+#include "gemver.h"
+#include "matvec.h"
+#include "md.h"
+#include "nw.h"
+#include "seidel.h"
+#include "stats.h"
+#include "stencil.h"
+
+namespace fast {
+
+namespace {
+
+using kernels::Args;
+using gemm::Trans;
+
+// Arguments are looked up by their name in the kernel signature.
+int Index(const Args& args, const std::string& name) {
+  for (int i = 0; i < args.Size(); ++i) {
+    if (args.Spec(i).name == name) return i;
+  }
+  throw std::invalid_argument("no argument named " + name);
+}
+
+template <typename T = double>
+T* Array(Args& args, const std::string& name) {
+  return args.Ptr<T*>(Index(args, name));
+}
+
+double Scalar(Args& args, const std::string& name) {
+  return args.Value<double>(Index(args, name));
+}
+
+// Extent of dimension d of an array argument.
+int Dim(const Args& args, const std::string& name, int d) {
+  return args.Spec(Index(args, name)).shape[d];
+}
+
+// The leading dimension of a row-major array argument.
+int Ld(const Args& args, const std::string& name) {
+  return args.Spec(Index(args, name)).shape.back();
+}
+
+void Gemm(Args& args, const std::string& a, const std::string& b,
+          const std::string& c, double alpha, double beta) {
+  const std::vector<int>& shape = args.Spec(Index(args, c)).shape;
+  int m = shape[0];
+  int n = shape[1];
+  int k = Ld(args, a);
+  gemm::Dgemm(Trans::kNo, Trans::kNo, m, n, k, alpha, Array(args, a),
+              Ld(args, a), Array(args, b), Ld(args, b), beta, Array(args, c),
+              Ld(args, c));
+}
+
+// ---- adi engine ----
+
+// kernel_adi runs 40 steps on 60 x 60 grids whatever tsteps and n say.
+void Adi(Args& args) {
+  adi::Solve(40, Ld(args, "u"), Array(args, "u"), Array(args, "v"),
+             Array(args, "p"), Array(args, "q"));
+}
+
+// ---- aes engine ----
+
+// ctx is {key, enckey, deckey}: the key itself in enckey, the last 32 bytes
+// of the schedule in the other two.
+void Aes(Args& args) {
+  uint8_t* ctx = Array<uint8_t>(args, "ctx");
+  const uint8_t* k = Array<uint8_t>(args, "k");
+  uint8_t* buf = Array<uint8_t>(args, "buf");
+  const aes::Schedule schedule = aes::ExpandKey(k);
+  aes::EncryptEcb(schedule, 1, buf, buf);
+  const uint8_t* last = schedule.bytes + 7 * aes::kKeyBytes;
+  std::memcpy(ctx, last, aes::kKeyBytes);
+  std::memcpy(ctx + aes::kKeyBytes, k, aes::kKeyBytes);
+  std::memcpy(ctx + 2 * aes::kKeyBytes, last, aes::kKeyBytes);
+}
+
+// ---- doitgen engine ----
+
+void Doitgen(Args& args) {
+  doitgen::Packed(Dim(args, "A", 0), Dim(args, "A", 1), Dim(args, "A", 2),
+                  Array(args, "A"), Array(args, "C4"), Array(args, "sum"));
+}
+
+// ---- gemm engine ----
+
+// prod := m1 * m2 over 64 x 64 matrices stored flat.
+void GemmNcubed(Args& args) {
+  gemm::Dgemm(Trans::kNo, Trans::kNo, 64, 64, 64, 1.0, Array(args, "m1"), 64,
+              Array(args, "m2"), 64, 0.0, Array(args, "prod"), 64);
+}
+
+// bbgemm accumulates into prod.
+void GemmBlocked(Args& args) {
+  gemm::Dgemm(Trans::kNo, Trans::kNo, 64, 64, 64, 1.0, Array(args, "m1"), 64,
+              Array(args, "m2"), 64, 1.0, Array(args, "prod"), 64);
+}
+
+void Mm2(Args& args) {
+  Gemm(args, "A", "B", "tmp", Scalar(args, "alpha"), 0.0);
+  Gemm(args, "tmp", "C", "D", 1.0, Scalar(args, "beta"));
+}
+
+void Mm3(Args& args) {
+  Gemm(args, "A", "B", "E", 1.0, 0.0);
+  Gemm(args, "C", "D", "F", 1.0, 0.0);
+  Gemm(args, "E", "F", "G", 1.0, 0.0);
+}
+
+void Syrk(Args& args) {
+  gemm::Dsyrk(Ld(args, "C"), Ld(args, "A"), Scalar(args, "alpha"),
+              Array(args, "A"), Ld(args, "A"), Scalar(args, "beta"),
+              Array(args, "C"), Ld(args, "C"));
+}
+
+void Syr2k(Args& args) {
+  gemm::Dsyr2k(Ld(args, "C"), Ld(args, "A"), Scalar(args, "alpha"),
+               Array(args, "A"), Ld(args, "A"), Array(args, "B"),
+               Ld(args, "B"), Scalar(args, "beta"), Array(args, "C"),
+               Ld(args, "C"));
+}
+
+void Symm(Args& args) {
+  gemm::Dsymm(Dim(args, "C", 0), Ld(args, "C"), Scalar(args, "alpha"),
+              Array(args, "A"), Ld(args, "A"), Array(args, "B"), Ld(args, "B"),
+              Scalar(args, "beta"), Array(args, "C"), Ld(args, "C"));
+}
+
+void Trmm(Args& args) {
+  gemm::Dtrmm(Dim(args, "B", 0), Ld(args, "B"), Scalar(args, "alpha"),
+              Array(args, "A"), Ld(args, "A"), Array(args, "B"),
+              Ld(args, "B"));
+}
+
+// ---- gemver engine ----
+
+void Gemver(Args& args) {
+  gemver::Fused(Ld(args, "A"), Scalar(args, "alpha"), Scalar(args, "beta"),
+                Array(args, "A"), Array(args, "u1"), Array(args, "v1"),
+                Array(args, "u2"), Array(args, "v2"), Array(args, "w"),
+                Array(args, "x"), Array(args, "y"), Array(args, "z"));
+}
+
+// ---- matvec engine ----
+
+void Atax(Args& args) {
+  matvec::Atax(Dim(args, "A", 0), Ld(args, "A"), Array(args, "A"),
+               Array(args, "x"), Array(args, "y"), Array(args, "tmp"));
+}
+
+void Bicg(Args& args) {
+  matvec::Bicg(Dim(args, "A", 0), Ld(args, "A"), Array(args, "A"),
+               Array(args, "s"), Array(args, "q"), Array(args, "p"),
+               Array(args, "r"));
+}
+
+void Gesummv(Args& args) {
+  matvec::Gesummv(Ld(args, "A"), Scalar(args, "alpha"), Scalar(args, "beta"),
+                  Array(args, "A"), Array(args, "B"), Array(args, "tmp"),
+                  Array(args, "x"), Array(args, "y"));
+}
+
+void Mvt(Args& args) {
+  matvec::Mvt(Ld(args, "A"), Array(args, "x1"), Array(args, "x2"),
+              Array(args, "y_1"), Array(args, "y_2"), Array(args, "A"));
+}
+
+// ---- md engine ----
+
+void Md(Args& args) {
+  const int atoms = Dim(args, "force_x", 0);
+  md::Forces(atoms, Dim(args, "NL", 0) / atoms, Array<int>(args, "NL"),
+             Array(args, "position_x"), Array(args, "position_y"),
+             Array(args, "position_z"), Array(args, "force_x"),
+             Array(args, "force_y"), Array(args, "force_z"));
+}
+
+// ---- nw engine ----
+
+// needwun leaves alignedA and alignedB untouched, so only the matrices are
+// filled.
+void Nw(Args& args) {
+  nw::Fill(Array<char>(args, "SEQA"), Array<char>(args, "SEQB"),
+           Array<int>(args, "M"), Array<char>(args, "ptr"));
+}
+
+// ---- seidel engine ----
+
+void Seidel2d(Args& args) {
+  seidel::Wavefront(40, Ld(args, "A"), Array(args, "A"));
+}
+
+// The spmv engine has no variant: at the 494 rows of spmv-crs the merge-path
+// split runs at 0.8x the plain CRS loop, and a SELL-C-sigma conversion costs
+// several products.
+
+// ---- stats engine ----
+
+void Correlation(Args& args) {
+  stats::Correlation(Dim(args, "data", 0), Ld(args, "data"),
+                     Scalar(args, "float_n"), Array(args, "data"),
+                     Array(args, "corr"), Array(args, "mean"),
+                     Array(args, "stddev"));
+}
+
+void Covariance(Args& args) {
+  stats::Covariance(Dim(args, "data", 0), Ld(args, "data"),
+                    Scalar(args, "float_n"), Array(args, "data"),
+                    Array(args, "cov"), Array(args, "mean"));
+}
+
+// ---- stencil engine ----
+
+// stencil() filters a 128 x 64 grid, stencil3d() a 34^3 one.
+void Stencil2d(Args& args) {
+  stencil::Filter2d(128, 64, Array<int>(args, "orig"), Array<int>(args, "sol"),
+                    Array<int>(args, "filter"));
+}
+
+void Stencil3d(Args& args) {
+  stencil::Stencil3d(34, 34, 34, args.Value<long>(Index(args, "C0")),
+                     args.Value<long>(Index(args, "C1")),
+                     Array<long>(args, "orig"), Array<long>(args, "sol"));
+}
+
+// The temporal engine has no variants: the data/sources grids of jacobi-1d,
+// jacobi-2d, heat-3d and fdtd-2d fit in cache, where temporal blocking runs
+// at 0.6-1.1x the reference loops. It pays off on larger grids only (see
+// temporal-main.cpp).
+
+}  // namespace
+
+const std::vector<Variant>& Variants() {
+  static const std::vector<Variant> variants = {
+      {"2mm", "gemm", false, Mm2},
+      {"3mm", "gemm", false, Mm3},
+      {"adi", "adi", true, Adi},
+      {"aes", "aes", true, Aes},
+      {"atax", "matvec", false, Atax},
+      {"atax-medium", "matvec", false, Atax},
+      {"bicg", "matvec", false, Bicg},
+      {"bicg-large", "matvec", false, Bicg},
+      {"bicg-medium", "matvec", false, Bicg},
+      {"correlation", "stats", false, Correlation},
+      {"covariance", "stats", false, Covariance},
+      {"doitgen", "doitgen", false, Doitgen},
+      {"doitgen-red", "doitgen", false, Doitgen},
+      {"gemm-blocked", "gemm", false, GemmBlocked},
+      {"gemm-ncubed", "gemm", false, GemmNcubed},
+      {"gemver", "gemver", true, Gemver},
+      {"gemver-medium", "gemver", true, Gemver},
+      {"gesummv", "matvec", false, Gesummv},
+      {"gesummv-medium", "matvec", false, Gesummv},
+      {"md", "md", true, Md},
+      {"mvt", "matvec", false, Mvt},
+      {"mvt-medium", "matvec", false, Mvt},
+      {"nw", "nw", true, Nw},
+      {"seidel-2d", "seidel", true, Seidel2d},
+      {"stencil", "stencil", true, Stencil2d},
+      {"stencil-3d", "stencil", true, Stencil3d},
+      {"symm", "gemm", false, Symm},
+      {"symm-opt", "gemm", false, Symm},
+      {"symm-opt-medium", "gemm", false, Symm},
+      {"syr2k", "gemm", false, Syr2k},
+      {"syrk", "gemm", false, Syrk},
+      {"trmm", "gemm", false, Trmm},
+      {"trmm-opt", "gemm", false, Trmm},
+  };
+  return variants;
+}
+
+const Variant* FindVariant(const std::string& name) {
+  for (const Variant& variant : Variants()) {
+    if (variant.name == name) return &variant;
+  }
+  return nullptr;
+}
+
+}  // namespace fast
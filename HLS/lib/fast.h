@@ -0,0 +1,29 @@
+#ifndef FAST_H_
+#define FAST_H_
+
+#include <string>
+#include <vector>
+
+#include "kernels.h"
+
+// Fast CPU references of the data/sources kernels. A variant takes the same
+// registry arguments as the kernel of the same name and produces the same
+// outputs, up to floating-point reassociation where `exact` is false.
+namespace fast {
+
+struct Variant {
+  std::string name;    // registry name of the kernel it replaces
+  std::string engine;  // engine it is built on, e.g. "gemm"
+  bool exact;          // bitwise identical to the original kernel
+  void (*run)(kernels::Args& args);
+};
+
+// All variants, sorted by name.
+const std::vector<Variant>& Variants();
+
+// Returns nullptr when the kernel has no fast variant.
+const Variant* FindVariant(const std::string& name);
+
+}  // namespace fast
+
+#endif
@@ -0,0 +1,303 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "cache.h"
+#include "fuzz.h"
+#include "jobs.h"
+#include "kernels.h"
+#include "verify.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// The arrays the harness of a kernel compares and their tolerance, or all
+// arrays with the harness's tolerance when it has none.
+verify::Target TargetOf(const kernels::Kernel& kernel) {
+  const verify::Target* target = verify::FindTarget(kernel.name);
+  return target != nullptr ? *target : verify::Target{kernel.name, {}, {}};
+}
+
+// Whether a build is correct on an input: equivalent or off by rounding.
+bool Passes(verify::Outcome outcome) {
+  return outcome == verify::Outcome::kEquivalent ||
+         outcome == verify::Outcome::kRounding;
+}
+
+// A transformed build of one kernel, shared by the sources that normalise to
+// the same text.
+struct Build {
+  const kernels::Kernel* kernel;
+  size_t fuzzer;  // index of its Fuzzer
+  fs::path source;
+  string function;
+  string key;  // see cache::Key
+  std::unique_ptr<verify::Library> library;
+  void (*call)() = nullptr;
+  int sources = 0;
+};
+
+}  // namespace
+
+// Differential fuzzing of transformed kernels against the originals in
+// data/sources, on `inputs` generated inputs each (see fuzz::Generate) from
+// seed `first`, `batch` per forked child. Given a kernel and sources, fuzzes
+// those; given a directory such as transformed_sources, fuzzes every source of
+// the verification set under it that passes the one-input check of verify.
+// The first failing input of a build is saved to the failures directory, with
+// a minimised copy beside it. With -r, checks the sources on a saved input
+// instead:
+//   fuzz [-n inputs] [-b batch] [-s first] [-j jobs] [-o failures-dir]
+//        [-c cache-dir | --no-cache] (kernel source... | [transformed-dir])
+//   fuzz -r input kernel source...
+int main(int argc, char** argv) {
+  int inputs = 1000;
+  int batch = 100;
+  unsigned first = 1;
+  int workers = 0;
+  string failures = "fuzz-failures";
+  string cache_dir = "verify-cache";
+  string replay;
+  vector<string> paths;
+  bool usage = false;
+  for (int i = 1; i < argc; ++i) {
+    const string arg = argv[i];
+    const bool value = i + 1 < argc;
+    if (arg == "-n" && value) {
+      inputs = std::atoi(argv[++i]);
+    } else if (arg == "-b" && value) {
+      batch = std::atoi(argv[++i]);
+    } else if (arg == "-s" && value) {
+      first = static_cast<unsigned>(std::atol(argv[++i]));
+    } else if (arg == "-j" && value) {
+      workers = std::atoi(argv[++i]);
+    } else if (arg == "-o" && value) {
+      failures = argv[++i];
+    } else if (arg == "-c" && value) {
+      cache_dir = argv[++i];
+    } else if (arg == "--no-cache") {
+      cache_dir.clear();
+    } else if (arg == "-r" && value) {
+      replay = argv[++i];
+    } else if (arg.rfind("-", 0) == 0) {
+      usage = true;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  const kernels::Kernel* named =
+      paths.empty() ? nullptr : kernels::FindKernel(paths[0]);
+  if (usage || inputs <= 0 || batch <= 0 || workers < 0 ||
+      (named == nullptr && (paths.size() > 1 || !replay.empty())) ||
+      (named != nullptr && paths.size() < 2)) {
+    clog << "Usage: " << argv[0]
+         << " [-n inputs] [-b batch] [-s first] [-j jobs] [-o failures-dir]"
+            " [-c cache-dir | --no-cache]"
+            " (kernel source... | [transformed-dir])\n"
+         << "       " << argv[0] << " -r input kernel source...\n";
+    return EXIT_FAILURE;
+  }
+
+  int error = 0;
+  std::unique_ptr<cache::Store> store;
+  if (!cache_dir.empty()) store = std::make_unique<cache::Store>(cache_dir);
+  const string flags =
+      string(verify::kCompileFlags) + " gcc " + verify::CompilerVersion();
+
+  // The kernels to fuzz, with their sources.
+  vector<const kernels::Kernel*> originals;
+  vector<vector<fs::path>> sources;
+  if (named != nullptr) {
+    originals.push_back(named);
+    sources.emplace_back(paths.begin() + 1, paths.end());
+  } else {
+    const fs::path root = paths.empty() ? "../transformed_sources" : paths[0];
+    for (const verify::Target& target : verify::Targets()) {
+      originals.push_back(kernels::FindKernel(target.kernel));
+      sources.emplace_back();
+    }
+    for (const fs::directory_entry& entry :
+         fs::recursive_directory_iterator(root)) {
+      for (size_t t = 0; t < originals.size(); ++t) {
+        if (entry.path().filename() == originals[t]->source) {
+          sources[t].push_back(entry.path());
+        }
+      }
+    }
+    for (vector<fs::path>& found : sources) {
+      std::sort(found.begin(), found.end());
+    }
+  }
+
+  vector<fuzz::Fuzzer> fuzzers;
+  vector<std::unique_ptr<verify::Checker>> checkers;
+  std::map<string, Build> builds;  // by key, kernel and function
+  for (size_t t = 0; t < originals.size(); ++t) {
+    const verify::Target target = TargetOf(*originals[t]);
+    fuzzers.emplace_back(*originals[t], target.outputs, target.tolerance);
+    if (named == nullptr) {
+      checkers.push_back(std::make_unique<verify::Checker>(
+          *originals[t], target.outputs, target.tolerance));
+    }
+    for (const fs::path& source : sources[t]) {
+      if (!fs::exists(source)) {
+        clog << source.string() << " is missing" << endl;
+        ++error;
+        continue;
+      }
+      const string code = verify::ReadFile(source);
+      const string function =
+          verify::TopLevelFunction(code, originals[t]->function);
+      const string key = cache::Key(code, flags);
+      Build& build = builds[key + " " + originals[t]->name + " " + function];
+      if (build.sources++ == 0) {
+        build.kernel = originals[t];
+        build.fuzzer = t;
+        build.source = source;
+        build.function = function;
+        build.key = key;
+      }
+    }
+  }
+
+  // The input to replay, read once for every source.
+  std::optional<kernels::Args> input;
+  if (!replay.empty()) {
+    try {
+      input = fuzz::Load(replay, *named);
+    } catch (const std::invalid_argument& e) {
+      clog << e.what() << endl;
+    } catch (const std::system_error& e) {
+      clog << "Cannot read " << e.what() << endl;
+    }
+    if (!input) {
+      ++error;
+      builds.clear();
+    }
+  }
+
+  char temp[] = "/tmp/fuzz-XXXXXX";
+  if (mkdtemp(temp) == nullptr) {
+    clog << "Cannot create a temporary directory" << endl;
+    return EXIT_FAILURE;
+  }
+  const fs::path objects = temp;
+  if (replay.empty()) fs::create_directories(failures);
+
+  std::mutex mutex;
+  int fuzzed = 0;
+  int skipped = 0;
+  jobs::Graph graph;
+  int objects_made = 0;
+  for (auto& [id, build] : builds) {
+    const fs::path object = objects / (std::to_string(objects_made++) + ".so");
+    const jobs::Graph::Id made = graph.Add([&, object] {
+      verify::Loaded loaded = verify::LoadBuild(
+          build.source, build.key, build.function, store.get(), object);
+      build.library = std::move(loaded.library);
+      build.call = loaded.call;
+    });
+    graph.Add(
+        [&] {
+          const fuzz::Fuzzer& fuzzer = fuzzers[build.fuzzer];
+          string shown = build.source.string();
+          if (build.sources > 1) {
+            shown += " (+" + std::to_string(build.sources - 1) + " identical)";
+          }
+          std::ostringstream line;
+          bool failed = false;
+          if (build.call == nullptr) {
+            // Not built or not loaded: an error when asked for, else verify's
+            // to report.
+            std::lock_guard<std::mutex> lock(mutex);
+            if (named != nullptr) {
+              cout << shown << ": "
+                   << verify::Describe(build.library
+                                           ? verify::Outcome::kLoadError
+                                           : verify::Outcome::kCompileError)
+                   << endl;
+              ++error;
+            } else {
+              ++skipped;
+            }
+            return;
+          }
+          if (!replay.empty()) {
+            const verify::Outcome outcome = fuzzer.Check(build.call, *input);
+            line << verify::Describe(outcome);
+            failed = !Passes(outcome);
+          } else if (!checkers.empty() &&
+                     !Passes(checkers[build.fuzzer]->Check(build.call))) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++skipped;
+            return;
+          } else if (const std::optional<fuzz::Failure> failure =
+                         fuzzer.Run(build.call, first, inputs, batch)) {
+            const fs::path saved =
+                fs::path(failures) / (build.kernel->name + "-" +
+                                      build.key.substr(0, 12) + "-" +
+                                      std::to_string(failure->seed));
+            fuzz::Save(saved.string() + ".in", *build.kernel, failure->seed,
+                       failure->input);
+            const kernels::Args minimal =
+                fuzzer.Minimize(build.call, *failure);
+            fuzz::Save(saved.string() + ".min.in", *build.kernel,
+                       failure->seed, minimal);
+            line << "input " << failure->seed << ": "
+                 << verify::Describe(failure->outcome) << " Saved to "
+                 << saved.string() << ".in, minimised to "
+                 << fuzzer.Nontrivial(minimal) << " of "
+                 << fuzzer.Nontrivial(failure->input)
+                 << " nonzero elements in .min.in";
+            failed = true;
+          } else {
+            line << "passed " << inputs << " inputs";
+          }
+          build.library.reset();
+          std::lock_guard<std::mutex> lock(mutex);
+          ++fuzzed;
+          if (failed) ++error;
+          cout << shown << ": " << line.str() << endl;
+        },
+        {made});
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  graph.Run(workers);
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - begin)
+                             .count();
+  fs::remove_all(objects);
+  cout << fuzzed << " builds fuzzed";
+  if (skipped > 0) cout << ", " << skipped << " failing already skipped";
+  cout << " in " << seconds << " s" << endl;
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
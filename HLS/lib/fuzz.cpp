@@ -0,0 +1,377 @@
+#include "fuzz.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace fuzz {
+
+namespace {
+
+using kernels::Args;
+using kernels::Type;
+
+// Arguments whose values must stay in a range for the kernel to stay within
+// its arrays, as gen_kernels.py's DOMAINS initialises them. The bound is the
+// length of another argument in the registry, so that the table follows the
+// sizes of the sources; keep the two tables in step.
+enum class Kind {
+  kIndex,          // every element in [0, bound)
+  kRowDelimiters,  // CRS row pointers of `bound` rows
+};
+
+struct Domain {
+  const char* kernel;
+  const char* arg;
+  Kind kind;
+  const char* extent;  // the argument whose length is the bound
+};
+
+const Domain kDomains[] = {
+    {"md", "NL", Kind::kIndex, "position_x"},
+    {"spmv-crs", "cols", Kind::kIndex, "vec"},
+    {"spmv-crs", "rowDelimiters", Kind::kRowDelimiters, "out"},
+    {"spmv-ellpack", "cols", Kind::kIndex, "vec"},
+};
+
+const Domain* FindDomain(const std::string& kernel, const std::string& arg) {
+  for (const Domain& domain : kDomains) {
+    if (kernel == domain.kernel && arg == domain.arg) return &domain;
+  }
+  return nullptr;
+}
+
+int Bound(const Args& args, const Domain& domain) {
+  for (int i = 0; i < args.Size(); ++i) {
+    if (args.Spec(i).name == domain.extent) {
+      return static_cast<int>(args.Count(i));
+    }
+  }
+  throw std::logic_error(std::string(domain.kernel) + " has no argument " +
+                         domain.extent);
+}
+
+// The registry's range of integers without a domain.
+constexpr int kIntLow = -100;
+constexpr int kIntHigh = 100;
+
+// Replaces each element by one of `values` or, for the last choice, keeps it.
+template <typename T>
+void PickEdges(T* data, size_t count, std::initializer_list<T> values,
+               kernels::Rng& rng) {
+  std::uniform_int_distribution<size_t> pick(0, values.size());
+  for (size_t i = 0; i < count; ++i) {
+    const size_t choice = pick(rng);
+    if (choice < values.size()) data[i] = values.begin()[choice];
+  }
+}
+
+template <typename T>
+void Repeat(T* data, size_t count) {
+  std::fill(data, data + count, data[0]);
+}
+
+void ShapeRowDelimiters(int* data, int rows, Pattern pattern,
+                        kernels::Rng& rng) {
+  const int nnz = data[rows];
+  if (pattern == Pattern::kEdges) {
+    // Runs of empty rows, and rows that take the rest.
+    PickEdges(data + 1, rows - 1, {0, nnz}, rng);
+    std::sort(data + 1, data + rows);
+  } else {
+    const int full = std::uniform_int_distribution<int>(0, rows - 1)(rng);
+    for (int i = 1; i < rows; ++i) data[i] = i <= full ? 0 : nnz;
+  }
+}
+
+void Shape(Args& args, int i, const Domain* domain, Pattern pattern,
+           kernels::Rng& rng) {
+  const size_t count = args.Count(i);
+  const bool edges = pattern == Pattern::kEdges;
+  if (domain != nullptr && domain->kind == Kind::kRowDelimiters) {
+    ShapeRowDelimiters(args.Ptr<int*>(i), Bound(args, *domain), pattern,
+                       rng);
+    return;
+  }
+  switch (args.Spec(i).type) {
+    case Type::kDouble:
+      if (edges) {
+        PickEdges(args.Ptr<double*>(i), count, {0.0, 1.0, -1.0}, rng);
+      } else {
+        Repeat(args.Ptr<double*>(i), count);
+      }
+      break;
+    case Type::kInt:
+      if (!edges) {
+        Repeat(args.Ptr<int*>(i), count);
+      } else if (domain != nullptr) {
+        PickEdges(args.Ptr<int*>(i), count, {0, Bound(args, *domain) - 1},
+                  rng);
+      } else {
+        PickEdges(args.Ptr<int*>(i), count, {kIntLow, 0, kIntHigh}, rng);
+      }
+      break;
+    case Type::kLong:
+      if (edges) {
+        PickEdges(args.Ptr<long*>(i), count,
+                  {long{kIntLow}, 0L, long{kIntHigh}}, rng);
+      } else {
+        Repeat(args.Ptr<long*>(i), count);
+      }
+      break;
+    case Type::kChar:
+      if (edges) {
+        PickEdges(args.Ptr<char*>(i), count, {'A', 'T'}, rng);
+      } else {
+        Repeat(args.Ptr<char*>(i), count);
+      }
+      break;
+    case Type::kUChar:
+      if (edges) {
+        PickEdges(args.Ptr<unsigned char*>(i), count,
+                  {static_cast<unsigned char>(0),
+                   static_cast<unsigned char>(255)},
+                  rng);
+      } else {
+        Repeat(args.Ptr<unsigned char*>(i), count);
+      }
+      break;
+  }
+}
+
+// The value Minimize reduces elements to: valid as an index and a letter.
+bool IsPlain(const Args& args, int i, size_t j) {
+  switch (args.Spec(i).type) {
+    case Type::kDouble:
+      return static_cast<const double*>(args.Data(i))[j] == 0.0;
+    case Type::kInt: return static_cast<const int*>(args.Data(i))[j] == 0;
+    case Type::kLong: return static_cast<const long*>(args.Data(i))[j] == 0;
+    case Type::kChar: return static_cast<const char*>(args.Data(i))[j] == 'A';
+    case Type::kUChar:
+      return static_cast<const unsigned char*>(args.Data(i))[j] == 0;
+  }
+  return true;
+}
+
+void SetPlain(Args& args, int i, size_t begin, size_t end) {
+  switch (args.Spec(i).type) {
+    case Type::kDouble:
+      std::fill(args.Ptr<double*>(i) + begin, args.Ptr<double*>(i) + end,
+                0.0);
+      break;
+    case Type::kInt:
+      std::fill(args.Ptr<int*>(i) + begin, args.Ptr<int*>(i) + end, 0);
+      break;
+    case Type::kLong:
+      std::fill(args.Ptr<long*>(i) + begin, args.Ptr<long*>(i) + end, 0L);
+      break;
+    case Type::kChar:
+      std::fill(args.Ptr<char*>(i) + begin, args.Ptr<char*>(i) + end, 'A');
+      break;
+    case Type::kUChar:
+      std::fill(args.Ptr<unsigned char*>(i) + begin,
+                args.Ptr<unsigned char*>(i) + end, 0);
+      break;
+  }
+}
+
+// Exit codes of the checking child, as in verify::Checker::Check.
+enum ExitCode { kExitSame = 70, kExitDifferent = 71 };
+
+}  // namespace
+
+Args Generate(const kernels::Kernel& kernel, unsigned seed) {
+  Args args = kernels::MakeArgs(kernel, seed);
+  const Pattern pattern = static_cast<Pattern>(seed % kPatterns);
+  if (pattern == Pattern::kRandom) return args;
+  kernels::Rng rng(~seed);
+  for (int i = 0; i < args.Size(); ++i) {
+    if (args.Spec(i).shape.empty()) continue;
+    Shape(args, i, FindDomain(kernel.name, args.Spec(i).name), pattern, rng);
+  }
+  return args;
+}
+
+void Save(const std::string& path, const kernels::Kernel& kernel,
+          unsigned seed, const Args& input) {
+  std::ofstream out(path, std::ios::binary);
+  out << "fuzz-input " << kernel.name << " " << seed << "\n";
+  for (int i = 0; i < input.Size(); ++i) {
+    // The type goes last, as it may be two words.
+    out << input.Spec(i).name << " " << input.Count(i) << " "
+        << kernels::TypeName(input.Spec(i).type) << "\n";
+    out.write(static_cast<const char*>(input.Data(i)), input.Bytes(i));
+  }
+  if (!out) throw std::system_error(EIO, std::generic_category(), path);
+}
+
+Args Load(const std::string& path, const kernels::Kernel& kernel) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) throw std::system_error(ENOENT, std::generic_category(), path);
+  std::string line;
+  std::getline(in, line);
+  std::istringstream header(line);
+  std::string magic, name;
+  header >> magic >> name;
+  if (magic != "fuzz-input" || name != kernel.name) {
+    throw std::invalid_argument(path + " is not an input of " + kernel.name);
+  }
+  Args args(kernel.args);
+  for (int i = 0; i < args.Size(); ++i) {
+    std::getline(in, line);
+    std::istringstream spec(line);
+    std::string arg, type;
+    size_t count = 0;
+    spec >> arg >> count;
+    std::getline(spec >> std::ws, type);
+    if (arg != args.Spec(i).name || count != args.Count(i) ||
+        type != kernels::TypeName(args.Spec(i).type)) {
+      throw std::invalid_argument(path + ": unexpected argument '" + line +
+                                  "' of " + kernel.name);
+    }
+    in.read(static_cast<char*>(args.Data(i)), args.Bytes(i));
+    if (!in) throw std::invalid_argument(path + " is truncated");
+  }
+  return args;
+}
+
+Fuzzer::Fuzzer(const kernels::Kernel& kernel,
+               const std::vector<std::string>& outputs,
+               const compare::Tolerance& tolerance)
+    : kernel_(kernel),
+      outputs_(verify::OutputIndices(kernel, outputs)),
+      tolerance_(tolerance) {}
+
+std::optional<Failure> Fuzzer::Run(void (*function)(), unsigned first,
+                                   int count, int batch) const {
+  batch = std::max(1, batch);
+  for (int done = 0; done < count; done += batch) {
+    std::vector<Args> inputs;
+    std::vector<Args> expected;
+    for (int k = 0; k < std::min(batch, count - done); ++k) {
+      inputs.push_back(Generate(kernel_, first + done + k));
+      expected.push_back(inputs.back());
+      kernel_.run(expected.back());
+    }
+    const auto [index, outcome] = Batch(function, inputs, expected);
+    if (index < inputs.size()) {
+      return Failure{first + done + static_cast<unsigned>(index), outcome,
+                     std::move(inputs[index])};
+    }
+  }
+  return std::nullopt;
+}
+
+verify::Outcome Fuzzer::Check(void (*function)(), const Args& input) const {
+  std::vector<Args> inputs{input};
+  std::vector<Args> expected{input};
+  kernel_.run(expected[0]);
+  return Batch(function, inputs, expected).second;
+}
+
+std::pair<size_t, verify::Outcome> Fuzzer::Batch(
+    void (*function)(), const std::vector<Args>& inputs,
+    const std::vector<Args>& expected) const {
+  // The child counts the inputs it has started here, for the parent to tell
+  // which one crashed or hung.
+  void* shared = mmap(nullptr, sizeof(size_t), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "mmap");
+  }
+  volatile size_t* started = static_cast<volatile size_t*>(shared);
+  *started = 0;
+  std::fflush(nullptr);
+  const pid_t pid = fork();
+  if (pid < 0) throw std::system_error(errno, std::generic_category(), "fork");
+  if (pid == 0) {
+    verify::Silence();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      *started = i;
+      alarm(verify::Checker::kTimeoutSeconds);
+      const Args out = verify::CallGuarded(kernel_, function, inputs[i]);
+      if (verify::Judge(expected[i], out, outputs_, tolerance_) ==
+          verify::Outcome::kDifferent) {
+        _exit(kExitDifferent);
+      }
+    }
+    _exit(kExitSame);
+  }
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "waitpid");
+    }
+  }
+  const size_t index = *started;
+  munmap(shared, sizeof(size_t));
+  if (WIFEXITED(status) && WEXITSTATUS(status) == kExitSame) {
+    return {inputs.size(), verify::Outcome::kEquivalent};
+  }
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+    return {index, verify::Outcome::kTimeout};
+  }
+  if (WIFEXITED(status) && WEXITSTATUS(status) == kExitDifferent) {
+    return {index, verify::Outcome::kDifferent};
+  }
+  return {index, verify::Outcome::kCrash};
+}
+
+bool Fuzzer::Reducible(int arg) const {
+  const kernels::ArgSpec& spec = kernel_.args[arg];
+  const Domain* domain = FindDomain(kernel_.name, spec.name);
+  return !spec.shape.empty() &&
+         (domain == nullptr || domain->kind != Kind::kRowDelimiters);
+}
+
+Args Fuzzer::Minimize(void (*function)(), const Failure& failure,
+                      int tests) const {
+  Args current = failure.input;
+  // Every check of a hang would wait out the timeout.
+  if (failure.outcome == verify::Outcome::kTimeout) return current;
+  for (int i = 0; i < current.Size() && tests > 0; ++i) {
+    if (!Reducible(i)) continue;
+    const size_t count = current.Count(i);
+    for (size_t chunk = count; chunk >= 1 && tests > 0; chunk /= 2) {
+      for (size_t begin = 0; begin < count && tests > 0; begin += chunk) {
+        const size_t end = std::min(count, begin + chunk);
+        bool plain = true;
+        for (size_t j = begin; j < end && plain; ++j) {
+          plain = IsPlain(current, i, j);
+        }
+        if (plain) continue;
+        Args candidate = current;
+        SetPlain(candidate, i, begin, end);
+        --tests;
+        if (Check(function, candidate) == failure.outcome) {
+          current = std::move(candidate);
+        }
+      }
+    }
+  }
+  return current;
+}
+
+size_t Fuzzer::Nontrivial(const Args& input) const {
+  size_t count = 0;
+  for (int i = 0; i < input.Size(); ++i) {
+    if (!Reducible(i)) continue;
+    for (size_t j = 0; j < input.Count(i); ++j) {
+      if (!IsPlain(input, i, j)) ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace fuzz
@@ -0,0 +1,91 @@
+#ifndef FUZZ_H_
+#define FUZZ_H_
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "compare.h"
+#include "kernels.h"
+#include "verify.h"
+
+// Differential fuzzing of transformed kernels against their originals: where
+// verify::Checker runs one input, as the test_<kernel>.c harnesses do, a
+// Fuzzer runs thousands, generated per kernel so that indices stay within the
+// arrays they index, and reduces a failing one to the few elements that make
+// the difference.
+namespace fuzz {
+
+// How Generate shapes an input after the registry's initialiser.
+enum class Pattern {
+  kRandom,   // as the registry fills it
+  kEdges,    // values and indices at the ends of their ranges, empty rows
+  kRepeats,  // one value, index or letter throughout; all nonzeros in one row
+};
+constexpr int kPatterns = 3;
+
+// Input number `seed` of a kernel: the registry's initialiser from the seed,
+// then reshaped by Pattern(seed % kPatterns). Neighbour lists, column indices
+// and CRS row pointers (see Domains in fuzz.cpp) stay valid in every pattern.
+kernels::Args Generate(const kernels::Kernel& kernel, unsigned seed);
+
+// Writes an input of `kernel` to `path`, as a line naming the kernel and seed
+// followed by a line and the raw bytes of each argument.
+void Save(const std::string& path, const kernels::Kernel& kernel,
+          unsigned seed, const kernels::Args& input);
+// Reads an input written by Save. Throws std::invalid_argument when the file
+// is not an input of `kernel`.
+kernels::Args Load(const std::string& path, const kernels::Kernel& kernel);
+
+// The first input a transformed build got wrong.
+struct Failure {
+  unsigned seed;
+  verify::Outcome outcome;
+  kernels::Args input;
+};
+
+class Fuzzer {
+ public:
+  // Compares `outputs`, or every array when empty, as verify::Checker does.
+  // Differences within `tolerance` are not failures.
+  Fuzzer(const kernels::Kernel& kernel,
+         const std::vector<std::string>& outputs,
+         const compare::Tolerance& tolerance = {});
+
+  // Checks `function` on inputs first, ..., first + count - 1, `batch` of them
+  // per forked child, and returns the first it gets wrong, if any. Safe to call
+  // from several threads.
+  std::optional<Failure> Run(void (*function)(), unsigned first, int count,
+                             int batch = 100) const;
+
+  // The outcome of `function` on one input.
+  verify::Outcome Check(void (*function)(), const kernels::Args& input) const;
+
+  // Sets as many elements of a failing input to 0, or 'A' in sequences, as it
+  // can while `function` keeps failing the same way, in chunks halving down to
+  // single elements and at most `tests` checks. Row pointers are left alone.
+  kernels::Args Minimize(void (*function)(), const Failure& failure,
+                         int tests = 2000) const;
+
+  // The elements Minimize has left to reduce in an input.
+  size_t Nontrivial(const kernels::Args& input) const;
+
+ private:
+  // Runs `function` on each of `inputs` in one child, in order. Returns the
+  // index of the first it gets wrong and how, or the number of inputs and
+  // kEquivalent.
+  std::pair<size_t, verify::Outcome> Batch(
+      void (*function)(), const std::vector<kernels::Args>& inputs,
+      const std::vector<kernels::Args>& expected) const;
+
+  bool Reducible(int arg) const;
+
+  const kernels::Kernel& kernel_;
+  std::vector<int> outputs_;
+  compare::Tolerance tolerance_;
+};
+
+}  // namespace fuzz
+
+#endif
@@ -0,0 +1,186 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "gemm.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using gemm::Isa;
+using gemm::Trans;
+
+namespace {
+
+double At(const vector<double>& x, Trans trans, int i, int j, int ld) {
+  return trans == Trans::kNo ? x[i * ld + j] : x[j * ld + i];
+}
+
+// Compares the engine with a naive triple loop on one shape, returning the
+// number of wrong elements of C.
+int Check(Trans ta, Trans tb, int m, int n, int k, double beta, bool lower,
+          kernels::Rng& rng) {
+  const double alpha = 1.5;
+  int lda = (ta == Trans::kNo ? k : m) + 3;
+  int ldb = (tb == Trans::kNo ? n : k) + 1;
+  int ldc = n + 2;
+  vector<double> a((ta == Trans::kNo ? m : k) * lda);
+  vector<double> b((tb == Trans::kNo ? k : n) * ldb);
+  vector<double> c(m * ldc);
+  kernels::FillUniform(a.data(), a.size(), rng);
+  kernels::FillUniform(b.data(), b.size(), rng);
+  kernels::FillUniform(c.data(), c.size(), rng);
+
+  vector<double> ref = c;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < (lower ? i + 1 : n); ++j) {
+      double sum = 0.0;
+      for (int p = 0; p < k; ++p) {
+        sum += At(a, ta, i, p, lda) * At(b, tb, p, j, ldb);
+      }
+      ref[i * ldc + j] = alpha * sum + beta * ref[i * ldc + j];
+    }
+  }
+  if (lower) {
+    gemm::DgemmLower(ta, tb, m, k, alpha, a.data(), lda, b.data(), ldb, beta,
+                     c.data(), ldc);
+  } else {
+    gemm::Dgemm(ta, tb, m, n, k, alpha, a.data(), lda, b.data(), ldb, beta,
+                c.data(), ldc);
+  }
+
+  int error = 0;
+  for (size_t i = 0; i < c.size(); ++i) {
+    if (!(std::fabs(c[i] - ref[i]) <= 1e-12 * (k + 1))) ++error;
+  }
+  if (error != 0) {
+    clog << gemm::IsaName(gemm::CurrentIsa()) << (lower ? " lower" : "")
+         << " m=" << m << " n=" << n << " k=" << k << " beta=" << beta << ": "
+         << error << " wrong elements" << endl;
+  }
+  return error;
+}
+
+// Counts the elements of x off from ref by more than the rounding of a
+// k-term sum.
+int Wrong(const vector<double>& x, const vector<double>& ref, int k) {
+  int error = 0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (!(std::fabs(x[i] - ref[i]) <= 1e-12 * (k + 1))) ++error;
+  }
+  return error;
+}
+
+// Compares Dtrmm and Dsymm with the loops of kernel_trmm and kernel_symm on
+// an m x m A and m x n B and C.
+int CheckTriangular(int m, int n, kernels::Rng& rng) {
+  const double alpha = 1.5;
+  const double beta = 1.2;
+  const int lda = m + 1;
+  const int ldb = n + 3;
+  vector<double> a(m * lda), b(m * ldb), c(m * ldb);
+  kernels::FillUniform(a.data(), a.size(), rng);
+  kernels::FillUniform(b.data(), b.size(), rng);
+  kernels::FillUniform(c.data(), c.size(), rng);
+
+  vector<double> trmm = b, symm = c;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      for (int k = i + 1; k < m; ++k) {
+        trmm[i * ldb + j] += a[k * lda + i] * b[k * ldb + j];
+      }
+      trmm[i * ldb + j] *= alpha;
+      double sum = 0.0;
+      for (int k = 0; k < m; ++k) {
+        sum += (k <= i ? a[i * lda + k] : a[k * lda + i]) * b[k * ldb + j];
+      }
+      symm[i * ldb + j] = beta * symm[i * ldb + j] + alpha * sum;
+    }
+  }
+  vector<double> x = b;
+  gemm::Dtrmm(m, n, alpha, a.data(), lda, x.data(), ldb);
+  int error = 0;
+  int wrong = Wrong(x, trmm, m);
+  if (wrong != 0) {
+    clog << gemm::IsaName(gemm::CurrentIsa()) << " trmm m=" << m
+         << " n=" << n << ": " << wrong << " wrong elements" << endl;
+    error += wrong;
+  }
+  x = c;
+  gemm::Dsymm(m, n, alpha, a.data(), lda, b.data(), ldb, beta, x.data(), ldb);
+  wrong = Wrong(x, symm, m);
+  if (wrong != 0) {
+    clog << gemm::IsaName(gemm::CurrentIsa()) << " symm m=" << m
+         << " n=" << n << ": " << wrong << " wrong elements" << endl;
+    error += wrong;
+  }
+  return error;
+}
+
+}  // namespace
+
+// Checks every micro-kernel the CPU supports against a naive GEMM on shapes
+// around the block sizes, then reports the throughput of the best one.
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    clog << "Usage: " << argv[0] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  const int sizes[] = {1, 5, 17, 64, 97, 300};
+  kernels::Rng rng(42);
+  int error = 0;
+  for (Isa isa : {Isa::kGeneric, Isa::kAvx2, Isa::kAvx512}) {
+    if (!gemm::SetIsa(isa)) continue;
+    clog << "Check " << gemm::IsaName(isa) << endl;
+    for (int m : sizes) {
+      for (int n : sizes) {
+        for (int k : sizes) {
+          Trans ta = (m + k) % 2 ? Trans::kYes : Trans::kNo;
+          Trans tb = (n + k) % 3 ? Trans::kNo : Trans::kYes;
+          double beta = k % 2 ? 0.0 : 1.2;
+          error += Check(ta, tb, m, n, k, beta, false, rng);
+        }
+        error += Check(Trans::kNo, Trans::kYes, m, m, n, 1.2, true, rng);
+        error += CheckTriangular(m, n, rng);
+      }
+    }
+  }
+
+  gemm::SetIsa(gemm::BestIsa());
+  for (int n : {64, 256, 1024}) {
+    vector<double> a(n * n), b(n * n), c(n * n);
+    kernels::FillUniform(a.data(), a.size(), rng);
+    kernels::FillUniform(b.data(), b.size(), rng);
+    bench::Timing t = bench::Measure(1, 5, [] {}, [&] {
+      gemm::Dgemm(Trans::kNo, Trans::kNo, n, n, n, 1.0, a.data(), n, b.data(),
+                  n, 0.0, c.data(), n);
+    });
+    cout << gemm::IsaName(gemm::CurrentIsa()) << " n=" << n << ": "
+         << 2.0 * n * n * n / t.median * 1e-9 << " GFLOP/s" << endl;
+    // Useful flops only: the triangle of A for trmm, all of S for symm.
+    bench::Timing trmm = bench::Measure(1, 5, [] {}, [&] {
+      gemm::Dtrmm(n, n, 1.0, a.data(), n, c.data(), n);
+    });
+    bench::Timing symm = bench::Measure(1, 5, [] {}, [&] {
+      gemm::Dsymm(n, n, 1.0, a.data(), n, b.data(), n, 0.0, c.data(), n);
+    });
+    cout << gemm::IsaName(gemm::CurrentIsa()) << " n=" << n
+         << ": trmm " << 1.0 * n * n * n / trmm.median * 1e-9
+         << " GFLOP/s, symm " << 2.0 * n * n * n / symm.median * 1e-9
+         << " GFLOP/s" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,391 @@
+#include "gemm.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace gemm {
+
+namespace {
+
+// Cache blocking: a KC x NC panel of B stays in L3 (or L2 for the kernel
+// sizes of data/sources), an MC x KC block of A in L2 and a KC x NR sliver of
+// B in L1 while the micro-kernel sweeps it. MC and NC are multiples of every
+// MR and NR below.
+const int kKc = 256;
+const int kMc = 96;
+const int kNc = 2048;
+
+const int kMaxMr = 8;
+const int kMaxNr = 16;
+
+// Computes the MR x NR tile C := alpha * A * B + beta * C from a packed
+// micro-panel of A (kc columns of MR values) and one of B (kc rows of NR
+// values). C is not read when beta is zero.
+using MicroKernelFn = void (*)(int kc, const double* a, const double* b,
+                               double alpha, double beta, double* c, long ldc);
+
+struct MicroKernel {
+  Isa isa;
+  int mr;
+  int nr;
+  MicroKernelFn fn;
+};
+
+void KernelGeneric(int kc, const double* a, const double* b, double alpha,
+                   double beta, double* c, long ldc) {
+  const int kMr = 4;
+  const int kNr = 8;
+  double ab[kMr][kNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kMr; ++i) {
+      for (int j = 0; j < kNr; ++j) ab[i][j] += a[i] * b[j];
+    }
+    a += kMr;
+    b += kNr;
+  }
+  for (int i = 0; i < kMr; ++i) {
+    for (int j = 0; j < kNr; ++j) {
+      c[i * ldc + j] = beta == 0.0 ? alpha * ab[i][j]
+                                   : alpha * ab[i][j] + beta * c[i * ldc + j];
+    }
+  }
+}
+
+// 6 x 8: twelve ymm accumulators, two for the row of B and one broadcast.
+__attribute__((target("avx2,fma"))) void KernelAvx2(
+    int kc, const double* a, const double* b, double alpha, double beta,
+    double* c, long ldc) {
+  const int kMr = 6;
+  __m256d ab[kMr][2];
+  for (int i = 0; i < kMr; ++i) {
+    ab[i][0] = _mm256_setzero_pd();
+    ab[i][1] = _mm256_setzero_pd();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m256d b0 = _mm256_loadu_pd(b);
+    __m256d b1 = _mm256_loadu_pd(b + 4);
+    for (int i = 0; i < kMr; ++i) {
+      __m256d ai = _mm256_broadcast_sd(a + i);
+      ab[i][0] = _mm256_fmadd_pd(ai, b0, ab[i][0]);
+      ab[i][1] = _mm256_fmadd_pd(ai, b1, ab[i][1]);
+    }
+    a += kMr;
+    b += 8;
+  }
+  __m256d va = _mm256_set1_pd(alpha);
+  __m256d vb = _mm256_set1_pd(beta);
+  for (int i = 0; i < kMr; ++i) {
+    for (int h = 0; h < 2; ++h) {
+      double* row = c + i * ldc + 4 * h;
+      __m256d r = _mm256_mul_pd(va, ab[i][h]);
+      if (beta != 0.0) r = _mm256_fmadd_pd(vb, _mm256_loadu_pd(row), r);
+      _mm256_storeu_pd(row, r);
+    }
+  }
+}
+
+// 8 x 16: sixteen zmm accumulators, two for the row of B and one broadcast.
+__attribute__((target("avx512f"))) void KernelAvx512(
+    int kc, const double* a, const double* b, double alpha, double beta,
+    double* c, long ldc) {
+  const int kMr = 8;
+  __m512d ab[kMr][2];
+  for (int i = 0; i < kMr; ++i) {
+    ab[i][0] = _mm512_setzero_pd();
+    ab[i][1] = _mm512_setzero_pd();
+  }
+  for (int p = 0; p < kc; ++p) {
+    __m512d b0 = _mm512_loadu_pd(b);
+    __m512d b1 = _mm512_loadu_pd(b + 8);
+    for (int i = 0; i < kMr; ++i) {
+      __m512d ai = _mm512_set1_pd(a[i]);
+      ab[i][0] = _mm512_fmadd_pd(ai, b0, ab[i][0]);
+      ab[i][1] = _mm512_fmadd_pd(ai, b1, ab[i][1]);
+    }
+    a += kMr;
+    b += 16;
+  }
+  __m512d va = _mm512_set1_pd(alpha);
+  __m512d vb = _mm512_set1_pd(beta);
+  for (int i = 0; i < kMr; ++i) {
+    for (int h = 0; h < 2; ++h) {
+      double* row = c + i * ldc + 8 * h;
+      __m512d r = _mm512_mul_pd(va, ab[i][h]);
+      if (beta != 0.0) r = _mm512_fmadd_pd(vb, _mm512_loadu_pd(row), r);
+      _mm512_storeu_pd(row, r);
+    }
+  }
+}
+
+const MicroKernel kKernels[] = {
+    {Isa::kGeneric, 4, 8, KernelGeneric},
+    {Isa::kAvx2, 6, 8, KernelAvx2},
+    {Isa::kAvx512, 8, 16, KernelAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa; read from the OpenMP threads of the stats and doitgen
+// engines.
+std::atomic<const MicroKernel*> forced{nullptr};
+
+const MicroKernel& Selected() {
+  static const MicroKernel& best = kKernels[static_cast<int>(BestIsa())];
+  const MicroKernel* kernel = forced.load(std::memory_order_acquire);
+  return kernel != nullptr ? *kernel : best;
+}
+
+// Packing buffers, grown on demand and reused across calls.
+class Buffer {
+ public:
+  double* Get(size_t count) {
+    if (count > size_) {
+      std::free(data_);
+      size_t bytes = (count * sizeof(double) + 63) / 64 * 64;
+      data_ = static_cast<double*>(std::aligned_alloc(64, bytes));
+      if (data_ == nullptr) throw std::bad_alloc();
+      size_ = count;
+    }
+    return data_;
+  }
+  ~Buffer() { std::free(data_); }
+
+ private:
+  double* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// A matrix operand as element strides, so that transposition is a swap.
+struct View {
+  const double* data;
+  long rs;
+  long cs;
+
+  double operator()(int i, int j) const { return data[i * rs + j * cs]; }
+};
+
+View MakeView(Trans trans, const double* data, int ld) {
+  return trans == Trans::kNo ? View{data, ld, 1} : View{data, 1, ld};
+}
+
+// Packs rows [i0, i0 + mc) x columns [p0, p0 + kc) of A into micro-panels of
+// MR rows stored column by column, zero-padding the last panel.
+void PackA(const View& a, int i0, int mc, int p0, int kc, int mr, double* dst) {
+  for (int ir = 0; ir < mc; ir += mr) {
+    int rows = std::min(mr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int i = 0; i < rows; ++i) dst[i] = a(i0 + ir + i, p0 + p);
+      for (int i = rows; i < mr; ++i) dst[i] = 0.0;
+      dst += mr;
+    }
+  }
+}
+
+// Packs rows [p0, p0 + kc) x columns [j0, j0 + nc) of B into micro-panels of
+// NR columns stored row by row, zero-padding the last panel.
+void PackB(const View& b, int p0, int kc, int j0, int nc, int nr, double* dst) {
+  for (int jr = 0; jr < nc; jr += nr) {
+    int cols = std::min(nr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      if (b.cs == 1) {
+        const double* src = b.data + (p0 + p) * b.rs + j0 + jr;
+        for (int j = 0; j < cols; ++j) dst[j] = src[j];
+      } else {
+        for (int j = 0; j < cols; ++j) dst[j] = b(p0 + p, j0 + jr + j);
+      }
+      for (int j = cols; j < nr; ++j) dst[j] = 0.0;
+      dst += nr;
+    }
+  }
+}
+
+// Blocked driver shared by Dgemm and DgemmLower. With `lower`, micro-tiles
+// strictly above the diagonal are skipped and tiles crossing it are computed
+// aside and merged on and below the diagonal only.
+void Driver(const View& a, const View& b, int m, int n, int k, double alpha,
+            double beta, double* c, long ldc, bool lower) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || alpha == 0.0) {
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < (lower ? std::min(i + 1, n) : n); ++j) {
+        c[i * ldc + j] = beta == 0.0 ? 0.0 : beta * c[i * ldc + j];
+      }
+    }
+    return;
+  }
+
+  const MicroKernel& kernel = Selected();
+  const int mr = kernel.mr;
+  const int nr = kernel.nr;
+  thread_local Buffer a_buffer;
+  thread_local Buffer b_buffer;
+  const int kc_max = std::min(k, kKc);
+  double* a_pack =
+      a_buffer.Get(static_cast<size_t>(kc_max) * ((std::min(m, kMc) + mr - 1) / mr * mr));
+  double* b_pack =
+      b_buffer.Get(static_cast<size_t>(kc_max) * ((std::min(n, kNc) + nr - 1) / nr * nr));
+  alignas(64) double tile[kMaxMr * kMaxNr];
+
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      // beta applies to the first rank-kc update only.
+      const double beta_pc = pc == 0 ? beta : 1.0;
+      PackB(b, pc, kc, jc, nc, nr, b_pack);
+      for (int ic = 0; ic < m; ic += kMc) {
+        const int mc = std::min(kMc, m - ic);
+        if (lower && jc > ic + mc - 1) continue;
+        PackA(a, ic, mc, pc, kc, mr, a_pack);
+        for (int jr = 0; jr < nc; jr += nr) {
+          const int cols = std::min(nr, nc - jr);
+          const int j0 = jc + jr;
+          for (int ir = 0; ir < mc; ir += mr) {
+            const int rows = std::min(mr, mc - ir);
+            const int i0 = ic + ir;
+            if (lower && j0 > i0 + rows - 1) continue;
+            const double* a_panel = a_pack + static_cast<long>(ir) * kc;
+            const double* b_panel = b_pack + static_cast<long>(jr) * kc;
+            double* c_tile = c + i0 * ldc + j0;
+            bool full = rows == mr && cols == nr && !(lower && j0 + nr - 1 > i0);
+            if (full) {
+              kernel.fn(kc, a_panel, b_panel, alpha, beta_pc, c_tile, ldc);
+              continue;
+            }
+            kernel.fn(kc, a_panel, b_panel, alpha, 0.0, tile, nr);
+            for (int i = 0; i < rows; ++i) {
+              int end = lower ? std::min(cols, i0 + i - j0 + 1) : cols;
+              for (int j = 0; j < end; ++j) {
+                double& dst = c_tile[i * ldc + j];
+                dst = beta_pc == 0.0 ? tile[i * nr + j]
+                                     : tile[i * nr + j] + beta_pc * dst;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  if (Supported(Isa::kAvx2)) return Isa::kAvx2;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kKernels[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx2: return "avx2";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void Dgemm(Trans trans_a, Trans trans_b, int m, int n, int k, double alpha,
+           const double* a, int lda, const double* b, int ldb, double beta,
+           double* c, int ldc) {
+  Driver(MakeView(trans_a, a, lda), MakeView(trans_b, b, ldb), m, n, k, alpha,
+         beta, c, ldc, false);
+}
+
+void DgemmLower(Trans trans_a, Trans trans_b, int n, int k, double alpha,
+                const double* a, int lda, const double* b, int ldb,
+                double beta, double* c, int ldc) {
+  Driver(MakeView(trans_a, a, lda), MakeView(trans_b, b, ldb), n, n, k, alpha,
+         beta, c, ldc, true);
+}
+
+void Dsyrk(int n, int k, double alpha, const double* a, int lda, double beta,
+           double* c, int ldc) {
+  DgemmLower(Trans::kNo, Trans::kYes, n, k, alpha, a, lda, a, lda, beta, c,
+             ldc);
+}
+
+void Dsyr2k(int n, int k, double alpha, const double* a, int lda,
+            const double* b, int ldb, double beta, double* c, int ldc) {
+  DgemmLower(Trans::kNo, Trans::kYes, n, k, alpha, a, lda, b, ldb, beta, c,
+             ldc);
+  DgemmLower(Trans::kNo, Trans::kYes, n, k, alpha, b, ldb, a, lda, 1.0, c,
+             ldc);
+}
+
+void Dtrmm(int m, int n, double alpha, const double* a, int lda, double* b,
+           int ldb) {
+  if (m <= 0 || n <= 0) return;
+  thread_local Buffer tile_buffer;
+  thread_local Buffer rows_buffer;
+  // Blocks go down the rows: a block reads the rows below it, which are
+  // still unchanged, and a copy of its own.
+  for (int i0 = 0; i0 < m; i0 += kMc) {
+    const int mb = std::min(kMc, m - i0);
+    const int i1 = i0 + mb;
+    double* rows = rows_buffer.Get(static_cast<size_t>(mb) * n);
+    double* tile = tile_buffer.Get(static_cast<size_t>(mb) * mb);
+    for (int i = 0; i < mb; ++i) {
+      std::copy(b + (i0 + i) * static_cast<long>(ldb),
+                b + (i0 + i) * static_cast<long>(ldb) + n, rows + i * n);
+      for (int j = 0; j < mb; ++j) {
+        tile[i * mb + j] = j > i ? a[(i0 + j) * static_cast<long>(lda) + i0 + i]
+                                 : 0.0;
+      }
+    }
+    double* b_block = b + i0 * static_cast<long>(ldb);
+    Dgemm(Trans::kYes, Trans::kNo, mb, n, m - i1, alpha,
+          a + i1 * static_cast<long>(lda) + i0, lda,
+          b + i1 * static_cast<long>(ldb), ldb, alpha, b_block, ldb);
+    Dgemm(Trans::kNo, Trans::kNo, mb, n, mb, alpha, tile, mb, rows, n, 1.0,
+          b_block, ldb);
+  }
+}
+
+void Dsymm(int m, int n, double alpha, const double* a, int lda,
+           const double* b, int ldb, double beta, double* c, int ldc) {
+  if (m <= 0 || n <= 0) return;
+  thread_local Buffer tile_buffer;
+  for (int i0 = 0; i0 < m; i0 += kMc) {
+    const int mb = std::min(kMc, m - i0);
+    const int i1 = i0 + mb;
+    double* tile = tile_buffer.Get(static_cast<size_t>(mb) * mb);
+    for (int i = 0; i < mb; ++i) {
+      for (int j = 0; j < mb; ++j) {
+        tile[i * mb + j] =
+            j <= i ? a[(i0 + i) * static_cast<long>(lda) + i0 + j]
+                   : a[(i0 + j) * static_cast<long>(lda) + i0 + i];
+      }
+    }
+    double* c_block = c + i0 * static_cast<long>(ldc);
+    Dgemm(Trans::kNo, Trans::kNo, mb, n, i0, alpha,
+          a + i0 * static_cast<long>(lda), lda, b, ldb, beta, c_block, ldc);
+    Dgemm(Trans::kNo, Trans::kNo, mb, n, mb, alpha, tile, mb,
+          b + i0 * static_cast<long>(ldb), ldb, 1.0, c_block, ldc);
+    Dgemm(Trans::kYes, Trans::kNo, mb, n, m - i1, alpha,
+          a + i1 * static_cast<long>(lda) + i0, lda,
+          b + i1 * static_cast<long>(ldb), ldb, 1.0, c_block, ldc);
+  }
+}
+
+}  // namespace gemm
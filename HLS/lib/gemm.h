@@ -0,0 +1,63 @@
+#ifndef GEMM_H_
+#define GEMM_H_
+
+// Double-precision GEMM engine for the CPU references of the matrix-multiply
+// kernels. Operands are packed into contiguous panels, blocked for the caches
+// and multiplied by a register-blocked micro-kernel selected at run time
+// (AVX-512, AVX2/FMA or portable C++). All matrices are row-major.
+namespace gemm {
+
+enum class Trans { kNo, kYes };
+
+enum class Isa { kGeneric, kAvx2, kAvx512 };
+
+// The widest micro-kernel the CPU supports.
+Isa BestIsa();
+// The micro-kernel in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces a micro-kernel, e.g. to test every path on one machine. Returns false
+// and keeps the current one when the CPU lacks the instructions.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+// C := alpha * op(A) * op(B) + beta * C, where op(A) is m x k, op(B) is k x n
+// and C is m x n. C is not read when beta is zero.
+void Dgemm(Trans trans_a, Trans trans_b, int m, int n, int k, double alpha,
+           const double* a, int lda, const double* b, int ldb, double beta,
+           double* c, int ldc);
+
+// As Dgemm for square C, but only the lower triangle (j <= i) is computed and
+// written; the strict upper triangle of C is left untouched.
+void DgemmLower(Trans trans_a, Trans trans_b, int n, int k, double alpha,
+                const double* a, int lda, const double* b, int ldb,
+                double beta, double* c, int ldc);
+
+// Lower triangle of C := alpha * A * A^T + beta * C, A is n x k.
+void Dsyrk(int n, int k, double alpha, const double* a, int lda, double beta,
+           double* c, int ldc);
+
+// Lower triangle of C := alpha * (A * B^T + B * A^T) + beta * C, A and B are
+// n x k.
+void Dsyr2k(int n, int k, double alpha, const double* a, int lda,
+            const double* b, int ldb, double beta, double* c, int ldc);
+
+// B := alpha * (I + L^T) * B in place, where L is the strictly lower
+// triangle of the m x m matrix A, as kernel_trmm computes it; the diagonal
+// and upper triangle of A are not read. B is m x n. Only the tiles of L are
+// multiplied: each block of rows is one GEMM with the rows below it and one
+// with its diagonal tile, expanded to a zero-filled square.
+void Dtrmm(int m, int n, double alpha, const double* a, int lda, double* b,
+           int ldb);
+
+// C := alpha * S * B + beta * C, where S is the symmetric m x m matrix stored
+// in the lower triangle (diagonal included) of A, as kernel_symm computes it;
+// the upper triangle of A is not read. B and C are m x n. Each block of rows
+// of C is a GEMM with the tiles of A left of the diagonal, one with the
+// diagonal tile mirrored into a square, and a transposed one with the tiles
+// below it.
+void Dsymm(int m, int n, double alpha, const double* a, int lda,
+           const double* b, int ldb, double beta, double* c, int ldc);
+
+}  // namespace gemm
+
+#endif
@@ -0,0 +1,124 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "gemver.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using check::Arrays;
+
+namespace {
+
+// The sizes of the arrays of kernel_gemver in signature order: A, u1, v1, u2,
+// v2, w, x, y, z.
+vector<size_t> Sizes(int n) {
+  vector<size_t> sizes(9, n);
+  sizes[0] = static_cast<size_t>(n) * n;
+  return sizes;
+}
+
+}  // namespace
+
+// Checks the fused gemver bit for bit against kernel_gemver, gemver-medium
+// and the reference loops, then times both on larger matrices:
+//   gemver [n...]
+int main(int argc, char** argv) {
+  vector<int> sizes;
+  for (int i = 1; i < argc; ++i) {
+    const int n = std::atoi(argv[i]);
+    if (n <= 0) {
+      clog << "Usage: " << argv[0] << " [n...]\n";
+      return EXIT_FAILURE;
+    }
+    sizes.push_back(n);
+  }
+  if (sizes.empty()) sizes = {400, 1000, 2000, 5000};
+
+  int error = 0;
+  kernels::Rng rng(42);
+  for (gemver::Isa isa : {gemver::Isa::kGeneric, gemver::Isa::kAvx512}) {
+    if (!gemver::SetIsa(isa)) continue;
+    clog << "Check " << gemver::IsaName(isa) << endl;
+    for (const string name : {"gemver", "gemver-medium"}) {
+      const kernels::Kernel& kernel = *kernels::FindKernel(name);
+      for (int seed = 1; seed <= 3; ++seed) {
+        kernels::Args args = kernels::MakeArgs(kernel, seed);
+        const int n = args.Value<int>(0);
+        const double alpha = args.Value<double>(1);
+        const double beta = args.Value<double>(2);
+        Arrays v;
+        for (int i = 3; i < args.Size(); ++i) {
+          const double* data = args.Ptr<double*>(i);
+          v.emplace_back(data, data + args.Count(i));
+        }
+        Arrays reference = v;
+        check::Call<9>(gemver::Reference, reference, n, alpha, beta);
+        check::Call<9>(gemver::Fused, v, n, alpha, beta);
+        kernel.run(args);
+        Arrays expected;
+        for (int i = 3; i < args.Size(); ++i) {
+          const double* data = args.Ptr<double*>(i);
+          expected.emplace_back(data, data + args.Count(i));
+        }
+        const string label = name + " seed " + std::to_string(seed);
+        if (!check::Same(reference, expected)) {
+          clog << label << ": reference differs from kernel_gemver" << endl;
+          ++error;
+        }
+        if (!check::Same(v, expected)) {
+          clog << label << ": fused version differs" << endl;
+          ++error;
+        }
+      }
+    }
+
+    for (int n : {1, 7, 8, 9, 15, 63, 64, 65, 130, 333}) {
+      Arrays v = check::Random(Sizes(n), rng);
+      Arrays expected = v;
+      check::Call<9>(gemver::Reference, expected, n, 1.5, 1.2);
+      check::Call<9>(gemver::Fused, v, n, 1.5, 1.2);
+      if (!check::Same(v, expected)) {
+        clog << "n " << n << ": fused version differs" << endl;
+        ++error;
+      }
+    }
+  }
+  gemver::SetIsa(gemver::BestIsa());
+
+  for (int n : sizes) {
+    const Arrays input = check::Random(Sizes(n), rng);
+    Arrays reference_result, v;
+    bench::Timing reference = bench::Measure(
+        0, 3, [&] { reference_result = input; },
+        [&] {
+          check::Call<9>(gemver::Reference, reference_result, n, 1.5, 1.2);
+        });
+    bench::Timing fused = bench::Measure(
+        1, 5, [&] { v = input; },
+        [&] { check::Call<9>(gemver::Fused, v, n, 1.5, 1.2); });
+    if (!check::Same(v, reference_result)) {
+      clog << "n " << n << ": fused version differs" << endl;
+      ++error;
+    }
+    cout << "n " << n << ": reference " << reference.median << " s, fused "
+         << fused.median << " s, speedup " << reference.median / fused.median
+         << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
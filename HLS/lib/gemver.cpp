@@ -0,0 +1,226 @@
+#include "gemver.h"
+
+#include <immintrin.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace gemver {
+
+namespace {
+
+// Fewest columns per thread in the first sweep.
+const int kMinStrip = 64;
+// Rows per band of the second sweep.
+const int kBand = 64;
+
+// Rows 0..n-1 over columns j0..j1: the rank-2 update of each row, then its
+// term of x += beta A^T y.
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+UpdateAvx512(int n, double beta, double* a, const double* u1,
+             const double* v1, const double* u2, const double* v2, double* x,
+             const double* y, int j0, int j1) {
+  const __m512d beta_v = _mm512_set1_pd(beta);
+  for (int i = 0; i < n; i++) {
+    double* row = a + static_cast<long>(i) * n;
+    const __m512d u1_v = _mm512_set1_pd(u1[i]);
+    const __m512d u2_v = _mm512_set1_pd(u2[i]);
+    const __m512d y_v = _mm512_set1_pd(y[i]);
+    int j = j0;
+    for (; j + 8 <= j1; j += 8) {
+      const __m512d rank2 =
+          _mm512_add_pd(_mm512_mul_pd(u1_v, _mm512_loadu_pd(v1 + j)),
+                        _mm512_mul_pd(u2_v, _mm512_loadu_pd(v2 + j)));
+      const __m512d updated = _mm512_add_pd(_mm512_loadu_pd(row + j), rank2);
+      _mm512_storeu_pd(row + j, updated);
+      const __m512d term = _mm512_mul_pd(_mm512_mul_pd(beta_v, updated), y_v);
+      _mm512_storeu_pd(x + j, _mm512_add_pd(_mm512_loadu_pd(x + j), term));
+    }
+    for (; j < j1; j++) {
+      row[j] += u1[i] * v1[j] + u2[i] * v2[j];
+      x[j] += beta * row[j] * y[i];
+    }
+  }
+}
+
+// w[i] += alpha * a[i][j] * x[j] for rows i0 .. i0 + 7, one per lane. Each
+// 8 x 8 tile is transposed in registers so that lane i meets its terms in
+// the order of j.
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+RowsAvx512(int n, double alpha, const double* a, const double* x, double* w,
+           int i0) {
+  const __m512i lo128 = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+  const __m512i hi128 = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+  const __m512i lo256 = _mm512_set_epi64(11, 10, 9, 8, 3, 2, 1, 0);
+  const __m512i hi256 = _mm512_set_epi64(15, 14, 13, 12, 7, 6, 5, 4);
+  const __m512d alpha_v = _mm512_set1_pd(alpha);
+  const double* rows = a + static_cast<long>(i0) * n;
+  __m512d acc = _mm512_loadu_pd(w + i0);
+  int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m512d r[8];
+    for (int k = 0; k < 8; ++k) r[k] = _mm512_loadu_pd(rows + k * n + j);
+    __m512d t[8];
+    for (int k = 0; k < 8; k += 2) {
+      t[k] = _mm512_unpacklo_pd(r[k], r[k + 1]);
+      t[k + 1] = _mm512_unpackhi_pd(r[k], r[k + 1]);
+    }
+    // u[0..3]: columns {0, 4}, {2, 6}, {1, 5}, {3, 7} of rows 0-3, then of
+    // rows 4-7 in u[4..7].
+    __m512d u[8];
+    for (int h = 0; h < 8; h += 4) {
+      u[h] = _mm512_permutex2var_pd(t[h], lo128, t[h + 2]);
+      u[h + 1] = _mm512_permutex2var_pd(t[h], hi128, t[h + 2]);
+      u[h + 2] = _mm512_permutex2var_pd(t[h + 1], lo128, t[h + 3]);
+      u[h + 3] = _mm512_permutex2var_pd(t[h + 1], hi128, t[h + 3]);
+    }
+    __m512d col[8];
+    const int first[4] = {0, 2, 1, 3};
+    for (int q = 0; q < 4; ++q) {
+      col[first[q]] = _mm512_permutex2var_pd(u[q], lo256, u[q + 4]);
+      col[first[q] + 4] = _mm512_permutex2var_pd(u[q], hi256, u[q + 4]);
+    }
+    for (int k = 0; k < 8; ++k) {
+      const __m512d term = _mm512_mul_pd(_mm512_mul_pd(alpha_v, col[k]),
+                                         _mm512_set1_pd(x[j + k]));
+      acc = _mm512_add_pd(acc, term);
+    }
+  }
+  alignas(64) double sum[8];
+  _mm512_store_pd(sum, acc);
+  for (int k = 0; k < 8; ++k) {
+    for (int jj = j; jj < n; jj++) {
+      sum[k] += alpha * rows[k * n + jj] * x[jj];
+    }
+    w[i0 + k] = sum[k];
+  }
+}
+
+void UpdateGeneric(int n, double beta, double* a, const double* u1,
+                   const double* v1, const double* u2, const double* v2,
+                   double* x, const double* y, int j0, int j1) {
+  for (int i = 0; i < n; i++) {
+    double* row = a + static_cast<long>(i) * n;
+    for (int j = j0; j < j1; j++) {
+      row[j] += u1[i] * v1[j] + u2[i] * v2[j];
+      x[j] += beta * row[j] * y[i];
+    }
+  }
+}
+
+// Eight rows as interleaved scalar chains.
+void RowsGeneric(int n, double alpha, const double* a, const double* x,
+                 double* w, int i0) {
+  const double* rows = a + static_cast<long>(i0) * n;
+  double sum[8];
+  for (int k = 0; k < 8; ++k) sum[k] = w[i0 + k];
+  for (int j = 0; j < n; j++) {
+    for (int k = 0; k < 8; ++k) sum[k] += alpha * rows[k * n + j] * x[j];
+  }
+  for (int k = 0; k < 8; ++k) w[i0 + k] = sum[k];
+}
+
+struct Engine {
+  Isa isa;
+  void (*update)(int n, double beta, double* a, const double* u1,
+                 const double* v1, const double* u2, const double* v2,
+                 double* x, const double* y, int j0, int j1);
+  void (*rows)(int n, double alpha, const double* a, const double* x,
+               double* w, int i0);
+};
+
+const Engine kEngines[] = {
+    {Isa::kGeneric, UpdateGeneric, RowsGeneric},
+    {Isa::kAvx512, UpdateAvx512, RowsAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa; Fused may be reading it on another thread.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void Reference(int n, double alpha, double beta, double* a, const double* u1,
+               const double* v1, const double* u2, const double* v2,
+               double* w, double* x, const double* y, const double* z) {
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a[i * n + j] += u1[i] * v1[j] + u2[i] * v2[j];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) x[i] += beta * a[j * n + i] * y[j];
+  }
+  for (int i = 0; i < n; i++) x[i] += z[i];
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) w[i] += alpha * a[i * n + j] * x[j];
+  }
+}
+
+void Fused(int n, double alpha, double beta, double* a, const double* u1,
+           const double* v1, const double* u2, const double* v2, double* w,
+           double* x, const double* y, const double* z) {
+  if (n <= 0) return;
+  const Engine& engine = Selected();
+  const int strips =
+      std::max(1, std::min(omp_get_max_threads(), n / kMinStrip));
+  // Strips of whole cache lines, so that no two threads share one of x.
+  const int width = (n + strips * 8 - 1) / (strips * 8) * 8;
+#pragma omp parallel for schedule(static)
+  for (int s = 0; s < strips; ++s) {
+    const int j0 = std::min(n, s * width);
+    engine.update(n, beta, a, u1, v1, u2, v2, x, y, j0,
+                  std::min(n, j0 + width));
+  }
+  for (int i = 0; i < n; i++) x[i] += z[i];
+
+  const int bands = (n + kBand - 1) / kBand;
+#pragma omp parallel for schedule(static)
+  for (int b = bands - 1; b >= 0; --b) {
+    const int i0 = b * kBand;
+    const int i1 = std::min(n, i0 + kBand);
+    int i = i0;
+    for (; i + 8 <= i1; i += 8) engine.rows(n, alpha, a, x, w, i);
+    for (; i < i1; i++) {
+      const double* row = a + static_cast<long>(i) * n;
+      for (int j = 0; j < n; j++) w[i] += alpha * row[j] * x[j];
+    }
+  }
+}
+
+}  // namespace gemver
@@ -0,0 +1,41 @@
+#ifndef GEMVER_H_
+#define GEMVER_H_
+
+// The vector multiplication and matrix addition of
+// data/sources/gemver_kernel.c (and gemver-medium) for any n x n row-major
+// A. Both versions leave A, w and x exactly as kernel_gemver does.
+namespace gemver {
+
+// The loop nest of kernel_gemver: A += u1 v1^T + u2 v2^T, x += beta A^T y,
+// x += z, w += alpha A x, each a separate sweep.
+void Reference(int n, double alpha, double beta, double* a, const double* u1,
+               const double* v1, const double* u2, const double* v2,
+               double* w, double* x, const double* y, const double* z);
+
+// Two sweeps over A instead of three. The first updates each row and adds
+// its share of beta A^T y to x while the row is in registers; x is summed in
+// row order as in the kernel, so the threads split the columns rather than
+// the rows. w needs the finished x, so A x is a second sweep, over bands of
+// rows in reverse so that it starts on the rows the first sweep left in the
+// cache (all of them when A fits, as for gemver-medium). There each SIMD
+// lane is a row, fed from 8 x 8 tiles of A transposed in registers, so
+// every w[i] still sums its terms in order. Products are not contracted, so
+// the results are bitwise identical.
+void Fused(int n, double alpha, double beta, double* a, const double* u1,
+           const double* v1, const double* u2, const double* v2, double* w,
+           double* x, const double* y, const double* z);
+
+enum class Isa { kGeneric, kAvx512 };
+
+// The widest instruction set the sweep kernels can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace gemver
+
+#endif
@@ -0,0 +1,92 @@
+#include "jobs.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace jobs {
+
+Graph::Id Graph::Add(std::function<void()> job, const std::vector<Id>& after) {
+  const Id id = Size();
+  for (Id before : after) {
+    if (before < 0 || before >= id) {
+      throw std::invalid_argument("job " + std::to_string(id) +
+                                  " depends on unknown job " +
+                                  std::to_string(before));
+    }
+  }
+  jobs_.push_back({std::move(job), {}, static_cast<int>(after.size())});
+  for (Id before : after) jobs_[before].dependents.push_back(id);
+  return id;
+}
+
+void Graph::Run(int workers) {
+  if (workers <= 0) {
+    workers = static_cast<int>(std::thread::hardware_concurrency());
+    workers = std::max(1, workers);
+  }
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::priority_queue<Id, std::vector<Id>, std::greater<Id>> ready;
+  std::vector<int> waiting(jobs_.size());
+  std::vector<bool> skipped(jobs_.size(), false);
+  int left = Size();
+  std::exception_ptr error;
+  for (Id id = 0; id < Size(); ++id) {
+    waiting[id] = jobs_[id].waiting;
+    if (waiting[id] == 0) ready.push(id);
+  }
+
+  // Called with the lock held once a job has run or been skipped.
+  std::function<void(Id, bool)> finish = [&](Id id, bool failed) {
+    --left;
+    for (Id next : jobs_[id].dependents) {
+      if (failed) skipped[next] = true;
+      if (--waiting[next] > 0) continue;
+      if (skipped[next]) {
+        finish(next, true);
+      } else {
+        ready.push(next);
+      }
+    }
+  };
+
+  auto work = [&] {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      changed.wait(lock, [&] { return !ready.empty() || left == 0; });
+      if (ready.empty()) return;
+      const Id id = ready.top();
+      ready.pop();
+      lock.unlock();
+      bool failed = false;
+      try {
+        jobs_[id].job();
+      } catch (...) {
+        failed = true;
+        lock.lock();
+        if (!error) error = std::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+      finish(id, failed);
+      changed.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < std::min(workers, std::max(1, Size())); ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (std::thread& thread : threads) thread.join();
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace jobs
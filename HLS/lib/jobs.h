@@ -0,0 +1,40 @@
+#ifndef JOBS_H_
+#define JOBS_H_
+
+#include <functional>
+#include <vector>
+
+// A graph of jobs run on a bounded pool of threads, for work such as compiling
+// and then checking many kernels, where each step waits on a compiler or a
+// child process rather than on the CPU of the calling thread.
+namespace jobs {
+
+class Graph {
+ public:
+  using Id = int;
+
+  // Adds a job that starts once every job in `after`, which must have been
+  // added before, has finished.
+  Id Add(std::function<void()> job, const std::vector<Id>& after = {});
+
+  // Runs every job on `workers` threads, one per core when 0, and returns
+  // when all have finished. Of the ready jobs, the one added first starts
+  // first. If jobs throw, the jobs that depend on them are skipped and the
+  // first exception is rethrown once the others are done.
+  void Run(int workers = 0);
+
+  int Size() const { return static_cast<int>(jobs_.size()); }
+
+ private:
+  struct Node {
+    std::function<void()> job;
+    std::vector<Id> dependents;
+    int waiting = 0;
+  };
+
+  std::vector<Node> jobs_;
+};
+
+}  // namespace jobs
+
+#endif
@@ -0,0 +1,65 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using kernels::Args;
+using kernels::ArgSpec;
+using kernels::Kernel;
+
+// Lists the registry and runs the selected kernels (all by default) twice from
+// the same seed, checking that each run is reproducible.
+int main(int argc, char** argv) {
+  vector<const Kernel*> selected;
+  for (int i = 1; i < argc; ++i) {
+    const Kernel* kernel = kernels::FindKernel(argv[i]);
+    if (kernel == nullptr) {
+      clog << "Unknown kernel " << argv[i] << endl;
+      clog << "Usage: " << argv[0] << " [kernel...]\n";
+      return EXIT_FAILURE;
+    }
+    selected.push_back(kernel);
+  }
+  if (selected.empty()) {
+    for (const Kernel& kernel : kernels::Registry()) selected.push_back(&kernel);
+  }
+
+  int error = 0;
+  for (const Kernel* kernel : selected) {
+    cout << kernel->name << ": " << kernel->function << "(";
+    for (size_t i = 0; i < kernel->args.size(); ++i) {
+      const ArgSpec& arg = kernel->args[i];
+      cout << (i ? ", " : "") << kernels::TypeName(arg.type) << " " << arg.name;
+      for (int d : arg.shape) cout << "[" << d << "]";
+    }
+    cout << ")" << endl;
+
+    Args first = kernels::MakeArgs(*kernel);
+    Args second = first;
+    kernel->run(first);
+    kernel->run(second);
+    for (int i = 0; i < first.Size(); ++i) {
+      if (std::memcmp(first.Data(i), second.Data(i), first.Bytes(i)) != 0) {
+        clog << "Run of " << kernel->name << " is not reproducible in "
+             << first.Spec(i).name << endl;
+        ++error;
+      }
+    }
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
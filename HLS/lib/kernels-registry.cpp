@@ -0,0 +1,2035 @@
+// Generated by gen_kernels.py from data/sources. Do not edit.
+
+// Kernel sources include <math.h> themselves; pull it in at global
+// scope first so that the per-kernel namespaces only hold kernel code.
+#include <math.h>
+
+#include "kernels.h"
+
+namespace kernels {
+
+namespace k_2mm {
+#include "../../data/sources/2mm_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 50;
+  args.Value<int>(2) = 70;
+  args.Value<int>(3) = 80;
+  args.Value<double>(4) = 1.5;
+  args.Value<double>(5) = 1.2;
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+}
+
+void Run(Args& args) {
+  kernel_2mm(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<double>(4),
+      args.Value<double>(5),
+      args.Ptr<double(*)[50]>(6),
+      args.Ptr<double(*)[70]>(7),
+      args.Ptr<double(*)[50]>(8),
+      args.Ptr<double(*)[80]>(9),
+      args.Ptr<double(*)[80]>(10));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_2mm)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<double>(4),
+      args.Value<double>(5),
+      args.Ptr<double(*)[50]>(6),
+      args.Ptr<double(*)[70]>(7),
+      args.Ptr<double(*)[50]>(8),
+      args.Ptr<double(*)[80]>(9),
+      args.Ptr<double(*)[80]>(10));
+}
+}  // namespace k_2mm
+
+namespace k_3mm {
+#include "../../data/sources/3mm_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 50;
+  args.Value<int>(2) = 60;
+  args.Value<int>(3) = 70;
+  args.Value<int>(4) = 80;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+void Run(Args& args) {
+  kernel_3mm(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<int>(4),
+      args.Ptr<double(*)[50]>(5),
+      args.Ptr<double(*)[60]>(6),
+      args.Ptr<double(*)[50]>(7),
+      args.Ptr<double(*)[70]>(8),
+      args.Ptr<double(*)[80]>(9),
+      args.Ptr<double(*)[70]>(10),
+      args.Ptr<double(*)[70]>(11));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_3mm)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<int>(4),
+      args.Ptr<double(*)[50]>(5),
+      args.Ptr<double(*)[60]>(6),
+      args.Ptr<double(*)[50]>(7),
+      args.Ptr<double(*)[70]>(8),
+      args.Ptr<double(*)[80]>(9),
+      args.Ptr<double(*)[70]>(10),
+      args.Ptr<double(*)[70]>(11));
+}
+}  // namespace k_3mm
+
+namespace k_adi {
+#include "../../data/sources/adi_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 60;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+void Run(Args& args) {
+  kernel_adi(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[60]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[60]>(4),
+      args.Ptr<double(*)[60]>(5));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_adi)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[60]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[60]>(4),
+      args.Ptr<double(*)[60]>(5));
+}
+}  // namespace k_adi
+
+namespace k_aes {
+#include "../../data/sources/aes_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillBytes(args.Ptr<unsigned char*>(0), args.Count(0), rng);
+  FillBytes(args.Ptr<unsigned char*>(1), args.Count(1), rng);
+  FillBytes(args.Ptr<unsigned char*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  aes256_encrypt_ecb(
+      args.Ptr<k_aes::aes256_context*>(0),
+      args.Ptr<unsigned char*>(1),
+      args.Ptr<unsigned char*>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&aes256_encrypt_ecb)>(function)(
+      args.Ptr<k_aes::aes256_context*>(0),
+      args.Ptr<unsigned char*>(1),
+      args.Ptr<unsigned char*>(2));
+}
+}  // namespace k_aes
+
+namespace k_atax {
+#include "../../data/sources/atax_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 116;
+  args.Value<int>(1) = 124;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+void Run(Args& args) {
+  kernel_atax(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[124]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_atax)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[124]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5));
+}
+}  // namespace k_atax
+
+namespace k_atax_medium {
+#include "../../data/sources/atax-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  kernel_atax(
+      args.Ptr<double(*)[410]>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_atax)>(function)(
+      args.Ptr<double(*)[410]>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+}  // namespace k_atax_medium
+
+namespace k_bicg {
+#include "../../data/sources/bicg_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 124;
+  args.Value<int>(1) = 116;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_bicg(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[116]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[116]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_bicg
+
+namespace k_bicg_large {
+#include "../../data/sources/bicg-large_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 410;
+  args.Value<int>(1) = 390;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_bicg(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[390]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[390]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_bicg_large
+
+namespace k_bicg_medium {
+#include "../../data/sources/bicg-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 410;
+  args.Value<int>(1) = 390;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_bicg(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[390]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[390]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_bicg_medium
+
+namespace k_correlation {
+#include "../../data/sources/correlation_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 100.0;
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_correlation(
+      args.Value<double>(0),
+      args.Ptr<double(*)[80]>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_correlation)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[80]>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+}  // namespace k_correlation
+
+namespace k_covariance {
+#include "../../data/sources/covariance_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 80;
+  args.Value<int>(1) = 100;
+  args.Value<double>(2) = 100.0;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+void Run(Args& args) {
+  kernel_covariance(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[80]>(3),
+      args.Ptr<double(*)[80]>(4),
+      args.Ptr<double*>(5));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_covariance)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[80]>(3),
+      args.Ptr<double(*)[80]>(4),
+      args.Ptr<double*>(5));
+}
+}  // namespace k_covariance
+
+namespace k_doitgen {
+#include "../../data/sources/doitgen_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 25;
+  args.Value<int>(1) = 20;
+  args.Value<int>(2) = 30;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+void Run(Args& args) {
+  kernel_doitgen(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[20][30]>(3),
+      args.Ptr<double(*)[30]>(4),
+      args.Ptr<double*>(5));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_doitgen)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[20][30]>(3),
+      args.Ptr<double(*)[30]>(4),
+      args.Ptr<double*>(5));
+}
+}  // namespace k_doitgen
+
+namespace k_doitgen_red {
+#include "../../data/sources/doitgen-red_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  kernel_doitgen(
+      args.Ptr<double(*)[20][30]>(0),
+      args.Ptr<double(*)[30]>(1),
+      args.Ptr<double*>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_doitgen)>(function)(
+      args.Ptr<double(*)[20][30]>(0),
+      args.Ptr<double(*)[30]>(1),
+      args.Ptr<double*>(2));
+}
+}  // namespace k_doitgen_red
+
+namespace k_fdtd_2d {
+#include "../../data/sources/fdtd-2d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 60;
+  args.Value<int>(2) = 80;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_fdtd_2d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[80]>(3),
+      args.Ptr<double(*)[80]>(4),
+      args.Ptr<double(*)[80]>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_fdtd_2d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[80]>(3),
+      args.Ptr<double(*)[80]>(4),
+      args.Ptr<double(*)[80]>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_fdtd_2d
+
+namespace k_fdtd_2d_large {
+#include "../../data/sources/fdtd-2d-large_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 100;
+  args.Value<int>(1) = 200;
+  args.Value<int>(2) = 240;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_fdtd_2d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[240]>(3),
+      args.Ptr<double(*)[240]>(4),
+      args.Ptr<double(*)[240]>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_fdtd_2d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[240]>(3),
+      args.Ptr<double(*)[240]>(4),
+      args.Ptr<double(*)[240]>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_fdtd_2d_large
+
+namespace k_gemm_blocked {
+#include "../../data/sources/gemm-blocked_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  bbgemm(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&bbgemm)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+}  // namespace k_gemm_blocked
+
+namespace k_gemm_ncubed {
+#include "../../data/sources/gemm-ncubed_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  gemm(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&gemm)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+}  // namespace k_gemm_ncubed
+
+namespace k_gemm_p {
+#include "../../data/sources/gemm-p_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 60;
+  args.Value<int>(1) = 70;
+  args.Value<int>(2) = 80;
+  args.Value<double>(3) = 1.5;
+  args.Value<double>(4) = 1.2;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+void Run(Args& args) {
+  kernel_gemm(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[70]>(5),
+      args.Ptr<double(*)[80]>(6),
+      args.Ptr<double(*)[70]>(7));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemm)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[70]>(5),
+      args.Ptr<double(*)[80]>(6),
+      args.Ptr<double(*)[70]>(7));
+}
+}  // namespace k_gemm_p
+
+namespace k_gemm_p_large {
+#include "../../data/sources/gemm-p-large_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 200;
+  args.Value<int>(1) = 220;
+  args.Value<int>(2) = 240;
+  args.Value<double>(3) = 1.5;
+  args.Value<double>(4) = 1.2;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+void Run(Args& args) {
+  kernel_gemm(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[220]>(5),
+      args.Ptr<double(*)[240]>(6),
+      args.Ptr<double(*)[220]>(7));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemm)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[220]>(5),
+      args.Ptr<double(*)[240]>(6),
+      args.Ptr<double(*)[220]>(7));
+}
+}  // namespace k_gemm_p_large
+
+namespace k_gemver {
+#include "../../data/sources/gemver_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 120;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+void Run(Args& args) {
+  kernel_gemver(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[120]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemver)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[120]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+}  // namespace k_gemver
+
+namespace k_gemver_medium {
+#include "../../data/sources/gemver-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 400;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+void Run(Args& args) {
+  kernel_gemver(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[400]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemver)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[400]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+}  // namespace k_gemver_medium
+
+namespace k_gesummv {
+#include "../../data/sources/gesummv_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 90;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+void Run(Args& args) {
+  kernel_gesummv(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[90]>(3),
+      args.Ptr<double(*)[90]>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gesummv)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[90]>(3),
+      args.Ptr<double(*)[90]>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7));
+}
+}  // namespace k_gesummv
+
+namespace k_gesummv_medium {
+#include "../../data/sources/gesummv-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+void Run(Args& args) {
+  kernel_gesummv(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[250]>(2),
+      args.Ptr<double(*)[250]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gesummv)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[250]>(2),
+      args.Ptr<double(*)[250]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+}  // namespace k_gesummv_medium
+
+namespace k_heat_3d {
+#include "../../data/sources/heat-3d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 20;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  kernel_heat_3d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[20][20]>(2),
+      args.Ptr<double(*)[20][20]>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_heat_3d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[20][20]>(2),
+      args.Ptr<double(*)[20][20]>(3));
+}
+}  // namespace k_heat_3d
+
+namespace k_jacobi_1d {
+#include "../../data/sources/jacobi-1d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 120;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  kernel_jacobi_1d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_jacobi_1d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+}  // namespace k_jacobi_1d
+
+namespace k_jacobi_2d {
+#include "../../data/sources/jacobi-2d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 90;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  kernel_jacobi_2d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[90]>(2),
+      args.Ptr<double(*)[90]>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_jacobi_2d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[90]>(2),
+      args.Ptr<double(*)[90]>(3));
+}
+}  // namespace k_jacobi_2d
+
+namespace k_md {
+#include "../../data/sources/md_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillIndex(args.Ptr<int*>(6), args.Count(6), 256, rng);
+}
+
+void Run(Args& args) {
+  md_kernel(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<int*>(6));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&md_kernel)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<int*>(6));
+}
+}  // namespace k_md
+
+namespace k_mvt {
+#include "../../data/sources/mvt_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_mvt(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[120]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_mvt)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[120]>(4));
+}
+}  // namespace k_mvt
+
+namespace k_mvt_medium {
+#include "../../data/sources/mvt-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_mvt(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[400]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_mvt)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[400]>(4));
+}
+}  // namespace k_mvt_medium
+
+namespace k_nw {
+#include "../../data/sources/nw_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillSequence(args.Ptr<char*>(0), args.Count(0), rng);
+  FillSequence(args.Ptr<char*>(1), args.Count(1), rng);
+  FillSequence(args.Ptr<char*>(2), args.Count(2), rng);
+  FillSequence(args.Ptr<char*>(3), args.Count(3), rng);
+  FillInt(args.Ptr<int*>(4), args.Count(4), -100, 100, rng);
+  FillSequence(args.Ptr<char*>(5), args.Count(5), rng);
+}
+
+void Run(Args& args) {
+  needwun(
+      args.Ptr<char*>(0),
+      args.Ptr<char*>(1),
+      args.Ptr<char*>(2),
+      args.Ptr<char*>(3),
+      args.Ptr<int*>(4),
+      args.Ptr<char*>(5));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&needwun)>(function)(
+      args.Ptr<char*>(0),
+      args.Ptr<char*>(1),
+      args.Ptr<char*>(2),
+      args.Ptr<char*>(3),
+      args.Ptr<int*>(4),
+      args.Ptr<char*>(5));
+}
+}  // namespace k_nw
+
+namespace k_seidel_2d {
+#include "../../data/sources/seidel-2d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = 40;
+  args.Value<int>(1) = 120;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  kernel_seidel_2d(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[120]>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_seidel_2d)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[120]>(2));
+}
+}  // namespace k_seidel_2d
+
+namespace k_spmv_crs {
+#include "../../data/sources/spmv-crs_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillIndex(args.Ptr<int*>(1), args.Count(1), 494, rng);
+  FillRowDelimiters(args.Ptr<int*>(2), 494, 1666, rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  spmv(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&spmv)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+}  // namespace k_spmv_crs
+
+namespace k_spmv_ellpack {
+#include "../../data/sources/spmv-ellpack_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillIndex(args.Ptr<int*>(1), args.Count(1), 494, rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  ellpack(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&ellpack)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+}  // namespace k_spmv_ellpack
+
+namespace k_stencil {
+#include "../../data/sources/stencil_stencil2d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  FillInt(args.Ptr<int*>(0), args.Count(0), -100, 100, rng);
+  FillInt(args.Ptr<int*>(1), args.Count(1), -100, 100, rng);
+  FillInt(args.Ptr<int*>(2), args.Count(2), -100, 100, rng);
+}
+
+void Run(Args& args) {
+  stencil(
+      args.Ptr<int*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&stencil)>(function)(
+      args.Ptr<int*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2));
+}
+}  // namespace k_stencil
+
+namespace k_stencil_3d {
+#include "../../data/sources/stencil-3d_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<long>(0) = 2;
+  args.Value<long>(1) = -1;
+  FillInt(args.Ptr<long*>(2), args.Count(2), -100L, 100L, rng);
+  FillInt(args.Ptr<long*>(3), args.Count(3), -100L, 100L, rng);
+}
+
+void Run(Args& args) {
+  stencil3d(
+      args.Value<long>(0),
+      args.Value<long>(1),
+      args.Ptr<long*>(2),
+      args.Ptr<long*>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&stencil3d)>(function)(
+      args.Value<long>(0),
+      args.Value<long>(1),
+      args.Ptr<long*>(2),
+      args.Ptr<long*>(3));
+}
+}  // namespace k_stencil_3d
+
+namespace k_symm {
+#include "../../data/sources/symm_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_symm(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[80]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[80]>(4));
+}
+}  // namespace k_symm
+
+namespace k_symm_opt {
+#include "../../data/sources/symm-opt_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_symm(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[80]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[80]>(4));
+}
+}  // namespace k_symm_opt
+
+namespace k_symm_opt_medium {
+#include "../../data/sources/symm-opt-medium_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_symm(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[240]>(2),
+      args.Ptr<double(*)[200]>(3),
+      args.Ptr<double(*)[240]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[240]>(2),
+      args.Ptr<double(*)[200]>(3),
+      args.Ptr<double(*)[240]>(4));
+}
+}  // namespace k_symm_opt_medium
+
+namespace k_syr2k {
+#include "../../data/sources/syr2k_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+void Run(Args& args) {
+  kernel_syr2k(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[60]>(4));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_syr2k)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3),
+      args.Ptr<double(*)[60]>(4));
+}
+}  // namespace k_syr2k
+
+namespace k_syrk {
+#include "../../data/sources/syrk_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+void Run(Args& args) {
+  kernel_syrk(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_syrk)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[80]>(2),
+      args.Ptr<double(*)[60]>(3));
+}
+}  // namespace k_syrk
+
+namespace k_trmm {
+#include "../../data/sources/trmm_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  kernel_trmm(
+      args.Value<double>(0),
+      args.Ptr<double(*)[60]>(1),
+      args.Ptr<double(*)[80]>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_trmm)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[60]>(1),
+      args.Ptr<double(*)[80]>(2));
+}
+}  // namespace k_trmm
+
+namespace k_trmm_opt {
+#include "../../data/sources/trmm-opt_kernel.c"
+
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+void Run(Args& args) {
+  kernel_trmm(
+      args.Value<double>(0),
+      args.Ptr<double(*)[60]>(1),
+      args.Ptr<double(*)[80]>(2));
+}
+
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_trmm)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[60]>(1),
+      args.Ptr<double(*)[80]>(2));
+}
+}  // namespace k_trmm_opt
+
+const std::vector<Kernel>& Registry() {
+  static const std::vector<Kernel> registry = {
+      {
+          "2mm",
+          "2mm_kernel.c",
+          "kernel_2mm",
+          {
+              {"ni", Type::kInt, {}},
+              {"nj", Type::kInt, {}},
+              {"nk", Type::kInt, {}},
+              {"nl", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"tmp", Type::kDouble, {40, 50}},
+              {"A", Type::kDouble, {40, 70}},
+              {"B", Type::kDouble, {70, 50}},
+              {"C", Type::kDouble, {50, 80}},
+              {"D", Type::kDouble, {40, 80}},
+          },
+          k_2mm::Init,
+          k_2mm::Run,
+          k_2mm::Call,
+      },
+      {
+          "3mm",
+          "3mm_kernel.c",
+          "kernel_3mm",
+          {
+              {"ni", Type::kInt, {}},
+              {"nj", Type::kInt, {}},
+              {"nk", Type::kInt, {}},
+              {"nl", Type::kInt, {}},
+              {"nm", Type::kInt, {}},
+              {"E", Type::kDouble, {40, 50}},
+              {"A", Type::kDouble, {40, 60}},
+              {"B", Type::kDouble, {60, 50}},
+              {"F", Type::kDouble, {50, 70}},
+              {"C", Type::kDouble, {50, 80}},
+              {"D", Type::kDouble, {80, 70}},
+              {"G", Type::kDouble, {40, 70}},
+          },
+          k_3mm::Init,
+          k_3mm::Run,
+          k_3mm::Call,
+      },
+      {
+          "adi",
+          "adi_kernel.c",
+          "kernel_adi",
+          {
+              {"tsteps", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"u", Type::kDouble, {60, 60}},
+              {"v", Type::kDouble, {60, 60}},
+              {"p", Type::kDouble, {60, 60}},
+              {"q", Type::kDouble, {60, 60}},
+          },
+          k_adi::Init,
+          k_adi::Run,
+          k_adi::Call,
+      },
+      {
+          "aes",
+          "aes_kernel.c",
+          "aes256_encrypt_ecb",
+          {
+              {"ctx", Type::kUChar, {static_cast<int>(sizeof(k_aes::aes256_context))}},
+              {"k", Type::kUChar, {32}},
+              {"buf", Type::kUChar, {16}},
+          },
+          k_aes::Init,
+          k_aes::Run,
+          k_aes::Call,
+      },
+      {
+          "atax",
+          "atax_kernel.c",
+          "kernel_atax",
+          {
+              {"m", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {116, 124}},
+              {"x", Type::kDouble, {124}},
+              {"y", Type::kDouble, {124}},
+              {"tmp", Type::kDouble, {116}},
+          },
+          k_atax::Init,
+          k_atax::Run,
+          k_atax::Call,
+      },
+      {
+          "atax-medium",
+          "atax-medium_kernel.c",
+          "kernel_atax",
+          {
+              {"A", Type::kDouble, {390, 410}},
+              {"x", Type::kDouble, {410}},
+              {"y", Type::kDouble, {410}},
+              {"tmp", Type::kDouble, {390}},
+          },
+          k_atax_medium::Init,
+          k_atax_medium::Run,
+          k_atax_medium::Call,
+      },
+      {
+          "bicg",
+          "bicg_kernel.c",
+          "kernel_bicg",
+          {
+              {"m", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {124, 116}},
+              {"s", Type::kDouble, {116}},
+              {"q", Type::kDouble, {124}},
+              {"p", Type::kDouble, {116}},
+              {"r", Type::kDouble, {124}},
+          },
+          k_bicg::Init,
+          k_bicg::Run,
+          k_bicg::Call,
+      },
+      {
+          "bicg-large",
+          "bicg-large_kernel.c",
+          "kernel_bicg",
+          {
+              {"m", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {410, 390}},
+              {"s", Type::kDouble, {390}},
+              {"q", Type::kDouble, {410}},
+              {"p", Type::kDouble, {390}},
+              {"r", Type::kDouble, {410}},
+          },
+          k_bicg_large::Init,
+          k_bicg_large::Run,
+          k_bicg_large::Call,
+      },
+      {
+          "bicg-medium",
+          "bicg-medium_kernel.c",
+          "kernel_bicg",
+          {
+              {"m", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {410, 390}},
+              {"s", Type::kDouble, {390}},
+              {"q", Type::kDouble, {410}},
+              {"p", Type::kDouble, {390}},
+              {"r", Type::kDouble, {410}},
+          },
+          k_bicg_medium::Init,
+          k_bicg_medium::Run,
+          k_bicg_medium::Call,
+      },
+      {
+          "correlation",
+          "correlation_kernel.c",
+          "kernel_correlation",
+          {
+              {"float_n", Type::kDouble, {}},
+              {"data", Type::kDouble, {100, 80}},
+              {"corr", Type::kDouble, {80, 80}},
+              {"mean", Type::kDouble, {80}},
+              {"stddev", Type::kDouble, {80}},
+          },
+          k_correlation::Init,
+          k_correlation::Run,
+          k_correlation::Call,
+      },
+      {
+          "covariance",
+          "covariance_kernel.c",
+          "kernel_covariance",
+          {
+              {"m", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"float_n", Type::kDouble, {}},
+              {"data", Type::kDouble, {100, 80}},
+              {"cov", Type::kDouble, {80, 80}},
+              {"mean", Type::kDouble, {80}},
+          },
+          k_covariance::Init,
+          k_covariance::Run,
+          k_covariance::Call,
+      },
+      {
+          "doitgen",
+          "doitgen_kernel.c",
+          "kernel_doitgen",
+          {
+              {"nr", Type::kInt, {}},
+              {"nq", Type::kInt, {}},
+              {"np", Type::kInt, {}},
+              {"A", Type::kDouble, {25, 20, 30}},
+              {"C4", Type::kDouble, {30, 30}},
+              {"sum", Type::kDouble, {30}},
+          },
+          k_doitgen::Init,
+          k_doitgen::Run,
+          k_doitgen::Call,
+      },
+      {
+          "doitgen-red",
+          "doitgen-red_kernel.c",
+          "kernel_doitgen",
+          {
+              {"A", Type::kDouble, {25, 20, 30}},
+              {"C4", Type::kDouble, {30, 30}},
+              {"sum", Type::kDouble, {30}},
+          },
+          k_doitgen_red::Init,
+          k_doitgen_red::Run,
+          k_doitgen_red::Call,
+      },
+      {
+          "fdtd-2d",
+          "fdtd-2d_kernel.c",
+          "kernel_fdtd_2d",
+          {
+              {"tmax", Type::kInt, {}},
+              {"nx", Type::kInt, {}},
+              {"ny", Type::kInt, {}},
+              {"ex", Type::kDouble, {60, 80}},
+              {"ey", Type::kDouble, {60, 80}},
+              {"hz", Type::kDouble, {60, 80}},
+              {"_fict_", Type::kDouble, {40}},
+          },
+          k_fdtd_2d::Init,
+          k_fdtd_2d::Run,
+          k_fdtd_2d::Call,
+      },
+      {
+          "fdtd-2d-large",
+          "fdtd-2d-large_kernel.c",
+          "kernel_fdtd_2d",
+          {
+              {"tmax", Type::kInt, {}},
+              {"nx", Type::kInt, {}},
+              {"ny", Type::kInt, {}},
+              {"ex", Type::kDouble, {200, 240}},
+              {"ey", Type::kDouble, {200, 240}},
+              {"hz", Type::kDouble, {200, 240}},
+              {"_fict_", Type::kDouble, {100}},
+          },
+          k_fdtd_2d_large::Init,
+          k_fdtd_2d_large::Run,
+          k_fdtd_2d_large::Call,
+      },
+      {
+          "gemm-blocked",
+          "gemm-blocked_kernel.c",
+          "bbgemm",
+          {
+              {"m1", Type::kDouble, {4096}},
+              {"m2", Type::kDouble, {4096}},
+              {"prod", Type::kDouble, {4096}},
+          },
+          k_gemm_blocked::Init,
+          k_gemm_blocked::Run,
+          k_gemm_blocked::Call,
+      },
+      {
+          "gemm-ncubed",
+          "gemm-ncubed_kernel.c",
+          "gemm",
+          {
+              {"m1", Type::kDouble, {4096}},
+              {"m2", Type::kDouble, {4096}},
+              {"prod", Type::kDouble, {4096}},
+          },
+          k_gemm_ncubed::Init,
+          k_gemm_ncubed::Run,
+          k_gemm_ncubed::Call,
+      },
+      {
+          "gemm-p",
+          "gemm-p_kernel.c",
+          "kernel_gemm",
+          {
+              {"ni", Type::kInt, {}},
+              {"nj", Type::kInt, {}},
+              {"nk", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {60, 70}},
+              {"A", Type::kDouble, {60, 80}},
+              {"B", Type::kDouble, {80, 70}},
+          },
+          k_gemm_p::Init,
+          k_gemm_p::Run,
+          k_gemm_p::Call,
+      },
+      {
+          "gemm-p-large",
+          "gemm-p-large_kernel.c",
+          "kernel_gemm",
+          {
+              {"ni", Type::kInt, {}},
+              {"nj", Type::kInt, {}},
+              {"nk", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {200, 220}},
+              {"A", Type::kDouble, {200, 240}},
+              {"B", Type::kDouble, {240, 220}},
+          },
+          k_gemm_p_large::Init,
+          k_gemm_p_large::Run,
+          k_gemm_p_large::Call,
+      },
+      {
+          "gemver",
+          "gemver_kernel.c",
+          "kernel_gemver",
+          {
+              {"n", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"A", Type::kDouble, {120, 120}},
+              {"u1", Type::kDouble, {120}},
+              {"v1", Type::kDouble, {120}},
+              {"u2", Type::kDouble, {120}},
+              {"v2", Type::kDouble, {120}},
+              {"w", Type::kDouble, {120}},
+              {"x", Type::kDouble, {120}},
+              {"y", Type::kDouble, {120}},
+              {"z", Type::kDouble, {120}},
+          },
+          k_gemver::Init,
+          k_gemver::Run,
+          k_gemver::Call,
+      },
+      {
+          "gemver-medium",
+          "gemver-medium_kernel.c",
+          "kernel_gemver",
+          {
+              {"n", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"A", Type::kDouble, {400, 400}},
+              {"u1", Type::kDouble, {400}},
+              {"v1", Type::kDouble, {400}},
+              {"u2", Type::kDouble, {400}},
+              {"v2", Type::kDouble, {400}},
+              {"w", Type::kDouble, {400}},
+              {"x", Type::kDouble, {400}},
+              {"y", Type::kDouble, {400}},
+              {"z", Type::kDouble, {400}},
+          },
+          k_gemver_medium::Init,
+          k_gemver_medium::Run,
+          k_gemver_medium::Call,
+      },
+      {
+          "gesummv",
+          "gesummv_kernel.c",
+          "kernel_gesummv",
+          {
+              {"n", Type::kInt, {}},
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"A", Type::kDouble, {90, 90}},
+              {"B", Type::kDouble, {90, 90}},
+              {"tmp", Type::kDouble, {90}},
+              {"x", Type::kDouble, {90}},
+              {"y", Type::kDouble, {90}},
+          },
+          k_gesummv::Init,
+          k_gesummv::Run,
+          k_gesummv::Call,
+      },
+      {
+          "gesummv-medium",
+          "gesummv-medium_kernel.c",
+          "kernel_gesummv",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"A", Type::kDouble, {250, 250}},
+              {"B", Type::kDouble, {250, 250}},
+              {"tmp", Type::kDouble, {250}},
+              {"x", Type::kDouble, {250}},
+              {"y", Type::kDouble, {250}},
+          },
+          k_gesummv_medium::Init,
+          k_gesummv_medium::Run,
+          k_gesummv_medium::Call,
+      },
+      {
+          "heat-3d",
+          "heat-3d_kernel.c",
+          "kernel_heat_3d",
+          {
+              {"tsteps", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {20, 20, 20}},
+              {"B", Type::kDouble, {20, 20, 20}},
+          },
+          k_heat_3d::Init,
+          k_heat_3d::Run,
+          k_heat_3d::Call,
+      },
+      {
+          "jacobi-1d",
+          "jacobi-1d_kernel.c",
+          "kernel_jacobi_1d",
+          {
+              {"tsteps", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {120}},
+              {"B", Type::kDouble, {120}},
+          },
+          k_jacobi_1d::Init,
+          k_jacobi_1d::Run,
+          k_jacobi_1d::Call,
+      },
+      {
+          "jacobi-2d",
+          "jacobi-2d_kernel.c",
+          "kernel_jacobi_2d",
+          {
+              {"tsteps", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {90, 90}},
+              {"B", Type::kDouble, {90, 90}},
+          },
+          k_jacobi_2d::Init,
+          k_jacobi_2d::Run,
+          k_jacobi_2d::Call,
+      },
+      {
+          "md",
+          "md_kernel.c",
+          "md_kernel",
+          {
+              {"force_x", Type::kDouble, {256}},
+              {"force_y", Type::kDouble, {256}},
+              {"force_z", Type::kDouble, {256}},
+              {"position_x", Type::kDouble, {256}},
+              {"position_y", Type::kDouble, {256}},
+              {"position_z", Type::kDouble, {256}},
+              {"NL", Type::kInt, {4096}},
+          },
+          k_md::Init,
+          k_md::Run,
+          k_md::Call,
+      },
+      {
+          "mvt",
+          "mvt_kernel.c",
+          "kernel_mvt",
+          {
+              {"x1", Type::kDouble, {120}},
+              {"x2", Type::kDouble, {120}},
+              {"y_1", Type::kDouble, {120}},
+              {"y_2", Type::kDouble, {120}},
+              {"A", Type::kDouble, {120, 120}},
+          },
+          k_mvt::Init,
+          k_mvt::Run,
+          k_mvt::Call,
+      },
+      {
+          "mvt-medium",
+          "mvt-medium_kernel.c",
+          "kernel_mvt",
+          {
+              {"x1", Type::kDouble, {400}},
+              {"x2", Type::kDouble, {400}},
+              {"y_1", Type::kDouble, {400}},
+              {"y_2", Type::kDouble, {400}},
+              {"A", Type::kDouble, {400, 400}},
+          },
+          k_mvt_medium::Init,
+          k_mvt_medium::Run,
+          k_mvt_medium::Call,
+      },
+      {
+          "nw",
+          "nw_kernel.c",
+          "needwun",
+          {
+              {"SEQA", Type::kChar, {128}},
+              {"SEQB", Type::kChar, {128}},
+              {"alignedA", Type::kChar, {256}},
+              {"alignedB", Type::kChar, {256}},
+              {"M", Type::kInt, {16641}},
+              {"ptr", Type::kChar, {16641}},
+          },
+          k_nw::Init,
+          k_nw::Run,
+          k_nw::Call,
+      },
+      {
+          "seidel-2d",
+          "seidel-2d_kernel.c",
+          "kernel_seidel_2d",
+          {
+              {"tsteps", Type::kInt, {}},
+              {"n", Type::kInt, {}},
+              {"A", Type::kDouble, {120, 120}},
+          },
+          k_seidel_2d::Init,
+          k_seidel_2d::Run,
+          k_seidel_2d::Call,
+      },
+      {
+          "spmv-crs",
+          "spmv-crs_kernel.c",
+          "spmv",
+          {
+              {"val", Type::kDouble, {1666}},
+              {"cols", Type::kInt, {1666}},
+              {"rowDelimiters", Type::kInt, {495}},
+              {"vec", Type::kDouble, {494}},
+              {"out", Type::kDouble, {494}},
+          },
+          k_spmv_crs::Init,
+          k_spmv_crs::Run,
+          k_spmv_crs::Call,
+      },
+      {
+          "spmv-ellpack",
+          "spmv-ellpack_kernel.c",
+          "ellpack",
+          {
+              {"nzval", Type::kDouble, {4940}},
+              {"cols", Type::kInt, {4940}},
+              {"vec", Type::kDouble, {494}},
+              {"out", Type::kDouble, {494}},
+          },
+          k_spmv_ellpack::Init,
+          k_spmv_ellpack::Run,
+          k_spmv_ellpack::Call,
+      },
+      {
+          "stencil",
+          "stencil_stencil2d_kernel.c",
+          "stencil",
+          {
+              {"orig", Type::kInt, {8192}},
+              {"sol", Type::kInt, {8192}},
+              {"filter", Type::kInt, {9}},
+          },
+          k_stencil::Init,
+          k_stencil::Run,
+          k_stencil::Call,
+      },
+      {
+          "stencil-3d",
+          "stencil-3d_kernel.c",
+          "stencil3d",
+          {
+              {"C0", Type::kLong, {}},
+              {"C1", Type::kLong, {}},
+              {"orig", Type::kLong, {39304}},
+              {"sol", Type::kLong, {39304}},
+          },
+          k_stencil_3d::Init,
+          k_stencil_3d::Run,
+          k_stencil_3d::Call,
+      },
+      {
+          "symm",
+          "symm_kernel.c",
+          "kernel_symm",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {60, 80}},
+              {"A", Type::kDouble, {60, 60}},
+              {"B", Type::kDouble, {60, 80}},
+          },
+          k_symm::Init,
+          k_symm::Run,
+          k_symm::Call,
+      },
+      {
+          "symm-opt",
+          "symm-opt_kernel.c",
+          "kernel_symm",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {60, 80}},
+              {"A", Type::kDouble, {60, 60}},
+              {"B", Type::kDouble, {60, 80}},
+          },
+          k_symm_opt::Init,
+          k_symm_opt::Run,
+          k_symm_opt::Call,
+      },
+      {
+          "symm-opt-medium",
+          "symm-opt-medium_kernel.c",
+          "kernel_symm",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {200, 240}},
+              {"A", Type::kDouble, {200, 200}},
+              {"B", Type::kDouble, {200, 240}},
+          },
+          k_symm_opt_medium::Init,
+          k_symm_opt_medium::Run,
+          k_symm_opt_medium::Call,
+      },
+      {
+          "syr2k",
+          "syr2k_kernel.c",
+          "kernel_syr2k",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {80, 80}},
+              {"A", Type::kDouble, {80, 60}},
+              {"B", Type::kDouble, {80, 60}},
+          },
+          k_syr2k::Init,
+          k_syr2k::Run,
+          k_syr2k::Call,
+      },
+      {
+          "syrk",
+          "syrk_kernel.c",
+          "kernel_syrk",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"beta", Type::kDouble, {}},
+              {"C", Type::kDouble, {80, 80}},
+              {"A", Type::kDouble, {80, 60}},
+          },
+          k_syrk::Init,
+          k_syrk::Run,
+          k_syrk::Call,
+      },
+      {
+          "trmm",
+          "trmm_kernel.c",
+          "kernel_trmm",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"A", Type::kDouble, {60, 60}},
+              {"B", Type::kDouble, {60, 80}},
+          },
+          k_trmm::Init,
+          k_trmm::Run,
+          k_trmm::Call,
+      },
+      {
+          "trmm-opt",
+          "trmm-opt_kernel.c",
+          "kernel_trmm",
+          {
+              {"alpha", Type::kDouble, {}},
+              {"A", Type::kDouble, {60, 60}},
+              {"B", Type::kDouble, {60, 80}},
+          },
+          k_trmm_opt::Init,
+          k_trmm_opt::Run,
+          k_trmm_opt::Call,
+      },
+  };
+  return registry;
+}
+
+}  // namespace kernels
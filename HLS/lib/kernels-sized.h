@@ -0,0 +1,4128 @@
+// Generated by gen_sized.py from data/sources. Do not edit.
+
+#ifndef KERNELS_SIZED_H_
+#define KERNELS_SIZED_H_
+
+#include <math.h>
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "kernels.h"
+
+// The kernels of data/sources with their problem sizes as template
+// parameters, so that the optimiser still sees constants at any size.
+// k_<kernel>::Instance<sizes...>() describes one instantiation like a
+// registry entry, with initialisers that scale with it; the default
+// sizes are those of the source.
+namespace kernels {
+namespace sized {
+
+// The name of an instance, e.g. "atax-390x410".
+inline std::string Name(const char* kernel, std::initializer_list<int> sizes) {
+  std::string name = kernel;
+  char separator = '-';
+  for (int size : sizes) {
+    name += separator + std::to_string(size);
+    separator = 'x';
+  }
+  return name;
+}
+
+namespace k_2mm {
+template <int kNi, int kNj, int kNk, int kNl>
+void kernel_2mm(int ni,int nj,int nk,int nl,double alpha,double beta,double tmp[kNi][kNj],double A[kNi][kNk],double B[kNk][kNj],double C[kNj][kNl],double D[kNi][kNl])
+{
+  int i;
+  int j;
+  int k;
+//#pragma scop
+/* D := alpha*A*B*C + beta*D */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kNj; j++) {
+      tmp[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL reduction = tmp FACTOR=auto{__PARA__L4}
+      for (k = 0; k < kNk; ++k) {
+        tmp[i][j] += alpha * A[i][k] * B[k][j];
+      }
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+    for (j = 0; j < kNl; j++) {
+      D[i][j] *= beta;
+      
+#pragma ACCEL PARALLEL reduction = D FACTOR=auto{__PARA__L5}
+      for (k = 0; k < kNj; ++k) {
+        D[i][j] += tmp[i][k] * C[k][j];
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kNi, int kNj, int kNk, int kNl>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kNi;
+  args.Value<int>(1) = kNj;
+  args.Value<int>(2) = kNk;
+  args.Value<int>(3) = kNl;
+  args.Value<double>(4) = 1.5;
+  args.Value<double>(5) = 1.2;
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+}
+
+template <int kNi, int kNj, int kNk, int kNl>
+void Run(Args& args) {
+  kernel_2mm<kNi, kNj, kNk, kNl>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<double>(4),
+      args.Value<double>(5),
+      args.Ptr<double(*)[kNj]>(6),
+      args.Ptr<double(*)[kNk]>(7),
+      args.Ptr<double(*)[kNj]>(8),
+      args.Ptr<double(*)[kNl]>(9),
+      args.Ptr<double(*)[kNl]>(10));
+}
+
+template <int kNi, int kNj, int kNk, int kNl>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_2mm<kNi, kNj, kNk, kNl>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<double>(4),
+      args.Value<double>(5),
+      args.Ptr<double(*)[kNj]>(6),
+      args.Ptr<double(*)[kNk]>(7),
+      args.Ptr<double(*)[kNj]>(8),
+      args.Ptr<double(*)[kNl]>(9),
+      args.Ptr<double(*)[kNl]>(10));
+}
+
+template <int kNi = 40, int kNj = 50, int kNk = 70, int kNl = 80>
+Kernel Instance() {
+  return {
+      Name("2mm", {kNi, kNj, kNk, kNl}),
+      "2mm_kernel.c",
+      "kernel_2mm",
+      {
+          {"ni", Type::kInt, {}},
+          {"nj", Type::kInt, {}},
+          {"nk", Type::kInt, {}},
+          {"nl", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"tmp", Type::kDouble, {kNi, kNj}},
+          {"A", Type::kDouble, {kNi, kNk}},
+          {"B", Type::kDouble, {kNk, kNj}},
+          {"C", Type::kDouble, {kNj, kNl}},
+          {"D", Type::kDouble, {kNi, kNl}},
+      },
+      Init<kNi, kNj, kNk, kNl>,
+      Run<kNi, kNj, kNk, kNl>,
+      Call<kNi, kNj, kNk, kNl>,
+  };
+}
+}  // namespace k_2mm
+
+namespace k_3mm {
+template <int kNi, int kNj, int kNk, int kNl, int kNm>
+void kernel_3mm(int ni,int nj,int nk,int nl,int nm,double E[kNi][kNj],double A[kNi][kNk],double B[kNk][kNj],double F[kNj][kNl],double C[kNj][kNm],double D[kNm][kNl],double G[kNi][kNl])
+{
+  int i;
+  int j;
+  int k;
+//#pragma scop
+/* E := A*B */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+    for (j = 0; j < kNj; j++) {
+      E[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L6}
+      for (k = 0; k < kNk; ++k) {
+        E[i][j] += A[i][k] * B[k][j];
+      }
+    }
+  }
+/* F := C*D */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kNj; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L4}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L4}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L4}
+    for (j = 0; j < kNl; j++) {
+      F[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L7}
+      for (k = 0; k < kNm; ++k) {
+        F[i][j] += C[i][k] * D[k][j];
+      }
+    }
+  }
+/* G := E*F */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L5}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L5}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L5}
+    for (j = 0; j < kNl; j++) {
+      G[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L8}
+      for (k = 0; k < kNj; ++k) {
+        G[i][j] += E[i][k] * F[k][j];
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kNi, int kNj, int kNk, int kNl, int kNm>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kNi;
+  args.Value<int>(1) = kNj;
+  args.Value<int>(2) = kNk;
+  args.Value<int>(3) = kNl;
+  args.Value<int>(4) = kNm;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+template <int kNi, int kNj, int kNk, int kNl, int kNm>
+void Run(Args& args) {
+  kernel_3mm<kNi, kNj, kNk, kNl, kNm>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<int>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7),
+      args.Ptr<double(*)[kNl]>(8),
+      args.Ptr<double(*)[kNm]>(9),
+      args.Ptr<double(*)[kNl]>(10),
+      args.Ptr<double(*)[kNl]>(11));
+}
+
+template <int kNi, int kNj, int kNk, int kNl, int kNm>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_3mm<kNi, kNj, kNk, kNl, kNm>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<int>(3),
+      args.Value<int>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7),
+      args.Ptr<double(*)[kNl]>(8),
+      args.Ptr<double(*)[kNm]>(9),
+      args.Ptr<double(*)[kNl]>(10),
+      args.Ptr<double(*)[kNl]>(11));
+}
+
+template <int kNi = 40, int kNj = 50, int kNk = 60, int kNl = 70, int kNm = 80>
+Kernel Instance() {
+  return {
+      Name("3mm", {kNi, kNj, kNk, kNl, kNm}),
+      "3mm_kernel.c",
+      "kernel_3mm",
+      {
+          {"ni", Type::kInt, {}},
+          {"nj", Type::kInt, {}},
+          {"nk", Type::kInt, {}},
+          {"nl", Type::kInt, {}},
+          {"nm", Type::kInt, {}},
+          {"E", Type::kDouble, {kNi, kNj}},
+          {"A", Type::kDouble, {kNi, kNk}},
+          {"B", Type::kDouble, {kNk, kNj}},
+          {"F", Type::kDouble, {kNj, kNl}},
+          {"C", Type::kDouble, {kNj, kNm}},
+          {"D", Type::kDouble, {kNm, kNl}},
+          {"G", Type::kDouble, {kNi, kNl}},
+      },
+      Init<kNi, kNj, kNk, kNl, kNm>,
+      Run<kNi, kNj, kNk, kNl, kNm>,
+      Call<kNi, kNj, kNk, kNl, kNm>,
+  };
+}
+}  // namespace k_3mm
+
+namespace k_adi {
+template <int kTsteps, int kN>
+void kernel_adi(int tsteps,int n,double u[kN][kN],double v[kN][kN],double p[kN][kN],double q[kN][kN])
+{
+  int t;
+  int i;
+  int j;
+  double DX;
+  double DY;
+  double DT;
+  double B1;
+  double B2;
+  double mul1;
+  double mul2;
+  double a;
+  double b;
+  double c;
+  double d;
+  double e;
+  double f;
+//#pragma scop
+  DX = 1.0 / ((double )kN);
+  DY = 1.0 / ((double )kN);
+  DT = 1.0 / ((double )kTsteps);
+  B1 = 2.0;
+  B2 = 1.0;
+  mul1 = B1 * DT / (DX * DX);
+  mul2 = B2 * DT / (DY * DY);
+  a = -mul1 / 2.0;
+  b = 1.0 + mul1;
+  c = a;
+  d = -mul2 / 2.0;
+  e = 1.0 + mul2;
+  f = d;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 1; t <= kTsteps; t++) {
+//Column Sweep
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (i = 1; i < (kN - 1); i++) {
+      v[0][i] = 1.0;
+      p[i][0] = 0.0;
+      q[i][0] = v[0][i];
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+      for (j = 1; j < (kN - 1); j++) {
+        p[i][j] = -c / (a * p[i][j - 1] + b);
+        q[i][j] = (-d * u[j][i - 1] + (1.0 + 2.0 * d) * u[j][i] - f * u[j][i + 1] - a * q[i][j - 1]) / (a * p[i][j - 1] + b);
+      }
+      v[kN - 1][i] = 1.0;
+/* Standardize from: for(j = 60 - 2;j >= 1;j--) {...} */
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L4}
+      for (j = 0; j <= (kN - 3); j++) {
+        int _in_j_0 = (kN - 2) + -1 * j;
+        v[_in_j_0][i] = p[i][_in_j_0] * v[_in_j_0 + 1][i] + q[i][_in_j_0];
+      }
+      j = 1 + -1;
+    }
+//Row Sweep
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (i = 1; i < (kN - 1); i++) {
+      u[i][0] = 1.0;
+      p[i][0] = 0.0;
+      q[i][0] = u[i][0];
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L5}
+      for (j = 1; j < (kN - 1); j++) {
+        p[i][j] = -f / (d * p[i][j - 1] + e);
+        q[i][j] = (-a * v[i - 1][j] + (1.0 + 2.0 * a) * v[i][j] - c * v[i + 1][j] - d * q[i][j - 1]) / (d * p[i][j - 1] + e);
+      }
+      u[i][kN - 1] = 1.0;
+/* Standardize from: for(j = 60 - 2;j >= 1;j--) {...} */
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L6}
+      for (j = 0; j <= (kN - 3); j++) {
+        int _in_j = (kN - 2) + -1 * j;
+        u[i][_in_j] = p[i][_in_j] * u[i][_in_j + 1] + q[i][_in_j];
+      }
+      j = 1 + -1;
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTsteps, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTsteps;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+template <int kTsteps, int kN>
+void Run(Args& args) {
+  kernel_adi<kTsteps, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double(*)[kN]>(4),
+      args.Ptr<double(*)[kN]>(5));
+}
+
+template <int kTsteps, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_adi<kTsteps, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double(*)[kN]>(4),
+      args.Ptr<double(*)[kN]>(5));
+}
+
+template <int kTsteps = 40, int kN = 60>
+Kernel Instance() {
+  return {
+      Name("adi", {kTsteps, kN}),
+      "adi_kernel.c",
+      "kernel_adi",
+      {
+          {"tsteps", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"u", Type::kDouble, {kN, kN}},
+          {"v", Type::kDouble, {kN, kN}},
+          {"p", Type::kDouble, {kN, kN}},
+          {"q", Type::kDouble, {kN, kN}},
+      },
+      Init<kTsteps, kN>,
+      Run<kTsteps, kN>,
+      Call<kTsteps, kN>,
+  };
+}
+}  // namespace k_adi
+
+namespace k_atax {
+template <int kM, int kN>
+void kernel_atax(int m,int n,double A[kM][kN],double x[kN],double y[kN],double tmp[kM])
+{
+  int i;
+  int j;
+//#pragma scop
+  for (i = 0; i < kN; i++) 
+    y[i] = ((double )0);
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    tmp[i] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction=tmp FACTOR=auto{__PARA__L0_0}
+    for (j = 0; j < kN; j++) {
+      tmp[i] += A[i][j] * x[j];
+    }
+    
+#pragma ACCEL PARALLEL reduction=y FACTOR=auto{__PARA__L0_1}
+    for (j = 0; j < kN; j++) {
+      y[j] += A[i][j] * tmp[i];
+    }
+  }
+//#pragma endscop
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kM;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_atax<kM, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_atax<kM, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kM = 116, int kN = 124>
+Kernel Instance() {
+  return {
+      Name("atax", {kM, kN}),
+      "atax_kernel.c",
+      "kernel_atax",
+      {
+          {"m", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kM, kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+          {"tmp", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_atax
+
+namespace k_atax_medium {
+template <int kM, int kN>
+void kernel_atax(double A[kM][kN],double x[kN],double y[kN],double tmp[kM])
+{
+  int i;
+  int j;
+  for (i = 0; i < kN; i++) 
+    y[i] = ((double )0);
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    tmp[i] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction=tmp FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      tmp[i] += A[i][j] * x[j];
+    }
+    
+#pragma ACCEL PARALLEL reduction=y FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kN; j++) {
+      y[j] += A[i][j] * tmp[i];
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_atax<kM, kN>(
+      args.Ptr<double(*)[kN]>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_atax<kM, kN>)>(function)(
+      args.Ptr<double(*)[kN]>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kM = 390, int kN = 410>
+Kernel Instance() {
+  return {
+      Name("atax-medium", {kM, kN}),
+      "atax-medium_kernel.c",
+      "kernel_atax",
+      {
+          {"A", Type::kDouble, {kM, kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+          {"tmp", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_atax_medium
+
+namespace k_bicg {
+template <int kM, int kN>
+void kernel_bicg(int m,int n,double A[kM][kN],double s[kN],double q[kM],double p[kN],double r[kM])
+{
+  int i;
+  int j;
+//#pragma scop
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    s[i] = ((double )0);
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kM; i++) {
+    q[i] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kN; j++) {
+      s[j] += r[i] * A[i][j];
+      q[i] += A[i][j] * p[j];
+    }
+  }
+//#pragma endscop
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kM;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_bicg<kM, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg<kM, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM = 124, int kN = 116>
+Kernel Instance() {
+  return {
+      Name("bicg", {kM, kN}),
+      "bicg_kernel.c",
+      "kernel_bicg",
+      {
+          {"m", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kM, kN}},
+          {"s", Type::kDouble, {kN}},
+          {"q", Type::kDouble, {kM}},
+          {"p", Type::kDouble, {kN}},
+          {"r", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_bicg
+
+namespace k_bicg_large {
+template <int kM, int kN>
+void kernel_bicg(int m,int n,double A[kM][kN],double s[kN],double q[kM],double p[kN],double r[kM])
+{
+  int i;
+  int j;
+  for (i = 0; i < kN; i++) 
+    s[i] = ((double )0);
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    q[i] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      s[j] += r[i] * A[i][j];
+      q[i] += A[i][j] * p[j];
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kM;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_bicg<kM, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg<kM, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM = 410, int kN = 390>
+Kernel Instance() {
+  return {
+      Name("bicg-large", {kM, kN}),
+      "bicg-large_kernel.c",
+      "kernel_bicg",
+      {
+          {"m", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kM, kN}},
+          {"s", Type::kDouble, {kN}},
+          {"q", Type::kDouble, {kM}},
+          {"p", Type::kDouble, {kN}},
+          {"r", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_bicg_large
+
+namespace k_bicg_medium {
+template <int kM, int kN>
+void kernel_bicg(int m,int n,double A[kM][kN],double s[kN],double q[kM],double p[kN],double r[kM])
+{
+  int i;
+  int j;
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    s[i] = ((double )0);
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kM; i++) {
+    q[i] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kN; j++) {
+      s[j] += r[i] * A[i][j];
+      q[i] += A[i][j] * p[j];
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kM;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_bicg<kM, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_bicg<kM, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kM = 410, int kN = 390>
+Kernel Instance() {
+  return {
+      Name("bicg-medium", {kM, kN}),
+      "bicg-medium_kernel.c",
+      "kernel_bicg",
+      {
+          {"m", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kM, kN}},
+          {"s", Type::kDouble, {kN}},
+          {"q", Type::kDouble, {kM}},
+          {"p", Type::kDouble, {kN}},
+          {"r", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_bicg_medium
+
+namespace k_correlation {
+template <int kM, int kN>
+void kernel_correlation(double float_n,double data[kN][kM],double corr[kM][kM],double mean[kM],double stddev[kM])
+{
+  int i;
+  int j;
+  int k;
+  double eps = 0.1;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (j = 0; j < kM; j++) {
+    mean[j] = 0.0;
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L4}
+    for (i = 0; i < kN; i++) {
+      mean[j] += data[i][j];
+    }
+    mean[j] /= float_n;
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (j = 0; j < kM; j++) {
+    stddev[j] = 0.0;
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L5}
+    for (i = 0; i < kN; i++) {
+      stddev[j] += pow(data[i][j] - mean[j],(double )2);
+    }
+    stddev[j] /= float_n;
+    stddev[j] = sqrt(stddev[j]);
+/* The following in an inelegant but usual way to handle
+         near-zero std. dev. values, which below would cause a zero-
+         divide. */
+    stddev[j] = (stddev[j] <= eps?1.0 : stddev[j]);
+  }
+/* Center and reduce the column vectors. */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L6}
+    for (j = 0; j < kM; j++) {
+      data[i][j] -= mean[j];
+      data[i][j] /= sqrt(float_n) * stddev[j];
+    }
+  }
+/* Calculate the m * m correlation matrix. */
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+  for (i = 0; i < kM - 1; i++) {
+    corr[i][i] = 1.0;
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L7}
+    for (j = i + 1; j < kM; j++) {
+      corr[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L7_0}
+      for (k = 0; k < kN; k++) {
+        corr[i][j] += data[k][i] * data[k][j];
+      }
+      corr[j][i] = corr[i][j];
+    }
+  }
+  corr[kM - 1][kM - 1] = 1.0;
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = static_cast<double>(kN);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_correlation<kM, kN>(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kM]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_correlation<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kM]>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+template <int kM = 80, int kN = 100>
+Kernel Instance() {
+  return {
+      Name("correlation", {kM, kN}),
+      "correlation_kernel.c",
+      "kernel_correlation",
+      {
+          {"float_n", Type::kDouble, {}},
+          {"data", Type::kDouble, {kN, kM}},
+          {"corr", Type::kDouble, {kM, kM}},
+          {"mean", Type::kDouble, {kM}},
+          {"stddev", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_correlation
+
+namespace k_covariance {
+template <int kM, int kN>
+void kernel_covariance(int m,int n,double float_n,double data[kN][kM],double cov[kM][kM],double mean[kM])
+{
+  int i;
+  int j;
+  int k;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (j = 0; j < kM; j++) {
+    mean[j] = 0.0;
+    
+#pragma ACCEL PARALLEL reduction=mean FACTOR=auto{__PARA__L3}
+    for (i = 0; i < kN; i++) {
+      mean[j] += data[i][j];
+    }
+    mean[j] /= float_n;
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=data FACTOR=auto{__PARA__L4}
+    for (j = 0; j < kM; j++) {
+      data[i][j] -= mean[j];
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+  for (i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L5}
+    for (j = i; j < kM; j++) {
+      cov[i][j] = 0.0;
+      
+#pragma ACCEL PARALLEL reduction=cov FACTOR=auto{__PARA__L6}
+      for (k = 0; k < kN; k++) {
+        cov[i][j] += data[k][i] * data[k][j];
+      }
+      cov[i][j] /= float_n - 1.0;
+      cov[j][i] = cov[i][j];
+    }
+  }
+//#pragma endscop
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kM;
+  args.Value<int>(1) = kN;
+  args.Value<double>(2) = static_cast<double>(kN);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_covariance<kM, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kM]>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_covariance<kM, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kM]>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kM = 80, int kN = 100>
+Kernel Instance() {
+  return {
+      Name("covariance", {kM, kN}),
+      "covariance_kernel.c",
+      "kernel_covariance",
+      {
+          {"m", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"float_n", Type::kDouble, {}},
+          {"data", Type::kDouble, {kN, kM}},
+          {"cov", Type::kDouble, {kM, kM}},
+          {"mean", Type::kDouble, {kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_covariance
+
+namespace k_doitgen {
+template <int kNr, int kNq, int kNp>
+void kernel_doitgen(int nr,int nq,int np,double A[kNr][kNq][kNp],double C4[kNp][kNp],double sum[kNp])
+{
+  int r;
+  int q;
+  int p;
+  int s;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  for (r = 0; r < kNr; r++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    for (q = 0; q < kNq; q++) {
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+      
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+      for (p = 0; p < kNp; p++) {
+        sum[p] = 0.0;
+        for (s = 0; s < kNp; s++) {
+          sum[p] += A[r][q][s] * C4[s][p];
+        }
+      }
+      for (p = 0; p < kNp; p++) {
+        A[r][q][p] = sum[p];
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kNr, int kNq, int kNp>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kNr;
+  args.Value<int>(1) = kNq;
+  args.Value<int>(2) = kNp;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+}
+
+template <int kNr, int kNq, int kNp>
+void Run(Args& args) {
+  kernel_doitgen<kNr, kNq, kNp>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNq][kNp]>(3),
+      args.Ptr<double(*)[kNp]>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kNr, int kNq, int kNp>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_doitgen<kNr, kNq, kNp>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNq][kNp]>(3),
+      args.Ptr<double(*)[kNp]>(4),
+      args.Ptr<double*>(5));
+}
+
+template <int kNr = 25, int kNq = 20, int kNp = 30>
+Kernel Instance() {
+  return {
+      Name("doitgen", {kNr, kNq, kNp}),
+      "doitgen_kernel.c",
+      "kernel_doitgen",
+      {
+          {"nr", Type::kInt, {}},
+          {"nq", Type::kInt, {}},
+          {"np", Type::kInt, {}},
+          {"A", Type::kDouble, {kNr, kNq, kNp}},
+          {"C4", Type::kDouble, {kNp, kNp}},
+          {"sum", Type::kDouble, {kNp}},
+      },
+      Init<kNr, kNq, kNp>,
+      Run<kNr, kNq, kNp>,
+      Call<kNr, kNq, kNp>,
+  };
+}
+}  // namespace k_doitgen
+
+namespace k_doitgen_red {
+template <int kNr, int kNq, int kNp>
+void kernel_doitgen(double A[kNr][kNq][kNp],double C4[kNp][kNp],double sum[kNp])
+{
+  int r;
+  int q;
+  int p;
+  int s;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  for (r = 0; r < kNr; r++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    for (q = 0; q < kNq; q++) {
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+      
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+      for (p = 0; p < kNp; p++) {
+        double sum_tmp = 0.0;
+#pragma ACCEL PARALLEL reduction=sum_tmp FACTOR=auto{__PARA__L3}
+	for (s = 0; s < kNp; s++) {
+          sum_tmp += A[r][q][s] * C4[s][p];
+        }
+	sum[p] = sum_tmp;
+      }
+      for (p = 0; p < kNp; p++) {
+        A[r][q][p] = sum[p];
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kNr, int kNq, int kNp>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kNr, int kNq, int kNp>
+void Run(Args& args) {
+  kernel_doitgen<kNr, kNq, kNp>(
+      args.Ptr<double(*)[kNq][kNp]>(0),
+      args.Ptr<double(*)[kNp]>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kNr, int kNq, int kNp>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_doitgen<kNr, kNq, kNp>)>(function)(
+      args.Ptr<double(*)[kNq][kNp]>(0),
+      args.Ptr<double(*)[kNp]>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kNr = 25, int kNq = 20, int kNp = 30>
+Kernel Instance() {
+  return {
+      Name("doitgen-red", {kNr, kNq, kNp}),
+      "doitgen-red_kernel.c",
+      "kernel_doitgen",
+      {
+          {"A", Type::kDouble, {kNr, kNq, kNp}},
+          {"C4", Type::kDouble, {kNp, kNp}},
+          {"sum", Type::kDouble, {kNp}},
+      },
+      Init<kNr, kNq, kNp>,
+      Run<kNr, kNq, kNp>,
+      Call<kNr, kNq, kNp>,
+  };
+}
+}  // namespace k_doitgen_red
+
+namespace k_fdtd_2d {
+template <int kTmax, int kNx, int kNy>
+void kernel_fdtd_2d(int tmax,int nx,int ny,double ex[kNx][kNy],double ey[kNx][kNy],double hz[kNx][kNy],double _fict_[kTmax])
+{
+  int t;
+  int i;
+  int j;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 0; t < kTmax; t++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_0}
+    for (j = 0; j < kNy; j++) {
+      ey[0][j] = _fict_[t];
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L0_1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0_1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_1}
+    for (i = 1; i < kNx; i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_1_0}
+      for (j = 0; j < kNy; j++) {
+        ey[i][j] = ey[i][j] - 0.5 * (hz[i][j] - hz[i - 1][j]);
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L0_2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0_2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_2}
+    for (i = 0; i < kNx; i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_2_0}
+      for (j = 1; j < kNy; j++) {
+        ex[i][j] = ex[i][j] - 0.5 * (hz[i][j] - hz[i][j - 1]);
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L0_3}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0_3}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_3}
+    for (i = 0; i < (kNx - 1); i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0_3_0}
+      for (j = 0; j < (kNy - 1); j++) {
+        hz[i][j] = hz[i][j] - 0.7 * (ex[i][j + 1] - ex[i][j] + ey[i + 1][j] - ey[i][j]);
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTmax, int kNx, int kNy>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTmax;
+  args.Value<int>(1) = kNx;
+  args.Value<int>(2) = kNy;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kTmax, int kNx, int kNy>
+void Run(Args& args) {
+  kernel_fdtd_2d<kTmax, kNx, kNy>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNy]>(3),
+      args.Ptr<double(*)[kNy]>(4),
+      args.Ptr<double(*)[kNy]>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kTmax, int kNx, int kNy>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_fdtd_2d<kTmax, kNx, kNy>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNy]>(3),
+      args.Ptr<double(*)[kNy]>(4),
+      args.Ptr<double(*)[kNy]>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kTmax = 40, int kNx = 60, int kNy = 80>
+Kernel Instance() {
+  return {
+      Name("fdtd-2d", {kTmax, kNx, kNy}),
+      "fdtd-2d_kernel.c",
+      "kernel_fdtd_2d",
+      {
+          {"tmax", Type::kInt, {}},
+          {"nx", Type::kInt, {}},
+          {"ny", Type::kInt, {}},
+          {"ex", Type::kDouble, {kNx, kNy}},
+          {"ey", Type::kDouble, {kNx, kNy}},
+          {"hz", Type::kDouble, {kNx, kNy}},
+          {"_fict_", Type::kDouble, {kTmax}},
+      },
+      Init<kTmax, kNx, kNy>,
+      Run<kTmax, kNx, kNy>,
+      Call<kTmax, kNx, kNy>,
+  };
+}
+}  // namespace k_fdtd_2d
+
+namespace k_fdtd_2d_large {
+template <int kTmax, int kNx, int kNy>
+void kernel_fdtd_2d(int tmax,int nx,int ny,double ex[kNx][kNy],double ey[kNx][kNy],double hz[kNx][kNy],double _fict_[kTmax])
+{
+  int t;
+  int i;
+  int j;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 0; t < kTmax; t++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kNy; j++) {
+      ey[0][j] = _fict_[t];
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (i = 1; i < kNx; i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L5}
+      for (j = 0; j < kNy; j++) {
+        ey[i][j] = ey[i][j] - 0.5 * (hz[i][j] - hz[i - 1][j]);
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+    for (i = 0; i < kNx; i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L6}
+      for (j = 1; j < kNy; j++) {
+        ex[i][j] = ex[i][j] - 0.5 * (hz[i][j] - hz[i][j - 1]);
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L4}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L4}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L4}
+    for (i = 0; i < kNx - 1; i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L7}
+      for (j = 0; j < kNy - 1; j++) {
+        hz[i][j] = hz[i][j] - 0.7 * (ex[i][j + 1] - ex[i][j] + ey[i + 1][j] - ey[i][j]);
+      }
+    }
+  }
+}
+
+template <int kTmax, int kNx, int kNy>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTmax;
+  args.Value<int>(1) = kNx;
+  args.Value<int>(2) = kNy;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kTmax, int kNx, int kNy>
+void Run(Args& args) {
+  kernel_fdtd_2d<kTmax, kNx, kNy>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNy]>(3),
+      args.Ptr<double(*)[kNy]>(4),
+      args.Ptr<double(*)[kNy]>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kTmax, int kNx, int kNy>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_fdtd_2d<kTmax, kNx, kNy>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Ptr<double(*)[kNy]>(3),
+      args.Ptr<double(*)[kNy]>(4),
+      args.Ptr<double(*)[kNy]>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kTmax = 100, int kNx = 200, int kNy = 240>
+Kernel Instance() {
+  return {
+      Name("fdtd-2d-large", {kTmax, kNx, kNy}),
+      "fdtd-2d-large_kernel.c",
+      "kernel_fdtd_2d",
+      {
+          {"tmax", Type::kInt, {}},
+          {"nx", Type::kInt, {}},
+          {"ny", Type::kInt, {}},
+          {"ex", Type::kDouble, {kNx, kNy}},
+          {"ey", Type::kDouble, {kNx, kNy}},
+          {"hz", Type::kDouble, {kNx, kNy}},
+          {"_fict_", Type::kDouble, {kTmax}},
+      },
+      Init<kTmax, kNx, kNy>,
+      Run<kTmax, kNx, kNy>,
+      Call<kTmax, kNx, kNy>,
+  };
+}
+}  // namespace k_fdtd_2d_large
+
+namespace k_gemm_blocked {
+template <int kN>
+void bbgemm(double m1[(kN * kN)],double m2[(kN * kN)],double prod[(kN * kN)])
+{
+  static_assert((kN % 8 == 0), "gemm-blocked: n % 8 == 0");
+  int i;
+  int k;
+  int j;
+  int jj;
+  int kk;
+  int i_row;
+  int k_row;
+  double temp_x;
+  double mul;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  loopjj:
+/* Standardize from: for(jj = 0;jj < 64;jj += 8) {...} */
+  for (jj = 0; jj <= (kN / 8 - 1); jj++) {
+    int _in_jj = 0 + 8L * jj;
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    loopkk:
+/* Standardize from: for(kk = 0;kk < 64;kk += 8) {...} */
+    for (kk = 0; kk <= (kN / 8 - 1); kk++) {
+      int _in_kk = 0 + 8L * kk;
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+      
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+      loopi:
+      for (i = 0; i < kN; ++i) {
+        
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+        
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+        loopk:
+        for (k = 0; k < 8; ++k) {
+          i_row = i * kN;
+          k_row = (k + _in_kk) * kN;
+          temp_x = m1[i_row + k + _in_kk];
+          loopj:
+          for (j = 0; j < 8; ++j) {
+            mul = temp_x * m2[k_row + j + _in_jj];
+            prod[i_row + j + _in_jj] += mul;
+          }
+        }
+      }
+    }
+    kk = (kN - 8) + 8L;
+  }
+  jj = (kN - 8) + 8L;
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  bbgemm<kN>(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&bbgemm<kN>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kN = 64>
+Kernel Instance() {
+  return {
+      Name("gemm-blocked", {kN}),
+      "gemm-blocked_kernel.c",
+      "bbgemm",
+      {
+          {"m1", Type::kDouble, {(kN * kN)}},
+          {"m2", Type::kDouble, {(kN * kN)}},
+          {"prod", Type::kDouble, {(kN * kN)}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gemm_blocked
+
+namespace k_gemm_ncubed {
+template <int kN>
+void gemm(double m1[(kN * kN)],double m2[(kN * kN)],double prod[(kN * kN)])
+{
+  int i;
+  int j;
+  int k;
+  int k_col;
+  int i_col;
+  double mult;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  outer:
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    middle:
+    for (j = 0; j < kN; j++) {
+      i_col = i * kN;
+      double sum = (double )0;
+      
+#pragma ACCEL PARALLEL reduction=sum FACTOR=auto{__PARA__L2}
+      inner:
+      for (k = 0; k < kN; k++) {
+        k_col = k * kN;
+        mult = m1[i_col + k] * m2[k_col + j];
+        sum += mult;
+      }
+      prod[i_col + j] = sum;
+    }
+  }
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  gemm<kN>(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&gemm<kN>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2));
+}
+
+template <int kN = 64>
+Kernel Instance() {
+  return {
+      Name("gemm-ncubed", {kN}),
+      "gemm-ncubed_kernel.c",
+      "gemm",
+      {
+          {"m1", Type::kDouble, {(kN * kN)}},
+          {"m2", Type::kDouble, {(kN * kN)}},
+          {"prod", Type::kDouble, {(kN * kN)}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gemm_ncubed
+
+namespace k_gemm_p {
+template <int kNi, int kNj, int kNk>
+void kernel_gemm(int ni,int nj,int nk,double alpha,double beta,double C[kNi][kNj],double A[kNi][kNk],double B[kNk][kNj])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//TRANSA = 'N'
+//TRANSB = 'N'
+// => Form C := alpha*A*B + beta*C,
+//A is NIxNK
+//B is NKxNJ
+//C is NIxNJ
+  
+#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kNj; j++) {
+      C[i][j] *= beta;
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (k = 0; k < kNk; k++) {
+      
+#pragma ACCEL PARALLEL reduction=C FACTOR=auto{__PARA__L3}
+      for (j = 0; j < kNj; j++) {
+        C[i][j] += alpha * A[i][k] * B[k][j];
+      }
+    }
+  }
+  
+#pragma endscop
+}
+
+template <int kNi, int kNj, int kNk>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kNi;
+  args.Value<int>(1) = kNj;
+  args.Value<int>(2) = kNk;
+  args.Value<double>(3) = 1.5;
+  args.Value<double>(4) = 1.2;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+template <int kNi, int kNj, int kNk>
+void Run(Args& args) {
+  kernel_gemm<kNi, kNj, kNk>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7));
+}
+
+template <int kNi, int kNj, int kNk>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemm<kNi, kNj, kNk>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7));
+}
+
+template <int kNi = 60, int kNj = 70, int kNk = 80>
+Kernel Instance() {
+  return {
+      Name("gemm-p", {kNi, kNj, kNk}),
+      "gemm-p_kernel.c",
+      "kernel_gemm",
+      {
+          {"ni", Type::kInt, {}},
+          {"nj", Type::kInt, {}},
+          {"nk", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kNi, kNj}},
+          {"A", Type::kDouble, {kNi, kNk}},
+          {"B", Type::kDouble, {kNk, kNj}},
+      },
+      Init<kNi, kNj, kNk>,
+      Run<kNi, kNj, kNk>,
+      Call<kNi, kNj, kNk>,
+  };
+}
+}  // namespace k_gemm_p
+
+namespace k_gemm_p_large {
+template <int kNi, int kNj, int kNk>
+void kernel_gemm(int ni,int nj,int nk,double alpha,double beta,double C[kNi][kNj],double A[kNi][kNk],double B[kNk][kNj])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//TRANSA = 'N'
+//TRANSB = 'N'
+// => Form C := alpha*A*B + beta*C,
+//A is NIxNK
+//B is NKxNJ
+//C is NIxNJ
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kNi; i++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kNj; j++) {
+      C[i][j] *= beta;
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (k = 0; k < kNk; k++) {
+      
+#pragma ACCEL PARALLEL reduction=C FACTOR=auto{__PARA__L3}
+      for (j = 0; j < kNj; j++) {
+        C[i][j] += alpha * A[i][k] * B[k][j];
+      }
+    }
+  }
+}
+
+template <int kNi, int kNj, int kNk>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kNi;
+  args.Value<int>(1) = kNj;
+  args.Value<int>(2) = kNk;
+  args.Value<double>(3) = 1.5;
+  args.Value<double>(4) = 1.2;
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+template <int kNi, int kNj, int kNk>
+void Run(Args& args) {
+  kernel_gemm<kNi, kNj, kNk>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7));
+}
+
+template <int kNi, int kNj, int kNk>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemm<kNi, kNj, kNk>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Value<int>(2),
+      args.Value<double>(3),
+      args.Value<double>(4),
+      args.Ptr<double(*)[kNj]>(5),
+      args.Ptr<double(*)[kNk]>(6),
+      args.Ptr<double(*)[kNj]>(7));
+}
+
+template <int kNi = 200, int kNj = 220, int kNk = 240>
+Kernel Instance() {
+  return {
+      Name("gemm-p-large", {kNi, kNj, kNk}),
+      "gemm-p-large_kernel.c",
+      "kernel_gemm",
+      {
+          {"ni", Type::kInt, {}},
+          {"nj", Type::kInt, {}},
+          {"nk", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kNi, kNj}},
+          {"A", Type::kDouble, {kNi, kNk}},
+          {"B", Type::kDouble, {kNk, kNj}},
+      },
+      Init<kNi, kNj, kNk>,
+      Run<kNi, kNj, kNk>,
+      Call<kNi, kNj, kNk>,
+  };
+}
+}  // namespace k_gemm_p_large
+
+namespace k_gemver {
+template <int kN>
+void kernel_gemver(int n,double alpha,double beta,double A[kN][kN],double u1[kN],double v1[kN],double u2[kN],double v2[kN],double w[kN],double x[kN],double y[kN],double z[kN])
+{
+  int i;
+  int j;
+  
+#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=A FACTOR=auto{__PARA__L4}
+    for (j = 0; j < kN; j++) {
+      A[i][j] += u1[i] * v1[j] + u2[i] * v2[j];
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=x FACTOR=auto{__PARA__L5}
+    for (j = 0; j < kN; j++) {
+      x[i] += beta * A[j][i] * y[j];
+    }
+  }
+  
+#pragma ACCEL PARALLEL reduction=x FACTOR=auto{__PARA__L2}
+  for (i = 0; i < kN; i++) {
+    x[i] +=  z[i];
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=w FACTOR=auto{__PARA__L6}
+    for (j = 0; j < kN; j++) {
+      w[i] += alpha * A[i][j] * x[j];
+    }
+  }
+  
+#pragma endscop
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kN;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_gemver<kN>(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemver<kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+template <int kN = 120>
+Kernel Instance() {
+  return {
+      Name("gemver", {kN}),
+      "gemver_kernel.c",
+      "kernel_gemver",
+      {
+          {"n", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"A", Type::kDouble, {kN, kN}},
+          {"u1", Type::kDouble, {kN}},
+          {"v1", Type::kDouble, {kN}},
+          {"u2", Type::kDouble, {kN}},
+          {"v2", Type::kDouble, {kN}},
+          {"w", Type::kDouble, {kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+          {"z", Type::kDouble, {kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gemver
+
+namespace k_gemver_medium {
+template <int kN>
+void kernel_gemver(int n,double alpha,double beta,double A[kN][kN],double u1[kN],double v1[kN],double u2[kN],double v2[kN],double w[kN],double x[kN],double y[kN],double z[kN])
+{
+  int i;
+  int j;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=A FACTOR=auto{__PARA__L4}
+    for (j = 0; j < kN; j++) {
+      A[i][j] += + u1[i] * v1[j] + u2[i] * v2[j];
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=x FACTOR=auto{__PARA__L5}
+    for (j = 0; j < kN; j++) {
+      x[i] += beta * A[j][i] * y[j];
+    }
+  }
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+  for (i = 0; i < kN; i++) {
+    x[i] = x[i] + z[i];
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction=w FACTOR=auto{__PARA__L6}
+    for (j = 0; j < kN; j++) {
+      w[i] += alpha * A[i][j] * x[j];
+    }
+  }
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kN;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+  FillUniform(args.Ptr<double*>(8), args.Count(8), rng);
+  FillUniform(args.Ptr<double*>(9), args.Count(9), rng);
+  FillUniform(args.Ptr<double*>(10), args.Count(10), rng);
+  FillUniform(args.Ptr<double*>(11), args.Count(11), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_gemver<kN>(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gemver<kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7),
+      args.Ptr<double*>(8),
+      args.Ptr<double*>(9),
+      args.Ptr<double*>(10),
+      args.Ptr<double*>(11));
+}
+
+template <int kN = 400>
+Kernel Instance() {
+  return {
+      Name("gemver-medium", {kN}),
+      "gemver-medium_kernel.c",
+      "kernel_gemver",
+      {
+          {"n", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"A", Type::kDouble, {kN, kN}},
+          {"u1", Type::kDouble, {kN}},
+          {"v1", Type::kDouble, {kN}},
+          {"u2", Type::kDouble, {kN}},
+          {"v2", Type::kDouble, {kN}},
+          {"w", Type::kDouble, {kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+          {"z", Type::kDouble, {kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gemver_medium
+
+namespace k_gesummv {
+template <int kN>
+void kernel_gesummv(int n,double alpha,double beta,double A[kN][kN],double B[kN][kN],double tmp[kN],double x[kN],double y[kN])
+{
+  int i;
+  int j;
+  
+#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    tmp[i] = 0.0;
+    y[i] = 0.0;
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      tmp[i] = A[i][j] * x[j] + tmp[i];
+      y[i] = B[i][j] * x[j] + y[i];
+    }
+    y[i] = alpha * tmp[i] + beta * y[i];
+  }
+  
+#pragma endscop
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kN;
+  args.Value<double>(1) = 1.5;
+  args.Value<double>(2) = 1.2;
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+  FillUniform(args.Ptr<double*>(7), args.Count(7), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_gesummv<kN>(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double(*)[kN]>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gesummv<kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<double>(1),
+      args.Value<double>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double(*)[kN]>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6),
+      args.Ptr<double*>(7));
+}
+
+template <int kN = 90>
+Kernel Instance() {
+  return {
+      Name("gesummv", {kN}),
+      "gesummv_kernel.c",
+      "kernel_gesummv",
+      {
+          {"n", Type::kInt, {}},
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"A", Type::kDouble, {kN, kN}},
+          {"B", Type::kDouble, {kN, kN}},
+          {"tmp", Type::kDouble, {kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gesummv
+
+namespace k_gesummv_medium {
+template <int kN>
+void kernel_gesummv(double alpha,double beta,double A[kN][kN],double B[kN][kN],double tmp[kN],double x[kN],double y[kN])
+{
+  int i;
+  int j;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    tmp[i] = 0.0;
+    y[i] = 0.0;
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      tmp[i] += A[i][j] * x[j];
+      y[i] += B[i][j] * x[j];
+    }
+    y[i] = alpha * tmp[i] + beta * y[i];
+  }
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillUniform(args.Ptr<double*>(6), args.Count(6), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_gesummv<kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_gesummv<kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<double*>(6));
+}
+
+template <int kN = 250>
+Kernel Instance() {
+  return {
+      Name("gesummv-medium", {kN}),
+      "gesummv-medium_kernel.c",
+      "kernel_gesummv",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"A", Type::kDouble, {kN, kN}},
+          {"B", Type::kDouble, {kN, kN}},
+          {"tmp", Type::kDouble, {kN}},
+          {"x", Type::kDouble, {kN}},
+          {"y", Type::kDouble, {kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_gesummv_medium
+
+namespace k_heat_3d {
+template <int kTsteps, int kN>
+void kernel_heat_3d(int tsteps,int n,double A[kN][kN][kN],double B[kN][kN][kN])
+{
+  int t;
+  int i;
+  int j;
+  int k;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 1; t <= kTsteps; t++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    for (i = 1; i < kN - 1; i++) {
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L3}
+      
+#pragma ACCEL TILE FACTOR=auto{__TILE__L3}
+      for (j = 1; j < kN - 1; j++) {
+        for (k = 1; k < kN - 1; k++) {
+          B[i][j][k] = 0.125 * (A[i + 1][j][k] - 2.0 * A[i][j][k] + A[i - 1][j][k]) + 0.125 * (A[i][j + 1][k] - 2.0 * A[i][j][k] + A[i][j - 1][k]) + 0.125 * (A[i][j][k + 1] - 2.0 * A[i][j][k] + A[i][j][k - 1]) + A[i][j][k];
+        }
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    for (i = 1; i < kN - 1; i++) {
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L4}
+      
+#pragma ACCEL TILE FACTOR=auto{__TILE__L4}
+      for (j = 1; j < kN - 1; j++) {
+        for (k = 1; k < kN - 1; k++) {
+          A[i][j][k] = 0.125 * (B[i + 1][j][k] - 2.0 * B[i][j][k] + B[i - 1][j][k]) + 0.125 * (B[i][j + 1][k] - 2.0 * B[i][j][k] + B[i][j - 1][k]) + 0.125 * (B[i][j][k + 1] - 2.0 * B[i][j][k] + B[i][j][k - 1]) + B[i][j][k];
+        }
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTsteps, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTsteps;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kTsteps, int kN>
+void Run(Args& args) {
+  kernel_heat_3d<kTsteps, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN][kN]>(2),
+      args.Ptr<double(*)[kN][kN]>(3));
+}
+
+template <int kTsteps, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_heat_3d<kTsteps, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN][kN]>(2),
+      args.Ptr<double(*)[kN][kN]>(3));
+}
+
+template <int kTsteps = 40, int kN = 20>
+Kernel Instance() {
+  return {
+      Name("heat-3d", {kTsteps, kN}),
+      "heat-3d_kernel.c",
+      "kernel_heat_3d",
+      {
+          {"tsteps", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kN, kN, kN}},
+          {"B", Type::kDouble, {kN, kN, kN}},
+      },
+      Init<kTsteps, kN>,
+      Run<kTsteps, kN>,
+      Call<kTsteps, kN>,
+  };
+}
+}  // namespace k_heat_3d
+
+namespace k_jacobi_1d {
+template <int kTsteps, int kN>
+void kernel_jacobi_1d(int tsteps,int n,double A[kN],double B[kN])
+{
+  int t;
+  int i;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 0; t < kTsteps; t++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (i = 1; i < kN - 1; i++) {
+      B[i] = 0.33333 * (A[i - 1] + A[i] + A[i + 1]);
+    }
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (i = 1; i < kN - 1; i++) {
+      A[i] = 0.33333 * (B[i - 1] + B[i] + B[i + 1]);
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTsteps, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTsteps;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kTsteps, int kN>
+void Run(Args& args) {
+  kernel_jacobi_1d<kTsteps, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kTsteps, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_jacobi_1d<kTsteps, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kTsteps = 40, int kN = 120>
+Kernel Instance() {
+  return {
+      Name("jacobi-1d", {kTsteps, kN}),
+      "jacobi-1d_kernel.c",
+      "kernel_jacobi_1d",
+      {
+          {"tsteps", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kN}},
+          {"B", Type::kDouble, {kN}},
+      },
+      Init<kTsteps, kN>,
+      Run<kTsteps, kN>,
+      Call<kTsteps, kN>,
+  };
+}
+}  // namespace k_jacobi_1d
+
+namespace k_jacobi_2d {
+template <int kTsteps, int kN>
+void kernel_jacobi_2d(int tsteps,int n,double A[kN][kN],double B[kN][kN])
+{
+  int t;
+  int i;
+  int j;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 0; t < kTsteps; t++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (i = 1; i < (kN - 1); i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+      for (j = 1; j < (kN - 1); j++) {
+        B[i][j] = 0.2 * (A[i][j] + A[i][j - 1] + A[i][1 + j] + A[1 + i][j] + A[i - 1][j]);
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (i = 1; i < (kN - 1); i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L4}
+      for (j = 1; j < (kN - 1); j++) {
+        A[i][j] = 0.2 * (B[i][j] + B[i][j - 1] + B[i][1 + j] + B[1 + i][j] + B[i - 1][j]);
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTsteps, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTsteps;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kTsteps, int kN>
+void Run(Args& args) {
+  kernel_jacobi_2d<kTsteps, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3));
+}
+
+template <int kTsteps, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_jacobi_2d<kTsteps, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kN]>(3));
+}
+
+template <int kTsteps = 40, int kN = 90>
+Kernel Instance() {
+  return {
+      Name("jacobi-2d", {kTsteps, kN}),
+      "jacobi-2d_kernel.c",
+      "kernel_jacobi_2d",
+      {
+          {"tsteps", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kN, kN}},
+          {"B", Type::kDouble, {kN, kN}},
+      },
+      Init<kTsteps, kN>,
+      Run<kTsteps, kN>,
+      Call<kTsteps, kN>,
+  };
+}
+}  // namespace k_jacobi_2d
+
+namespace k_md {
+template <int kAtoms, int kNeighbours>
+void md_kernel(double force_x[kAtoms],double force_y[kAtoms],double force_z[kAtoms],double position_x[kAtoms],double position_y[kAtoms],double position_z[kAtoms],int NL[(kAtoms * kNeighbours)])
+{
+  double delx;
+  double dely;
+  double delz;
+  double r2inv;
+  double r6inv;
+  double potential;
+  double force;
+  double j_x;
+  double j_y;
+  double j_z;
+  double i_x;
+  double i_y;
+  double i_z;
+  double fx;
+  double fy;
+  double fz;
+  int i;
+  int j;
+  int jidx;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  loop_i:
+  for (i = 0; i < kAtoms; i++) {
+    i_x = position_x[i];
+    i_y = position_y[i];
+    i_z = position_z[i];
+    fx = ((double )0);
+    fy = ((double )0);
+    fz = ((double )0);
+    loop_j:
+    for (j = 0; j < kNeighbours; j++) {
+// Get neighbor
+      jidx = NL[i * kNeighbours + j];
+// Look up x,y,z positions
+      j_x = position_x[jidx];
+      j_y = position_y[jidx];
+      j_z = position_z[jidx];
+// Calc distance
+      delx = i_x - j_x;
+      dely = i_y - j_y;
+      delz = i_z - j_z;
+      r2inv = 1.0 / (delx * delx + dely * dely + delz * delz);
+// Assume no cutoff and aways account for all nodes in area
+      r6inv = r2inv * r2inv * r2inv;
+      potential = r6inv * (1.5 * r6inv - 2.0);
+// Sum changes in force
+      force = r2inv * potential;
+      fx += delx * force;
+      fy += dely * force;
+      fz += delz * force;
+    }
+//Update forces after all neighbors accounted for.
+    force_x[i] = fx;
+    force_y[i] = fy;
+    force_z[i] = fz;
+//printf("dF=%lf,%lf,%lf\n", fx, fy, fz);
+  }
+}
+
+template <int kAtoms, int kNeighbours>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+  FillUniform(args.Ptr<double*>(5), args.Count(5), rng);
+  FillIndex(args.Ptr<int*>(6), args.Count(6), kAtoms, rng);
+}
+
+template <int kAtoms, int kNeighbours>
+void Run(Args& args) {
+  md_kernel<kAtoms, kNeighbours>(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<int*>(6));
+}
+
+template <int kAtoms, int kNeighbours>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&md_kernel<kAtoms, kNeighbours>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4),
+      args.Ptr<double*>(5),
+      args.Ptr<int*>(6));
+}
+
+template <int kAtoms = 256, int kNeighbours = 16>
+Kernel Instance() {
+  return {
+      Name("md", {kAtoms, kNeighbours}),
+      "md_kernel.c",
+      "md_kernel",
+      {
+          {"force_x", Type::kDouble, {kAtoms}},
+          {"force_y", Type::kDouble, {kAtoms}},
+          {"force_z", Type::kDouble, {kAtoms}},
+          {"position_x", Type::kDouble, {kAtoms}},
+          {"position_y", Type::kDouble, {kAtoms}},
+          {"position_z", Type::kDouble, {kAtoms}},
+          {"NL", Type::kInt, {(kAtoms * kNeighbours)}},
+      },
+      Init<kAtoms, kNeighbours>,
+      Run<kAtoms, kNeighbours>,
+      Call<kAtoms, kNeighbours>,
+  };
+}
+}  // namespace k_md
+
+namespace k_mvt {
+template <int kN>
+void kernel_mvt(double x1[kN], double x2[kN], double y_1[kN], double y_2[kN], double A[kN][kN])
+{
+  int i;
+  int j;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction = x1 FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kN; j++) {
+      x1[i] += A[i][j] * y_1[j];
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction = x2 FACTOR=auto{__PARA__L3}
+    for (j = 0; j < kN; j++) {
+      x2[i] += A[j][i] * y_2[j];
+    }
+  }
+//#pragma endscop
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_mvt<kN>(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_mvt<kN>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kN = 120>
+Kernel Instance() {
+  return {
+      Name("mvt", {kN}),
+      "mvt_kernel.c",
+      "kernel_mvt",
+      {
+          {"x1", Type::kDouble, {kN}},
+          {"x2", Type::kDouble, {kN}},
+          {"y_1", Type::kDouble, {kN}},
+          {"y_2", Type::kDouble, {kN}},
+          {"A", Type::kDouble, {kN, kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_mvt
+
+namespace k_mvt_medium {
+template <int kN>
+void kernel_mvt(double x1[kN],double x2[kN],double y_1[kN],double y_2[kN],double A[kN][kN])
+{
+  int i;
+  int j;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction = x1 FACTOR=auto{__PARA__L2}
+    for (j = 0; j < kN; j++) {
+      x1[i] += A[i][j] * y_1[j];
+    }
+  }
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL reduction = x2 FACTOR=auto{__PARA__L3}
+    for (j = 0; j < kN; j++) {
+      x2[i] += A[j][i] * y_2[j];
+    }
+  }
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  kernel_mvt<kN>(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_mvt<kN>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<double*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kN = 400>
+Kernel Instance() {
+  return {
+      Name("mvt-medium", {kN}),
+      "mvt-medium_kernel.c",
+      "kernel_mvt",
+      {
+          {"x1", Type::kDouble, {kN}},
+          {"x2", Type::kDouble, {kN}},
+          {"y_1", Type::kDouble, {kN}},
+          {"y_2", Type::kDouble, {kN}},
+          {"A", Type::kDouble, {kN, kN}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_mvt_medium
+
+namespace k_nw {
+template <int kN>
+void needwun(char SEQA[kN],char SEQB[kN],char alignedA[(2 * kN)],char alignedB[(2 * kN)],int M[((kN + 1) * (kN + 1))],char ptr[((kN + 1) * (kN + 1))])
+{
+  int score;
+  int up_left;
+  int up;
+  int left;
+  int max;
+  int row;
+  int row_up;
+  int r;
+  int a_idx;
+  int b_idx;
+  int a_str_idx;
+  int b_str_idx;
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  init_row:
+  for (a_idx = 0; a_idx < kN + 1; a_idx++) {
+    M[a_idx] = a_idx * - 1;
+  }
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+  init_col:
+  for (b_idx = 0; b_idx < kN + 1; b_idx++) {
+    M[b_idx * (kN + 1)] = b_idx * - 1;
+  }
+// Matrix filling loop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+  fill_out:
+  for (b_idx = 1; b_idx < kN + 1; b_idx++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+    fill_in:
+    for (a_idx = 1; a_idx < kN + 1; a_idx++) {
+      if (((int )SEQA[a_idx - 1]) == ((int )SEQB[b_idx - 1])) {
+        score = 1;
+      }
+       else {
+        score = - 1;
+      }
+      row_up = (b_idx - 1) * (kN + 1);
+      row = b_idx * (kN + 1);
+      up_left = M[row_up + (a_idx - 1)] + score;
+      up = M[row_up + a_idx] + - 1;
+      left = M[row + (a_idx - 1)] + - 1;
+      max = (up_left > ((up > left?up : left))?up_left : ((up > left?up : left)));
+      M[row + a_idx] = max;
+      if (max == left) {
+        ptr[row + a_idx] = ((char )60);
+      }
+       else {
+        if (max == up) {
+          ptr[row + a_idx] = ((char )94);
+        }
+         else {
+          ptr[row + a_idx] = ((char )92);
+        }
+      }
+    }
+  }
+// TraceBack (n.b. aligned sequences are backwards to avoid string appending)
+  a_idx = kN;
+  b_idx = kN;
+  a_str_idx = 0;
+  b_str_idx = 0;
+/*
+    trace: while(a_idx>0 || b_idx>0) {
+        r = b_idx*(ALEN+1);
+        if (ptr[r + a_idx] == ALIGN){
+            alignedA[a_str_idx++] = SEQA[a_idx-1];
+            alignedB[b_str_idx++] = SEQB[b_idx-1];
+            a_idx--;
+            b_idx--;
+        }
+        else if (ptr[r + a_idx] == SKIPB){
+            alignedA[a_str_idx++] = SEQA[a_idx-1];
+            alignedB[b_str_idx++] = '-';
+            a_idx--;
+        }
+        else{ // SKIPA
+            alignedA[a_str_idx++] = '-';
+            alignedB[b_str_idx++] = SEQB[b_idx-1];
+            b_idx--;
+        }
+    }
+    // Pad the result
+    pad_a: for( ; a_str_idx<ALEN+BLEN; a_str_idx++ ) {
+      alignedA[a_str_idx] = '_';
+    }
+    pad_b: for( ; b_str_idx<ALEN+BLEN; b_str_idx++ ) {
+      alignedB[b_str_idx] = '_';
+    }
+*/
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  FillSequence(args.Ptr<char*>(0), args.Count(0), rng);
+  FillSequence(args.Ptr<char*>(1), args.Count(1), rng);
+  FillSequence(args.Ptr<char*>(2), args.Count(2), rng);
+  FillSequence(args.Ptr<char*>(3), args.Count(3), rng);
+  FillInt(args.Ptr<int*>(4), args.Count(4), -100, 100, rng);
+  FillSequence(args.Ptr<char*>(5), args.Count(5), rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  needwun<kN>(
+      args.Ptr<char*>(0),
+      args.Ptr<char*>(1),
+      args.Ptr<char*>(2),
+      args.Ptr<char*>(3),
+      args.Ptr<int*>(4),
+      args.Ptr<char*>(5));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&needwun<kN>)>(function)(
+      args.Ptr<char*>(0),
+      args.Ptr<char*>(1),
+      args.Ptr<char*>(2),
+      args.Ptr<char*>(3),
+      args.Ptr<int*>(4),
+      args.Ptr<char*>(5));
+}
+
+template <int kN = 128>
+Kernel Instance() {
+  return {
+      Name("nw", {kN}),
+      "nw_kernel.c",
+      "needwun",
+      {
+          {"SEQA", Type::kChar, {kN}},
+          {"SEQB", Type::kChar, {kN}},
+          {"alignedA", Type::kChar, {(2 * kN)}},
+          {"alignedB", Type::kChar, {(2 * kN)}},
+          {"M", Type::kInt, {((kN + 1) * (kN + 1))}},
+          {"ptr", Type::kChar, {((kN + 1) * (kN + 1))}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_nw
+
+namespace k_seidel_2d {
+template <int kTsteps, int kN>
+void kernel_seidel_2d(int tsteps,int n,double A[kN][kN])
+{
+  int t;
+  int i;
+  int j;
+//#pragma scop
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (t = 0; t <= (kTsteps - 1); t++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (i = 1; i <= (kN - 2); i++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+      for (j = 1; j <= (kN - 2); j++) {
+        A[i][j] = (A[i - 1][j - 1] + A[i - 1][j] + A[i - 1][j + 1] + A[i][j - 1] + A[i][j] + A[i][j + 1] + A[i + 1][j - 1] + A[i + 1][j] + A[i + 1][j + 1]) / 9.0;
+      }
+    }
+  }
+//#pragma endscop
+}
+
+template <int kTsteps, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<int>(0) = kTsteps;
+  args.Value<int>(1) = kN;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kTsteps, int kN>
+void Run(Args& args) {
+  kernel_seidel_2d<kTsteps, kN>(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kTsteps, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_seidel_2d<kTsteps, kN>)>(function)(
+      args.Value<int>(0),
+      args.Value<int>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kTsteps = 40, int kN = 120>
+Kernel Instance() {
+  return {
+      Name("seidel-2d", {kTsteps, kN}),
+      "seidel-2d_kernel.c",
+      "kernel_seidel_2d",
+      {
+          {"tsteps", Type::kInt, {}},
+          {"n", Type::kInt, {}},
+          {"A", Type::kDouble, {kN, kN}},
+      },
+      Init<kTsteps, kN>,
+      Run<kTsteps, kN>,
+      Call<kTsteps, kN>,
+  };
+}
+}  // namespace k_seidel_2d
+
+namespace k_spmv_crs {
+template <int kN, int kNnz>
+void spmv(double val[kNnz],int cols[kNnz],int rowDelimiters[(kN + 1)],double vec[kN],double out[kN])
+{
+  int i;
+  int j;
+  double sum;
+  double Si;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  spmv_1:
+  for (i = 0; i < kN; i++) {
+    sum = ((double )0);
+    Si = ((double )0);
+    int tmp_begin = rowDelimiters[i];
+    int tmp_end = rowDelimiters[i + 1];
+    spmv_2:
+    for (j = tmp_begin; j < tmp_end; j++) {
+      Si = val[j] * vec[cols[j]];
+      sum = sum + Si;
+    }
+    out[i] = sum;
+  }
+}
+
+template <int kN, int kNnz>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillIndex(args.Ptr<int*>(1), args.Count(1), kN, rng);
+  FillRowDelimiters(args.Ptr<int*>(2), kN, kNnz, rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kN, int kNnz>
+void Run(Args& args) {
+  spmv<kN, kNnz>(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+template <int kN, int kNnz>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&spmv<kN, kNnz>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2),
+      args.Ptr<double*>(3),
+      args.Ptr<double*>(4));
+}
+
+template <int kN = 494, int kNnz = 1666>
+Kernel Instance() {
+  return {
+      Name("spmv-crs", {kN, kNnz}),
+      "spmv-crs_kernel.c",
+      "spmv",
+      {
+          {"val", Type::kDouble, {kNnz}},
+          {"cols", Type::kInt, {kNnz}},
+          {"rowDelimiters", Type::kInt, {(kN + 1)}},
+          {"vec", Type::kDouble, {kN}},
+          {"out", Type::kDouble, {kN}},
+      },
+      Init<kN, kNnz>,
+      Run<kN, kNnz>,
+      Call<kN, kNnz>,
+  };
+}
+}  // namespace k_spmv_crs
+
+namespace k_spmv_ellpack {
+template <int kN, int kL>
+void ellpack(double nzval[(kN * kL)],int cols[(kN * kL)],double vec[kN],double out[kN])
+{
+  int i;
+  int j;
+  double Si;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  ellpack_1:
+  for (i = 0; i < kN; i++) {
+    double sum = out[i];
+    ellpack_2:
+    for (j = 0; j < kL; j++) {
+      Si = nzval[j + i * kL] * vec[cols[j + i * kL]];
+      sum += Si;
+    }
+    out[i] = sum;
+  }
+}
+
+template <int kN, int kL>
+void Init(Args& args, Rng& rng) {
+  FillUniform(args.Ptr<double*>(0), args.Count(0), rng);
+  FillIndex(args.Ptr<int*>(1), args.Count(1), kN, rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kN, int kL>
+void Run(Args& args) {
+  ellpack<kN, kL>(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kN, int kL>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&ellpack<kN, kL>)>(function)(
+      args.Ptr<double*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<double*>(2),
+      args.Ptr<double*>(3));
+}
+
+template <int kN = 494, int kL = 10>
+Kernel Instance() {
+  return {
+      Name("spmv-ellpack", {kN, kL}),
+      "spmv-ellpack_kernel.c",
+      "ellpack",
+      {
+          {"nzval", Type::kDouble, {(kN * kL)}},
+          {"cols", Type::kInt, {(kN * kL)}},
+          {"vec", Type::kDouble, {kN}},
+          {"out", Type::kDouble, {kN}},
+      },
+      Init<kN, kL>,
+      Run<kN, kL>,
+      Call<kN, kL>,
+  };
+}
+}  // namespace k_spmv_ellpack
+
+namespace k_stencil {
+template <int kRows, int kCols>
+void stencil(int orig[(kRows * kCols)],int sol[(kRows * kCols)],int filter[9])
+{
+  int r;
+  int c;
+  int k1;
+  int k2;
+  int temp;
+  int mul;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  stencil_label1:
+  for (r = 0; r < kRows - 2; r++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    stencil_label2:
+    for (c = 0; c < kCols - 2; c++) {
+      temp = ((int )0);
+      
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+      stencil_label3:
+      for (k1 = 0; k1 < 3; k1++) {
+        stencil_label4:
+        for (k2 = 0; k2 < 3; k2++) {
+          mul = filter[k1 * 3 + k2] * orig[(r + k1) * kCols + c + k2];
+          temp += mul;
+        }
+      }
+      sol[r * kCols + c] = temp;
+    }
+  }
+}
+
+template <int kRows, int kCols>
+void Init(Args& args, Rng& rng) {
+  FillInt(args.Ptr<int*>(0), args.Count(0), -100, 100, rng);
+  FillInt(args.Ptr<int*>(1), args.Count(1), -100, 100, rng);
+  FillInt(args.Ptr<int*>(2), args.Count(2), -100, 100, rng);
+}
+
+template <int kRows, int kCols>
+void Run(Args& args) {
+  stencil<kRows, kCols>(
+      args.Ptr<int*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2));
+}
+
+template <int kRows, int kCols>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&stencil<kRows, kCols>)>(function)(
+      args.Ptr<int*>(0),
+      args.Ptr<int*>(1),
+      args.Ptr<int*>(2));
+}
+
+template <int kRows = 128, int kCols = 64>
+Kernel Instance() {
+  return {
+      Name("stencil", {kRows, kCols}),
+      "stencil_stencil2d_kernel.c",
+      "stencil",
+      {
+          {"orig", Type::kInt, {(kRows * kCols)}},
+          {"sol", Type::kInt, {(kRows * kCols)}},
+          {"filter", Type::kInt, {9}},
+      },
+      Init<kRows, kCols>,
+      Run<kRows, kCols>,
+      Call<kRows, kCols>,
+  };
+}
+}  // namespace k_stencil
+
+namespace k_stencil_3d {
+template <int kN>
+void stencil3d(long C0,long C1,long orig[((kN + 2) * (kN + 2) * (kN + 2))],long sol[(kN * kN * kN)])
+{
+  long sum0;
+  long sum1;
+  long mul0;
+  long mul1;
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  for (long i = 1; i < (kN + 1); i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    for (long j = 1; j < (kN + 1); j++) {
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+      for (long ko = 0; ko <= (kN - 1); ko++) {
+        long _in_ko = 1L + 1L * ko;
+        sum0 = orig[_in_ko + (0) + ((kN + 2)) * (j + ((kN + 2)) * i)];
+        sum1 = orig[_in_ko + (0) + ((kN + 2)) * (j + ((kN + 2)) * (i + (1)))] + orig[_in_ko + (0) + ((kN + 2)) * (j + ((kN + 2)) * (i - (1)))] + orig[_in_ko + (0) + ((kN + 2)) * (j + (1) + ((kN + 2)) * i)] + orig[_in_ko + (0) + ((kN + 2)) * (j - (1) + ((kN + 2)) * i)] + orig[_in_ko + (0) + (1) + ((kN + 2)) * (j + ((kN + 2)) * i)] + orig[_in_ko + (0) - (1) + ((kN + 2)) * (j + ((kN + 2)) * i)];
+        mul0 = sum0 * C0;
+        mul1 = sum1 * C1;
+        sol[_in_ko + (0) + ((kN + 2)) * (j + ((kN + 2)) * i)] = mul0 + mul1;
+      }
+    }
+  }
+}
+
+template <int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<long>(0) = 2;
+  args.Value<long>(1) = -1;
+  FillInt(args.Ptr<long*>(2), args.Count(2), -100L, 100L, rng);
+  FillInt(args.Ptr<long*>(3), args.Count(3), -100L, 100L, rng);
+}
+
+template <int kN>
+void Run(Args& args) {
+  stencil3d<kN>(
+      args.Value<long>(0),
+      args.Value<long>(1),
+      args.Ptr<long*>(2),
+      args.Ptr<long*>(3));
+}
+
+template <int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&stencil3d<kN>)>(function)(
+      args.Value<long>(0),
+      args.Value<long>(1),
+      args.Ptr<long*>(2),
+      args.Ptr<long*>(3));
+}
+
+template <int kN = 32>
+Kernel Instance() {
+  return {
+      Name("stencil-3d", {kN}),
+      "stencil-3d_kernel.c",
+      "stencil3d",
+      {
+          {"C0", Type::kLong, {}},
+          {"C1", Type::kLong, {}},
+          {"orig", Type::kLong, {((kN + 2) * (kN + 2) * (kN + 2))}},
+          {"sol", Type::kLong, {((kN + 2) * (kN + 2) * (kN + 2))}},
+      },
+      Init<kN>,
+      Run<kN>,
+      Call<kN>,
+  };
+}
+}  // namespace k_stencil_3d
+
+namespace k_symm {
+template <int kM, int kN>
+void kernel_symm(double alpha,double beta,double C[kM][kN],double A[kM][kM],double B[kM][kN])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//SIDE = 'L'
+//UPLO = 'L'
+// =>  Form  C := alpha*A*B + beta*C
+// A is MxM
+// B is MxN
+// C is MxN
+//note that due to Fortran array layout, the code below more closely resembles upper triangular case in BLAS
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      double temp2 = ((double )0);
+      
+#pragma ACCEL PARALLEL reduction=temp2 FACTOR=auto{__PARA__L2}
+      for (k = 0; k < kM; k++) {
+        if (k < i) {
+          C[k][j] += alpha * B[i][j] * A[i][k];
+          temp2 += B[k][j] * A[i][k];
+        }
+      }
+      C[i][j] = beta * C[i][j] + alpha * B[i][j] * A[i][i] + alpha * temp2;
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_symm<kM, kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("symm", {kM, kN}),
+      "symm_kernel.c",
+      "kernel_symm",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kM, kN}},
+          {"A", Type::kDouble, {kM, kM}},
+          {"B", Type::kDouble, {kM, kN}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_symm
+
+namespace k_symm_opt {
+template <int kM, int kN>
+void kernel_symm(double alpha,double beta,double C[kM][kN],double A[kM][kM],double B[kM][kN])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//SIDE = 'L'
+//UPLO = 'L'
+// =>  Form  C := alpha*A*B + beta*C
+// A is MxM
+// B is MxN
+// C is MxN
+//note that due to Fortran array layout, the code below more closely resembles upper triangular case in BLAS
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      
+      double tmp = B[i][j];
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+      for (k = 0; k < kM; k++) {
+        if (k < i) {
+          C[k][j] += alpha * tmp * A[i][k];
+        }
+      }
+
+      double temp2 = ((double )0);
+#pragma ACCEL PARALLEL reduction=temp2 FACTOR=auto{__PARA__L3}
+      for (k = 0; k < kM; k++) {
+        if (k < i) {
+          temp2 += B[k][j] * A[i][k];
+        }
+      }
+      C[i][j] = beta * C[i][j] + alpha * B[i][j] * A[i][i] + alpha * temp2;
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_symm<kM, kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("symm-opt", {kM, kN}),
+      "symm-opt_kernel.c",
+      "kernel_symm",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kM, kN}},
+          {"A", Type::kDouble, {kM, kM}},
+          {"B", Type::kDouble, {kM, kN}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_symm_opt
+
+namespace k_symm_opt_medium {
+template <int kM, int kN>
+void kernel_symm(double alpha,double beta,double C[kM][kN],double A[kM][kM],double B[kM][kN])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//SIDE = 'L'
+//UPLO = 'L'
+// =>  Form  C := alpha*A*B + beta*C
+// A is MxM
+// B is MxN
+// C is MxN
+//note that due to Fortran array layout, the code below more closely resembles upper triangular case in BLAS
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      double tmp = B[i][j];
+      
+#pragma ACCEL PARALLEL reduction=C FACTOR=auto{__PARA__L2}
+      for (k = 0; k < kM; k++) {
+        if (k < i) {
+          C[k][j] += alpha * tmp * A[i][k];
+        }
+      }
+      double temp2 = (double )0;
+      
+#pragma ACCEL PARALLEL reduction=temp2 FACTOR=auto{__PARA__L3}
+      for (k = 0; k < kM; k++) {
+        if (k < i) {
+          temp2 += B[k][j] * A[i][k];
+        }
+      }
+      C[i][j] = beta * C[i][j] + alpha * B[i][j] * A[i][i] + alpha * temp2;
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_symm<kM, kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_symm<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kN]>(4));
+}
+
+template <int kM = 200, int kN = 240>
+Kernel Instance() {
+  return {
+      Name("symm-opt-medium", {kM, kN}),
+      "symm-opt-medium_kernel.c",
+      "kernel_symm",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kM, kN}},
+          {"A", Type::kDouble, {kM, kM}},
+          {"B", Type::kDouble, {kM, kN}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_symm_opt_medium
+
+namespace k_syr2k {
+template <int kM, int kN>
+void kernel_syr2k(double alpha,double beta,double C[kN][kN],double A[kN][kM],double B[kN][kM])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//UPLO  = 'L'
+//TRANS = 'N'
+//A is NxM
+//B is NxM
+//C is NxN
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      if (j <= i) {
+        C[i][j] *= beta;
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (k = 0; k < kM; k++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+      for (j = 0; j < kN; j++) {
+        if (j <= i) {
+          C[i][j] += A[j][k] * alpha * B[i][k] + B[j][k] * alpha * A[i][k];
+        }
+      }
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+  FillUniform(args.Ptr<double*>(4), args.Count(4), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_syr2k<kM, kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kM]>(4));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_syr2k<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3),
+      args.Ptr<double(*)[kM]>(4));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("syr2k", {kM, kN}),
+      "syr2k_kernel.c",
+      "kernel_syr2k",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kN, kN}},
+          {"A", Type::kDouble, {kN, kM}},
+          {"B", Type::kDouble, {kN, kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_syr2k
+
+namespace k_syrk {
+template <int kM, int kN>
+void kernel_syrk(double alpha,double beta,double C[kN][kN],double A[kN][kM])
+{
+  int i;
+  int j;
+  int k;
+//BLAS PARAMS
+//TRANS = 'N'
+//UPLO  = 'L'
+// =>  Form  C := alpha*A*A**T + beta*C.
+//A is NxM
+//C is NxN
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (i = 0; i < kN; i++) {
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (j = 0; j < kN; j++) {
+      if (j <= i) {
+        C[i][j] *= beta;
+      }
+    }
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L2}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L2}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L2}
+    for (k = 0; k < kM; k++) {
+      
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L3}
+      for (j = 0; j < kN; j++) {
+        if (j <= i) {
+          C[i][j] += alpha * A[i][k] * A[j][k];
+        }
+      }
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  args.Value<double>(1) = 1.2;
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+  FillUniform(args.Ptr<double*>(3), args.Count(3), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_syrk<kM, kN>(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_syrk<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Value<double>(1),
+      args.Ptr<double(*)[kN]>(2),
+      args.Ptr<double(*)[kM]>(3));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("syrk", {kM, kN}),
+      "syrk_kernel.c",
+      "kernel_syrk",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"beta", Type::kDouble, {}},
+          {"C", Type::kDouble, {kN, kN}},
+          {"A", Type::kDouble, {kN, kM}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_syrk
+
+namespace k_trmm {
+template <int kM, int kN>
+void kernel_trmm(double alpha,double A[kM][kM],double B[kM][kN])
+{
+//BLAS parameters
+//SIDE   = 'L'
+//UPLO   = 'L'
+//TRANSA = 'T'
+//DIAG   = 'U'
+// => Form  B := alpha*A**T*B.
+// A is MxM
+// B is MxN
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (int i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (int j = 0; j < kN; j++) {
+      
+#pragma ACCEL PARALLEL reduction=B FACTOR=auto{__PARA__L2}
+      for (int k = 0; k < kM; k++) {
+        if (k > i) {
+          B[i][j] += A[k][i] * B[k][j];
+        }
+      }
+      B[i][j] = alpha * B[i][j];
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_trmm<kM, kN>(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_trmm<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("trmm", {kM, kN}),
+      "trmm_kernel.c",
+      "kernel_trmm",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"A", Type::kDouble, {kM, kM}},
+          {"B", Type::kDouble, {kM, kN}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_trmm
+
+namespace k_trmm_opt {
+template <int kM, int kN>
+void kernel_trmm(double alpha,double A[kM][kM],double B[kM][kN])
+{
+//BLAS parameters
+//SIDE   = 'L'
+//UPLO   = 'L'
+//TRANSA = 'T'
+//DIAG   = 'U'
+// => Form  B := alpha*A**T*B.
+// A is MxM
+// B is MxN
+  
+#pragma ACCEL PIPELINE auto{__PIPE__L0}
+  
+#pragma ACCEL TILE FACTOR=auto{__TILE__L0}
+  
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L0}
+  for (int i = 0; i < kM; i++) {
+    
+#pragma ACCEL PIPELINE auto{__PIPE__L1}
+    
+#pragma ACCEL TILE FACTOR=auto{__TILE__L1}
+    
+#pragma ACCEL PARALLEL FACTOR=auto{__PARA__L1}
+    for (int j = 0; j < kN; j++) {
+      double sum = B[i][j];
+#pragma ACCEL PARALLEL reduction=sum FACTOR=auto{__PARA__L2}
+      for (int k = 0; k < kM; k++) {
+        if (k > i) {
+          sum += A[k][i] * B[k][j];
+        }
+      }
+      B[i][j] = alpha * sum;
+    }
+  }
+}
+
+template <int kM, int kN>
+void Init(Args& args, Rng& rng) {
+  args.Value<double>(0) = 1.5;
+  FillUniform(args.Ptr<double*>(1), args.Count(1), rng);
+  FillUniform(args.Ptr<double*>(2), args.Count(2), rng);
+}
+
+template <int kM, int kN>
+void Run(Args& args) {
+  kernel_trmm<kM, kN>(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kM, int kN>
+void Call(void (*function)(), Args& args) {
+  reinterpret_cast<decltype(&kernel_trmm<kM, kN>)>(function)(
+      args.Value<double>(0),
+      args.Ptr<double(*)[kM]>(1),
+      args.Ptr<double(*)[kN]>(2));
+}
+
+template <int kM = 60, int kN = 80>
+Kernel Instance() {
+  return {
+      Name("trmm-opt", {kM, kN}),
+      "trmm-opt_kernel.c",
+      "kernel_trmm",
+      {
+          {"alpha", Type::kDouble, {}},
+          {"A", Type::kDouble, {kM, kM}},
+          {"B", Type::kDouble, {kM, kN}},
+      },
+      Init<kM, kN>,
+      Run<kM, kN>,
+      Call<kM, kN>,
+  };
+}
+}  // namespace k_trmm_opt
+
+// Every sized kernel at the sizes of its source, sorted by name.
+inline std::vector<Kernel> Defaults() {
+  return {
+      k_2mm::Instance<>(),
+      k_3mm::Instance<>(),
+      k_adi::Instance<>(),
+      k_atax::Instance<>(),
+      k_atax_medium::Instance<>(),
+      k_bicg::Instance<>(),
+      k_bicg_large::Instance<>(),
+      k_bicg_medium::Instance<>(),
+      k_correlation::Instance<>(),
+      k_covariance::Instance<>(),
+      k_doitgen::Instance<>(),
+      k_doitgen_red::Instance<>(),
+      k_fdtd_2d::Instance<>(),
+      k_fdtd_2d_large::Instance<>(),
+      k_gemm_blocked::Instance<>(),
+      k_gemm_ncubed::Instance<>(),
+      k_gemm_p::Instance<>(),
+      k_gemm_p_large::Instance<>(),
+      k_gemver::Instance<>(),
+      k_gemver_medium::Instance<>(),
+      k_gesummv::Instance<>(),
+      k_gesummv_medium::Instance<>(),
+      k_heat_3d::Instance<>(),
+      k_jacobi_1d::Instance<>(),
+      k_jacobi_2d::Instance<>(),
+      k_md::Instance<>(),
+      k_mvt::Instance<>(),
+      k_mvt_medium::Instance<>(),
+      k_nw::Instance<>(),
+      k_seidel_2d::Instance<>(),
+      k_spmv_crs::Instance<>(),
+      k_spmv_ellpack::Instance<>(),
+      k_stencil::Instance<>(),
+      k_stencil_3d::Instance<>(),
+      k_symm::Instance<>(),
+      k_symm_opt::Instance<>(),
+      k_symm_opt_medium::Instance<>(),
+      k_syr2k::Instance<>(),
+      k_syrk::Instance<>(),
+      k_trmm::Instance<>(),
+      k_trmm_opt::Instance<>(),
+  };
+}
+
+}  // namespace sized
+}  // namespace kernels
+
+#endif
@@ -0,0 +1,158 @@
+#include "kernels.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace kernels {
+
+namespace {
+
+const size_t kAlignment = 64;
+
+void* AllocateAligned(size_t bytes) {
+  // aligned_alloc requires the size to be a multiple of the alignment.
+  size_t padded = (std::max<size_t>(bytes, 1) + kAlignment - 1) / kAlignment *
+                  kAlignment;
+  void* p = std::aligned_alloc(kAlignment, padded);
+  if (p == nullptr) throw std::bad_alloc();
+  std::memset(p, 0, padded);
+  return p;
+}
+
+}  // namespace
+
+size_t SizeOf(Type type) {
+  switch (type) {
+    case Type::kChar: return sizeof(char);
+    case Type::kUChar: return sizeof(unsigned char);
+    case Type::kInt: return sizeof(int);
+    case Type::kLong: return sizeof(long);
+    case Type::kDouble: return sizeof(double);
+  }
+  return 0;
+}
+
+const char* TypeName(Type type) {
+  switch (type) {
+    case Type::kChar: return "char";
+    case Type::kUChar: return "unsigned char";
+    case Type::kInt: return "int";
+    case Type::kLong: return "long";
+    case Type::kDouble: return "double";
+  }
+  return "?";
+}
+
+size_t ArgSpec::Count() const {
+  size_t count = 1;
+  for (int d : shape) count *= d;
+  return count;
+}
+
+void Args::Free::operator()(void* p) const {
+  if (mapping != nullptr) {
+    munmap(mapping, length);
+  } else {
+    std::free(p);
+  }
+}
+
+Args::Args(const std::vector<ArgSpec>& specs) : specs_(specs) {
+  for (const ArgSpec& spec : specs_) {
+    buffers_.emplace_back(AllocateAligned(spec.Bytes()));
+  }
+}
+
+Args::Args(const Args& other) : Args(other.specs_) {
+  for (int i = 0; i < Size(); ++i) {
+    std::memcpy(Data(i), other.Data(i), Bytes(i));
+  }
+}
+
+Args& Args::operator=(const Args& other) {
+  if (this != &other) *this = Args(other);
+  return *this;
+}
+
+Args Args::Guarded(const Args& other) {
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  Args args;
+  args.specs_ = other.specs_;
+  for (int i = 0; i < other.Size(); ++i) {
+    // A guard page on either side; the buffer ends at the upper one.
+    const size_t bytes = other.Bytes(i);
+    const size_t length = ((bytes + page - 1) / page + 2) * page;
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) throw std::bad_alloc();
+    char* base = static_cast<char*>(mapping);
+    mprotect(base, page, PROT_NONE);
+    mprotect(base + length - page, page, PROT_NONE);
+    char* data = base + length - page - bytes;
+    std::memcpy(data, other.Data(i), bytes);
+    args.buffers_.emplace_back(data, Free{mapping, length});
+  }
+  return args;
+}
+
+const Kernel* FindKernel(const std::string& name) {
+  for (const Kernel& kernel : Registry()) {
+    if (kernel.name == name) return &kernel;
+  }
+  return nullptr;
+}
+
+Args MakeArgs(const Kernel& kernel, unsigned seed) {
+  Args args(kernel.args);
+  Rng rng(seed);
+  kernel.init(args, rng);
+  return args;
+}
+
+void FillUniform(double* data, size_t count, Rng& rng) {
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (size_t i = 0; i < count; ++i) data[i] = dist(rng);
+}
+
+void FillInt(int* data, size_t count, int lo, int hi, Rng& rng) {
+  std::uniform_int_distribution<int> dist(lo, hi);
+  for (size_t i = 0; i < count; ++i) data[i] = dist(rng);
+}
+
+void FillInt(long* data, size_t count, long lo, long hi, Rng& rng) {
+  std::uniform_int_distribution<long> dist(lo, hi);
+  for (size_t i = 0; i < count; ++i) data[i] = dist(rng);
+}
+
+void FillBytes(unsigned char* data, size_t count, Rng& rng) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = static_cast<unsigned char>(dist(rng));
+  }
+}
+
+void FillSequence(char* data, size_t count, Rng& rng) {
+  static const char kAlphabet[] = "ACGT";
+  std::uniform_int_distribution<int> dist(0, 3);
+  for (size_t i = 0; i < count; ++i) data[i] = kAlphabet[dist(rng)];
+}
+
+void FillIndex(int* data, size_t count, int bound, Rng& rng) {
+  FillInt(data, count, 0, bound - 1, rng);
+}
+
+void FillRowDelimiters(int* data, int rows, int nnz, Rng& rng) {
+  // Cut [0, nnz] at rows - 1 sorted random points.
+  std::uniform_int_distribution<int> dist(0, nnz);
+  data[0] = 0;
+  for (int i = 1; i < rows; ++i) data[i] = dist(rng);
+  data[rows] = nnz;
+  std::sort(data + 1, data + rows);
+}
+
+}  // namespace kernels
@@ -0,0 +1,112 @@
+#ifndef KERNELS_H_
+#define KERNELS_H_
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Native library of the HLS kernels in data/sources. Every kernel is compiled
+// once into its own namespace (see kernels-registry.cpp, generated by
+// gen_kernels.py) and described by a registry entry, so that benchmarks and
+// verifiers can allocate, initialise and run any kernel in-process by name.
+namespace kernels {
+
+using Rng = std::mt19937;
+
+enum class Type { kChar, kUChar, kInt, kLong, kDouble };
+
+size_t SizeOf(Type type);
+const char* TypeName(Type type);
+
+// One argument of a kernel's top-level function. Scalars have an empty shape.
+struct ArgSpec {
+  std::string name;
+  Type type;
+  std::vector<int> shape;
+
+  size_t Count() const;
+  size_t Bytes() const { return Count() * SizeOf(type); }
+};
+
+// Argument storage for one invocation: a 64-byte aligned buffer per argument,
+// scalars included. Copies are deep, so one initialised set of arguments can be
+// handed to several implementations of the same kernel.
+class Args {
+ public:
+  explicit Args(const std::vector<ArgSpec>& specs);
+  Args(const Args& other);
+  Args& operator=(const Args& other);
+  Args(Args&&) = default;
+  Args& operator=(Args&&) = default;
+
+  // A copy whose buffers each end right before an inaccessible page, so that
+  // a kernel running past the end of an array faults at once and the same way
+  // every time, instead of reading or clobbering whatever the heap holds
+  // there. For running untrusted builds of a kernel.
+  static Args Guarded(const Args& other);
+
+  int Size() const { return static_cast<int>(buffers_.size()); }
+  void* Data(int i) { return buffers_[i].get(); }
+  const void* Data(int i) const { return buffers_[i].get(); }
+  size_t Count(int i) const { return specs_[i].Count(); }
+  size_t Bytes(int i) const { return specs_[i].Bytes(); }
+  const ArgSpec& Spec(int i) const { return specs_[i]; }
+
+  template <typename T>
+  T Ptr(int i) {
+    return reinterpret_cast<T>(Data(i));
+  }
+  template <typename T>
+  T& Value(int i) {
+    return *static_cast<T*>(Data(i));
+  }
+
+ private:
+  Args() = default;
+
+  struct Free {
+    void* mapping = nullptr;  // the guarded mapping of the buffer, if any
+    size_t length = 0;
+    void operator()(void* p) const;
+  };
+
+  std::vector<ArgSpec> specs_;
+  std::vector<std::unique_ptr<void, Free>> buffers_;
+};
+
+struct Kernel {
+  std::string name;      // data/designs name, e.g. "gemm-ncubed"
+  std::string source;    // file in data/sources, e.g. "gemm-ncubed_kernel.c"
+  std::string function;  // top-level C function, e.g. "gemm"
+  std::vector<ArgSpec> args;
+  void (*init)(Args& args, Rng& rng);
+  void (*run)(Args& args);
+  // Runs another build of `function` with the same signature, e.g. one loaded
+  // with dlopen, on args.
+  void (*call)(void (*function)(), Args& args);
+};
+
+// All kernels in data/sources, sorted by name.
+const std::vector<Kernel>& Registry();
+
+// Returns nullptr when no kernel has the given name.
+const Kernel* FindKernel(const std::string& name);
+
+// Allocates the arguments of a kernel and fills them from a seeded generator.
+Args MakeArgs(const Kernel& kernel, unsigned seed = 42);
+
+// Input initialisers used by the registry.
+void FillUniform(double* data, size_t count, Rng& rng);  // in [-1, 1)
+void FillInt(int* data, size_t count, int lo, int hi, Rng& rng);
+void FillInt(long* data, size_t count, long lo, long hi, Rng& rng);
+void FillBytes(unsigned char* data, size_t count, Rng& rng);
+void FillSequence(char* data, size_t count, Rng& rng);  // over "ACGT"
+void FillIndex(int* data, size_t count, int bound, Rng& rng);
+// CRS row pointers: non-decreasing, starting at 0 and ending at nnz.
+void FillRowDelimiters(int* data, int rows, int nnz, Rng& rng);
+
+}  // namespace kernels
+
+#endif
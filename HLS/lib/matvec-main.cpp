@@ -0,0 +1,230 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+#include "matvec.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using check::Arrays;
+
+namespace {
+
+// Independent accumulators and per-band shares reassociate the sums.
+const double kTolerance = 1e-9;
+
+enum class Op { kBicg, kAtax, kMvt, kGesummv };
+
+const char* OpName(Op op) {
+  switch (op) {
+    case Op::kBicg: return "bicg";
+    case Op::kAtax: return "atax";
+    case Op::kMvt: return "mvt";
+    case Op::kGesummv: return "gesummv";
+  }
+  return "?";
+}
+
+// A kernel invocation: its array arguments in signature order and its double
+// scalars (alpha and beta of gesummv). mvt and gesummv are rows x rows.
+struct Problem {
+  Op op;
+  int rows;
+  int cols;
+  vector<double> scalars;
+  Arrays arrays;
+};
+
+// Runs the reference or the fast version on the problem's arrays.
+void Apply(Problem& p, bool fast) {
+  Arrays& v = p.arrays;
+  switch (p.op) {
+    case Op::kBicg:
+      (fast ? matvec::Bicg : matvec::BicgReference)(
+          p.rows, p.cols, v[0].data(), v[1].data(), v[2].data(), v[3].data(),
+          v[4].data());
+      break;
+    case Op::kAtax:
+      (fast ? matvec::Atax : matvec::AtaxReference)(
+          p.rows, p.cols, v[0].data(), v[1].data(), v[2].data(),
+          v[3].data());
+      break;
+    case Op::kMvt:
+      (fast ? matvec::Mvt : matvec::MvtReference)(
+          p.rows, v[0].data(), v[1].data(), v[2].data(), v[3].data(),
+          v[4].data());
+      break;
+    case Op::kGesummv:
+      (fast ? matvec::Gesummv : matvec::GesummvReference)(
+          p.rows, p.scalars[0], p.scalars[1], v[0].data(), v[1].data(),
+          v[2].data(), v[3].data(), v[4].data());
+      break;
+  }
+}
+
+// The arrays after a run on a copy of the problem.
+Arrays Run(Problem p, bool fast) {
+  Apply(p, fast);
+  return p.arrays;
+}
+
+// The problem a registry kernel is run on, taken from its arguments.
+Problem FromArgs(Op op, const kernels::Args& args) {
+  Problem p{op, 0, 0, {}, {}};
+  for (int i = 0; i < args.Size(); ++i) {
+    const kernels::ArgSpec& spec = args.Spec(i);
+    if (spec.type != kernels::Type::kDouble) continue;
+    const double* data = static_cast<const double*>(args.Data(i));
+    if (spec.shape.empty()) {
+      p.scalars.push_back(*data);
+      continue;
+    }
+    p.arrays.emplace_back(data, data + args.Count(i));
+    if (spec.shape.size() == 2 && p.rows == 0) {
+      p.rows = spec.shape[0];
+      p.cols = spec.shape[1];
+    }
+  }
+  return p;
+}
+
+Problem RandomProblem(Op op, int rows, int cols, kernels::Rng& rng) {
+  Problem p{op, rows, cols, {1.5, 1.2}, {}};
+  const size_t r = rows, c = cols, n = rows;
+  const vector<size_t> sizes =
+      op == Op::kBicg      ? vector<size_t>{r * c, c, r, c, r}
+      : op == Op::kAtax    ? vector<size_t>{r * c, c, c, r}
+      : op == Op::kMvt     ? vector<size_t>{n, n, n, n, n * n}
+                           : vector<size_t>{n * n, n * n, n, n, n};
+  p.arrays.resize(sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    p.arrays[i].resize(sizes[i]);
+    kernels::FillUniform(p.arrays[i].data(), sizes[i], rng);
+  }
+  return p;
+}
+
+// Checks the reference bit for bit and the fast version to kTolerance
+// against `expected`.
+int Check(const string& name, const Problem& p, const Arrays& expected) {
+  int error = 0;
+  if (!check::Same(Run(p, false), expected)) {
+    clog << name << ": reference differs" << endl;
+    ++error;
+  }
+  const double e = check::Error(Run(p, true), expected);
+  if (!(e <= kTolerance)) {
+    clog << name << ": fast version differs, error " << e << endl;
+    ++error;
+  }
+  return error;
+}
+
+}  // namespace
+
+// Checks the fused matrix-vector products against every bicg, atax, mvt and
+// gesummv kernel and the reference loops on many shapes, then times both on
+// rows x cols matrices:
+//   matvec [rows cols]...
+int main(int argc, char** argv) {
+  vector<std::pair<int, int>> sizes;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    sizes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1])});
+  }
+  for (auto [rows, cols] : sizes) {
+    if (rows < 1 || cols < 1) argc = 0;
+  }
+  if (argc % 2 == 0) {
+    clog << "Usage: " << argv[0] << " [rows cols]...\n";
+    return EXIT_FAILURE;
+  }
+  if (sizes.empty()) sizes = {{400, 400}, {2000, 3000}, {5000, 5000}};
+
+  const vector<std::pair<string, Op>> registry = {
+      {"atax", Op::kAtax},       {"atax-medium", Op::kAtax},
+      {"bicg", Op::kBicg},       {"bicg-large", Op::kBicg},
+      {"bicg-medium", Op::kBicg}, {"gesummv", Op::kGesummv},
+      {"gesummv-medium", Op::kGesummv}, {"mvt", Op::kMvt},
+      {"mvt-medium", Op::kMvt}};
+  const Op ops[] = {Op::kBicg, Op::kAtax, Op::kMvt, Op::kGesummv};
+
+  int error = 0;
+  kernels::Rng rng(42);
+  for (matvec::Isa isa : {matvec::Isa::kGeneric, matvec::Isa::kAvx512}) {
+    if (!matvec::SetIsa(isa)) continue;
+    clog << "Check " << matvec::IsaName(isa) << endl;
+    for (const auto& [name, op] : registry) {
+      const kernels::Kernel& kernel = *kernels::FindKernel(name);
+      for (int seed = 1; seed <= 3; ++seed) {
+        kernels::Args args = kernels::MakeArgs(kernel, seed);
+        const Problem p = FromArgs(op, args);
+        kernel.run(args);
+        error += Check(name + " seed " + std::to_string(seed), p,
+                       FromArgs(op, args).arrays);
+      }
+    }
+
+    for (auto [rows, cols] : {std::pair<int, int>{1, 1}, {3, 2}, {5, 17},
+                              {17, 5}, {63, 64}, {129, 250}, {700, 33}}) {
+      for (Op op : ops) {
+        const Problem p = RandomProblem(op, rows, cols, rng);
+        error += Check(string(OpName(op)) + " " + std::to_string(rows) + " x " +
+                           std::to_string(cols),
+                       p, Run(p, false));
+      }
+    }
+  }
+  matvec::SetIsa(matvec::BestIsa());
+
+  for (auto [rows, cols] : sizes) {
+    for (Op op : ops) {
+      const Problem p = RandomProblem(op, rows, cols, rng);
+      // Runs in place; only the vectors are restored between them.
+      Problem work = p;
+      const size_t matrix = static_cast<size_t>(rows) *
+                            (op == Op::kBicg || op == Op::kAtax ? cols : rows);
+      auto restore = [&] {
+        for (size_t i = 0; i < p.arrays.size(); ++i) {
+          if (p.arrays[i].size() != matrix) {
+            work.arrays[i] = p.arrays[i];
+          }
+        }
+      };
+      bench::Timing reference =
+          bench::Measure(0, 3, restore, [&] { Apply(work, false); });
+      const Arrays expected = work.arrays;
+      bench::Timing fast =
+          bench::Measure(1, 5, restore, [&] { Apply(work, true); });
+      const Arrays& out = work.arrays;
+      const string name = string(OpName(op)) + " " + std::to_string(rows) +
+                          " x " +
+                          std::to_string(op == Op::kBicg || op == Op::kAtax
+                                             ? cols
+                                             : rows);
+      const double e = check::Error(out, expected);
+      if (!(e <= kTolerance)) {
+        clog << name << ": fast version differs, error " << e << endl;
+        ++error;
+      }
+      cout << name << ": reference " << reference.median << " s, fused "
+           << fast.median << " s, speedup " << reference.median / fast.median
+           << "x" << endl;
+    }
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
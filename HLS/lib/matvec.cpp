@@ -0,0 +1,302 @@
+#include "matvec.h"
+
+#include <immintrin.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace matvec {
+
+namespace {
+
+// Fewest rows per thread.
+const int kMinBand = 64;
+// Rows loaded together by the SIMD kernel.
+const int kRows = 4;
+
+// One sweep over rows of the cols-wide matrix a. For every row i,
+//   dot[i] += a[i] . x            unless x is null,
+//   t[j] += c * a[i][j]           unless t is null,
+// with c = coef[i], or the finished dot[i] when coef is null. t is passed
+// apart, as every band of rows has its own.
+struct Sweep {
+  int cols;
+  const double* a;
+  const double* x;
+  double* dot;
+  const double* coef;
+};
+
+__attribute__((target("avx512f"))) __mmask8 Tail(int left) {
+  return left >= 8 ? 0xff : static_cast<__mmask8>((1 << left) - 1);
+}
+
+// kCount rows from row i. Each row keeps two accumulators of eight lanes.
+// With kFused (coef given) the transposed product is updated in the same
+// loop; otherwise it needs the finished dot products and runs after it, on
+// rows still in the cache.
+template <int kCount, bool kFused>
+__attribute__((target("avx512f"))) void BlockAvx512(const Sweep& s, int i,
+                                                    double* t) {
+  const int cols = s.cols;
+  const double* a[kCount];
+  __m512d c[kCount];
+  __m512d acc0[kCount], acc1[kCount];
+  for (int r = 0; r < kCount; ++r) {
+    a[r] = s.a + static_cast<long>(i + r) * cols;
+    if (kFused) c[r] = _mm512_set1_pd(s.coef[i + r]);
+    acc0[r] = _mm512_setzero_pd();
+    acc1[r] = _mm512_setzero_pd();
+  }
+  const bool dots = s.x != nullptr;
+  const bool update = kFused && t != nullptr;
+  int j = 0;
+  for (; j + 16 <= cols; j += 16) {
+    __m512d x0, x1, t0, t1;
+    if (dots) {
+      x0 = _mm512_loadu_pd(s.x + j);
+      x1 = _mm512_loadu_pd(s.x + j + 8);
+    }
+    if (update) {
+      t0 = _mm512_loadu_pd(t + j);
+      t1 = _mm512_loadu_pd(t + j + 8);
+    }
+    for (int r = 0; r < kCount; ++r) {
+      const __m512d a0 = _mm512_loadu_pd(a[r] + j);
+      const __m512d a1 = _mm512_loadu_pd(a[r] + j + 8);
+      if (dots) {
+        acc0[r] = _mm512_fmadd_pd(a0, x0, acc0[r]);
+        acc1[r] = _mm512_fmadd_pd(a1, x1, acc1[r]);
+      }
+      if (update) {
+        t0 = _mm512_fmadd_pd(c[r], a0, t0);
+        t1 = _mm512_fmadd_pd(c[r], a1, t1);
+      }
+    }
+    if (update) {
+      _mm512_storeu_pd(t + j, t0);
+      _mm512_storeu_pd(t + j + 8, t1);
+    }
+  }
+  for (; j < cols; j += 8) {
+    const __mmask8 m = Tail(cols - j);
+    __m512d x0, t0;
+    if (dots) x0 = _mm512_maskz_loadu_pd(m, s.x + j);
+    if (update) t0 = _mm512_maskz_loadu_pd(m, t + j);
+    for (int r = 0; r < kCount; ++r) {
+      const __m512d a0 = _mm512_maskz_loadu_pd(m, a[r] + j);
+      if (dots) acc0[r] = _mm512_fmadd_pd(a0, x0, acc0[r]);
+      if (update) t0 = _mm512_fmadd_pd(c[r], a0, t0);
+    }
+    if (update) _mm512_mask_storeu_pd(t + j, m, t0);
+  }
+  if (dots) {
+    for (int r = 0; r < kCount; ++r) {
+      s.dot[i + r] += _mm512_reduce_add_pd(_mm512_add_pd(acc0[r], acc1[r]));
+    }
+  }
+  if (kFused || t == nullptr) return;
+  for (int r = 0; r < kCount; ++r) c[r] = _mm512_set1_pd(s.dot[i + r]);
+  for (j = 0; j < cols; j += 8) {
+    const __mmask8 m = Tail(cols - j);
+    __m512d t0 = _mm512_maskz_loadu_pd(m, t + j);
+    for (int r = 0; r < kCount; ++r) {
+      t0 = _mm512_fmadd_pd(c[r], _mm512_maskz_loadu_pd(m, a[r] + j), t0);
+    }
+    _mm512_mask_storeu_pd(t + j, m, t0);
+  }
+}
+
+template <bool kFused>
+__attribute__((target("avx512f"))) void SweepAvx512(const Sweep& s, int i0,
+                                                    int i1, double* t) {
+  int i = i0;
+  for (; i + kRows <= i1; i += kRows) BlockAvx512<kRows, kFused>(s, i, t);
+  for (; i < i1; ++i) BlockAvx512<1, kFused>(s, i, t);
+}
+
+__attribute__((target("avx512f"))) void RowsAvx512(const Sweep& s, int i0,
+                                                   int i1, double* t) {
+  if (s.coef != nullptr) {
+    SweepAvx512<true>(s, i0, i1, t);
+  } else {
+    SweepAvx512<false>(s, i0, i1, t);
+  }
+}
+
+// Four interleaved partial sums per row.
+void RowsGeneric(const Sweep& s, int i0, int i1, double* t) {
+  const int cols = s.cols;
+  for (int i = i0; i < i1; ++i) {
+    const double* a = s.a + static_cast<long>(i) * cols;
+    if (s.x != nullptr) {
+      double acc[4] = {0.0, 0.0, 0.0, 0.0};
+      int j = 0;
+      for (; j + 4 <= cols; j += 4) {
+        for (int l = 0; l < 4; ++l) acc[l] += a[j + l] * s.x[j + l];
+      }
+      for (; j < cols; ++j) acc[0] += a[j] * s.x[j];
+      s.dot[i] += (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+    if (t == nullptr) continue;
+    const double c = s.coef != nullptr ? s.coef[i] : s.dot[i];
+    for (int j = 0; j < cols; ++j) t[j] += c * a[j];
+  }
+}
+
+struct Engine {
+  Isa isa;
+  void (*rows)(const Sweep& s, int i0, int i1, double* t);
+};
+
+const Engine kEngines[] = {
+    {Isa::kGeneric, RowsGeneric},
+    {Isa::kAvx512, RowsAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa, null until then; products on other threads read it.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+// Runs the sweep over rows 0..rows-1, adding the transposed product to t
+// (when set). The first band adds to t directly, the others to zeroed
+// buffers that are added to t afterwards in band order.
+void Run(const Sweep& s, int rows, double* t) {
+  const Engine& engine = Selected();
+  const int bands =
+      std::max(1, std::min(omp_get_max_threads(), rows / kMinBand));
+  if (bands == 1) {
+    engine.rows(s, 0, rows, t);
+    return;
+  }
+  const int height = (rows + bands - 1) / bands;
+  std::vector<double> shares(t == nullptr ? 0
+                                          : static_cast<size_t>(bands - 1) *
+                                                s.cols);
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < bands; ++b) {
+    double* share = t == nullptr || b == 0
+                        ? t
+                        : shares.data() + static_cast<long>(b - 1) * s.cols;
+    engine.rows(s, b * height, std::min(rows, (b + 1) * height), share);
+  }
+  if (t == nullptr) return;
+  for (int b = 1; b < bands; ++b) {
+    const double* share = shares.data() + static_cast<long>(b - 1) * s.cols;
+    for (int j = 0; j < s.cols; ++j) t[j] += share[j];
+  }
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void BicgReference(int rows, int cols, const double* a, double* s, double* q,
+                   const double* p, const double* r) {
+  for (int i = 0; i < cols; i++) s[i] = 0.0;
+  for (int i = 0; i < rows; i++) {
+    q[i] = 0.0;
+    for (int j = 0; j < cols; j++) {
+      s[j] += r[i] * a[i * cols + j];
+      q[i] += a[i * cols + j] * p[j];
+    }
+  }
+}
+
+void AtaxReference(int rows, int cols, const double* a, const double* x,
+                   double* y, double* tmp) {
+  for (int i = 0; i < cols; i++) y[i] = 0.0;
+  for (int i = 0; i < rows; i++) {
+    tmp[i] = 0.0;
+    for (int j = 0; j < cols; j++) tmp[i] += a[i * cols + j] * x[j];
+    for (int j = 0; j < cols; j++) y[j] += a[i * cols + j] * tmp[i];
+  }
+}
+
+void MvtReference(int n, double* x1, double* x2, const double* y1,
+                  const double* y2, const double* a) {
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) x1[i] += a[i * n + j] * y1[j];
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) x2[i] += a[j * n + i] * y2[j];
+  }
+}
+
+void GesummvReference(int n, double alpha, double beta, const double* a,
+                      const double* b, double* tmp, const double* x,
+                      double* y) {
+  for (int i = 0; i < n; i++) {
+    tmp[i] = 0.0;
+    y[i] = 0.0;
+    for (int j = 0; j < n; j++) {
+      tmp[i] = a[i * n + j] * x[j] + tmp[i];
+      y[i] = b[i * n + j] * x[j] + y[i];
+    }
+    y[i] = alpha * tmp[i] + beta * y[i];
+  }
+}
+
+void Bicg(int rows, int cols, const double* a, double* s, double* q,
+          const double* p, const double* r) {
+  std::fill(s, s + cols, 0.0);
+  std::fill(q, q + rows, 0.0);
+  Run(Sweep{cols, a, p, q, r}, rows, s);
+}
+
+void Atax(int rows, int cols, const double* a, const double* x, double* y,
+          double* tmp) {
+  std::fill(y, y + cols, 0.0);
+  std::fill(tmp, tmp + rows, 0.0);
+  Run(Sweep{cols, a, x, tmp, nullptr}, rows, y);
+}
+
+void Mvt(int n, double* x1, double* x2, const double* y1, const double* y2,
+         const double* a) {
+  Run(Sweep{n, a, y1, x1, y2}, n, x2);
+}
+
+void Gesummv(int n, double alpha, double beta, const double* a,
+             const double* b, double* tmp, const double* x, double* y) {
+  std::fill(tmp, tmp + n, 0.0);
+  std::fill(y, y + n, 0.0);
+  Run(Sweep{n, a, x, tmp, nullptr}, n, nullptr);
+  Run(Sweep{n, b, x, y, nullptr}, n, nullptr);
+  for (int i = 0; i < n; i++) y[i] = alpha * tmp[i] + beta * y[i];
+}
+
+}  // namespace matvec
@@ -0,0 +1,56 @@
+#ifndef MATVEC_H_
+#define MATVEC_H_
+
+// Matrix-vector products of data/sources/bicg_kernel.c, atax_kernel.c,
+// mvt_kernel.c and gesummv_kernel.c (and their -medium/-large variants) for
+// any size. A is rows x cols and row-major; kernel_bicg's A[i][j] is
+// A[i * cols + j] here with rows = 124, cols = 116, and likewise for the
+// others.
+namespace matvec {
+
+// The loop nests of the kernels.
+void BicgReference(int rows, int cols, const double* a, double* s, double* q,
+                   const double* p, const double* r);
+void AtaxReference(int rows, int cols, const double* a, const double* x,
+                   double* y, double* tmp);
+void MvtReference(int n, double* x1, double* x2, const double* y1,
+                  const double* y2, const double* a);
+void GesummvReference(int n, double alpha, double beta, const double* a,
+                      const double* b, double* tmp, const double* x,
+                      double* y);
+
+// The same results from one sweep over the rows of each matrix: a block of
+// rows is loaded once for both its dot products and its contribution to the
+// transposed product, with independent SIMD accumulators per row instead of
+// one serial sum. Bands of rows are spread over the OpenMP threads, each
+// summing its share of the transposed product privately before the shares
+// are added in order. The sums are reassociated, so results agree with the
+// kernels to rounding rather than bit for bit.
+
+// s = A^T r, q = A p.
+void Bicg(int rows, int cols, const double* a, double* s, double* q,
+          const double* p, const double* r);
+// tmp = A x, y = A^T tmp.
+void Atax(int rows, int cols, const double* a, const double* x, double* y,
+          double* tmp);
+// x1 += A y1, x2 += A^T y2 for n x n A.
+void Mvt(int n, double* x1, double* x2, const double* y1, const double* y2,
+         const double* a);
+// tmp = A x, y = alpha * tmp + beta * B x for n x n A and B.
+void Gesummv(int n, double alpha, double beta, const double* a,
+             const double* b, double* tmp, const double* x, double* y);
+
+enum class Isa { kGeneric, kAvx512 };
+
+// The widest instruction set the row kernels can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace matvec
+
+#endif
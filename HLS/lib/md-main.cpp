@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+#include "md.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+struct System {
+  int atoms;
+  int neighbours;
+  vector<double> x, y, z;
+  vector<int> nl;
+};
+
+// Atoms on a jittered cubic lattice, numbered along it, each listing random
+// other atoms of the surrounding 5 x 5 x 5 lattice cells as neighbours.
+System Lattice(int side, int neighbours, kernels::Rng& rng) {
+  System s;
+  s.atoms = side * side * side;
+  s.neighbours = neighbours;
+  std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+  std::uniform_int_distribution<int> step(-2, 2);
+  for (int a = 0; a < side; ++a) {
+    for (int b = 0; b < side; ++b) {
+      for (int c = 0; c < side; ++c) {
+        s.x.push_back(a + jitter(rng));
+        s.y.push_back(b + jitter(rng));
+        s.z.push_back(c + jitter(rng));
+      }
+    }
+  }
+  auto wrap = [side](int v) { return (v + side) % side; };
+  for (int i = 0; i < s.atoms; ++i) {
+    const int a = i / (side * side), b = i / side % side, c = i % side;
+    for (int j = 0; j < neighbours; ++j) {
+      int n;
+      do {
+        n = (wrap(a + step(rng)) * side + wrap(b + step(rng))) * side +
+            wrap(c + step(rng));
+      } while (n == i);
+      s.nl.push_back(n);
+    }
+  }
+  return s;
+}
+
+}  // namespace
+
+// Checks the vectorised forces bit for bit against md_kernel and the
+// reference loop, then times both on larger lattices:
+//   md [side neighbours]...
+int main(int argc, char** argv) {
+  vector<std::pair<int, int>> sizes;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    sizes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1])});
+  }
+  if (argc % 2 == 0 ||
+      std::any_of(sizes.begin(), sizes.end(),
+                  [](auto s) { return s.first < 5 || s.second <= 0; })) {
+    clog << "Usage: " << argv[0] << " [side neighbours]...\n";
+    return EXIT_FAILURE;
+  }
+  if (sizes.empty()) sizes = {{64, 16}, {64, 64}, {100, 16}};
+
+  int error = 0;
+  const kernels::Kernel& kernel = *kernels::FindKernel("md");
+  for (md::Isa isa : {md::Isa::kGeneric, md::Isa::kAvx2, md::Isa::kAvx512}) {
+    if (!md::SetIsa(isa)) continue;
+    clog << "Check " << md::IsaName(isa) << endl;
+    for (int seed = 1; seed <= 3; ++seed) {
+      kernels::Args args = kernels::MakeArgs(kernel, seed);
+      const int atoms = args.Count(0);
+      const int neighbours = args.Count(6) / atoms;
+      kernel.run(args);
+      // Every prefix of the atoms, to cover each tail length.
+      for (int n : {atoms, atoms - 1, atoms - 5, 7, 3}) {
+        vector<double> f(3 * n, 0.0);
+        md::Forces(n, neighbours, args.Ptr<int*>(6), args.Ptr<double*>(3),
+                   args.Ptr<double*>(4), args.Ptr<double*>(5), f.data(),
+                   f.data() + n, f.data() + 2 * n);
+        for (int d = 0; d < 3; ++d) {
+          const double* out = args.Ptr<double*>(d);
+          const vector<double> part(f.begin() + d * n, f.begin() + (d + 1) * n);
+          const vector<double> expected(out, out + n);
+          if (!check::Same({part}, {expected})) {
+            clog << "md seed " << seed << ": force " << "xyz"[d]
+                 << " differs for " << n << " atoms" << endl;
+            ++error;
+          }
+        }
+      }
+    }
+  }
+  md::SetIsa(md::BestIsa());
+
+  kernels::Rng rng(42);
+  for (auto [side, neighbours] : sizes) {
+    System s = Lattice(side, neighbours, rng);
+    const int n = s.atoms;
+    vector<double> ref(3 * static_cast<size_t>(n)), f(ref.size());
+    bench::Timing reference = bench::Measure(1, 3, [] {}, [&] {
+      md::ForcesReference(n, neighbours, s.nl.data(), s.x.data(), s.y.data(),
+                          s.z.data(), ref.data(), ref.data() + n,
+                          ref.data() + 2 * n);
+    });
+    bench::Timing fast = bench::Measure(1, 3, [] {}, [&] {
+      md::Forces(n, neighbours, s.nl.data(), s.x.data(), s.y.data(),
+                 s.z.data(), f.data(), f.data() + n, f.data() + 2 * n);
+    });
+    if (!check::Same({f}, {ref})) {
+      clog << n << " atoms, " << neighbours << " neighbours: forces differ"
+           << endl;
+      ++error;
+    }
+    const double pairs = static_cast<double>(n) * neighbours;
+    cout << n << " atoms, " << neighbours << " neighbours: reference "
+         << pairs / reference.median * 1e-6 << " Mpairs/s, vectorised "
+         << pairs / fast.median * 1e-6 << " Mpairs/s, speedup "
+         << reference.median / fast.median << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+#include "md.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace md {
+
+namespace {
+
+// Atoms per parallel task.
+const int kTask = 64;
+
+void Atoms(int first, int last, int neighbours, const int* nl,
+           const double* x, const double* y, const double* z, double* fx,
+           double* fy, double* fz) {
+  for (int i = first; i < last; i++) {
+    const double i_x = x[i];
+    const double i_y = y[i];
+    const double i_z = z[i];
+    double f_x = 0.0;
+    double f_y = 0.0;
+    double f_z = 0.0;
+    for (int j = 0; j < neighbours; j++) {
+      const int jidx = nl[static_cast<long>(i) * neighbours + j];
+      const double delx = i_x - x[jidx];
+      const double dely = i_y - y[jidx];
+      const double delz = i_z - z[jidx];
+      const double r2inv = 1.0 / (delx * delx + dely * dely + delz * delz);
+      const double r6inv = r2inv * r2inv * r2inv;
+      const double potential = r6inv * (1.5 * r6inv - 2.0);
+      const double force = r2inv * potential;
+      f_x += delx * force;
+      f_y += dely * force;
+      f_z += delz * force;
+    }
+    fx[i] = f_x;
+    fy[i] = f_y;
+    fz[i] = f_z;
+  }
+}
+
+// Copies the neighbour positions of kLanes atoms from `first` into SoA
+// buffers, neighbour j of lane l at j * kLanes + l, so that the SIMD
+// arithmetic runs on unit-stride loads. Scalar loads beat hardware gathers
+// here, and they read each neighbour list in order.
+template <int kLanes>
+double* PackNeighbours(int first, int neighbours, const int* nl,
+                       const double* x, const double* y, const double* z) {
+  thread_local std::vector<double> buffer;
+  buffer.resize(3 * kLanes * static_cast<size_t>(neighbours));
+  double* b_x = buffer.data();
+  double* b_y = b_x + kLanes * neighbours;
+  double* b_z = b_y + kLanes * neighbours;
+  for (int l = 0; l < kLanes; ++l) {
+    const int* nl_l = nl + static_cast<long>(first + l) * neighbours;
+    for (int j = 0; j < neighbours; ++j) {
+      const int jidx = nl_l[j];
+      b_x[j * kLanes + l] = x[jidx];
+      b_y[j * kLanes + l] = y[jidx];
+      b_z[j * kLanes + l] = z[jidx];
+    }
+  }
+  return buffer.data();
+}
+
+// Eight atoms from `first`, without contraction so that every lane rounds
+// like Atoms.
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+BlockAvx512(int first, int neighbours, const int* nl, const double* x,
+            const double* y, const double* z, double* fx, double* fy,
+            double* fz) {
+  const double* b_x = PackNeighbours<8>(first, neighbours, nl, x, y, z);
+  const double* b_y = b_x + 8 * neighbours;
+  const double* b_z = b_y + 8 * neighbours;
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d c15 = _mm512_set1_pd(1.5);
+  const __m512d c2 = _mm512_set1_pd(2.0);
+  const __m512d i_x = _mm512_loadu_pd(x + first);
+  const __m512d i_y = _mm512_loadu_pd(y + first);
+  const __m512d i_z = _mm512_loadu_pd(z + first);
+  __m512d f_x = _mm512_setzero_pd();
+  __m512d f_y = _mm512_setzero_pd();
+  __m512d f_z = _mm512_setzero_pd();
+  for (int j = 0; j < neighbours; ++j) {
+    __m512d delx = _mm512_sub_pd(i_x, _mm512_loadu_pd(b_x + j * 8));
+    __m512d dely = _mm512_sub_pd(i_y, _mm512_loadu_pd(b_y + j * 8));
+    __m512d delz = _mm512_sub_pd(i_z, _mm512_loadu_pd(b_z + j * 8));
+    __m512d r2 = _mm512_add_pd(
+        _mm512_add_pd(_mm512_mul_pd(delx, delx), _mm512_mul_pd(dely, dely)),
+        _mm512_mul_pd(delz, delz));
+    __m512d r2inv = _mm512_div_pd(one, r2);
+    __m512d r6inv = _mm512_mul_pd(_mm512_mul_pd(r2inv, r2inv), r2inv);
+    __m512d potential = _mm512_mul_pd(
+        r6inv, _mm512_sub_pd(_mm512_mul_pd(c15, r6inv), c2));
+    __m512d force = _mm512_mul_pd(r2inv, potential);
+    f_x = _mm512_add_pd(f_x, _mm512_mul_pd(delx, force));
+    f_y = _mm512_add_pd(f_y, _mm512_mul_pd(dely, force));
+    f_z = _mm512_add_pd(f_z, _mm512_mul_pd(delz, force));
+  }
+  _mm512_storeu_pd(fx + first, f_x);
+  _mm512_storeu_pd(fy + first, f_y);
+  _mm512_storeu_pd(fz + first, f_z);
+}
+
+// Four atoms from `first`.
+__attribute__((target("avx2"), optimize("fp-contract=off"))) void BlockAvx2(
+    int first, int neighbours, const int* nl, const double* x,
+    const double* y, const double* z, double* fx, double* fy, double* fz) {
+  const double* b_x = PackNeighbours<4>(first, neighbours, nl, x, y, z);
+  const double* b_y = b_x + 4 * neighbours;
+  const double* b_z = b_y + 4 * neighbours;
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d c15 = _mm256_set1_pd(1.5);
+  const __m256d c2 = _mm256_set1_pd(2.0);
+  const __m256d i_x = _mm256_loadu_pd(x + first);
+  const __m256d i_y = _mm256_loadu_pd(y + first);
+  const __m256d i_z = _mm256_loadu_pd(z + first);
+  __m256d f_x = _mm256_setzero_pd();
+  __m256d f_y = _mm256_setzero_pd();
+  __m256d f_z = _mm256_setzero_pd();
+  for (int j = 0; j < neighbours; ++j) {
+    __m256d delx = _mm256_sub_pd(i_x, _mm256_loadu_pd(b_x + j * 4));
+    __m256d dely = _mm256_sub_pd(i_y, _mm256_loadu_pd(b_y + j * 4));
+    __m256d delz = _mm256_sub_pd(i_z, _mm256_loadu_pd(b_z + j * 4));
+    __m256d r2 = _mm256_add_pd(
+        _mm256_add_pd(_mm256_mul_pd(delx, delx), _mm256_mul_pd(dely, dely)),
+        _mm256_mul_pd(delz, delz));
+    __m256d r2inv = _mm256_div_pd(one, r2);
+    __m256d r6inv = _mm256_mul_pd(_mm256_mul_pd(r2inv, r2inv), r2inv);
+    __m256d potential = _mm256_mul_pd(
+        r6inv, _mm256_sub_pd(_mm256_mul_pd(c15, r6inv), c2));
+    __m256d force = _mm256_mul_pd(r2inv, potential);
+    f_x = _mm256_add_pd(f_x, _mm256_mul_pd(delx, force));
+    f_y = _mm256_add_pd(f_y, _mm256_mul_pd(dely, force));
+    f_z = _mm256_add_pd(f_z, _mm256_mul_pd(delz, force));
+  }
+  _mm256_storeu_pd(fx + first, f_x);
+  _mm256_storeu_pd(fy + first, f_y);
+  _mm256_storeu_pd(fz + first, f_z);
+}
+
+struct Engine {
+  Isa isa;
+  int lanes;
+  void (*block)(int first, int neighbours, const int* nl, const double* x,
+                const double* y, const double* z, double* fx, double* fy,
+                double* fz);
+};
+
+// The generic engine has no block kernel; Atoms does every atom.
+const Engine kEngines[] = {
+    {Isa::kGeneric, 1, nullptr},
+    {Isa::kAvx2, 4, BlockAvx2},
+    {Isa::kAvx512, 8, BlockAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx2: return __builtin_cpu_supports("avx2");
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa, null until then; Forces may read it on another thread.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  if (Supported(Isa::kAvx2)) return Isa::kAvx2;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx2: return "avx2";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void ForcesReference(int atoms, int neighbours, const int* nl,
+                     const double* x, const double* y, const double* z,
+                     double* fx, double* fy, double* fz) {
+  Atoms(0, atoms, neighbours, nl, x, y, z, fx, fy, fz);
+}
+
+void Forces(int atoms, int neighbours, const int* nl, const double* x,
+            const double* y, const double* z, double* fx, double* fy,
+            double* fz) {
+  const Engine& engine = Selected();
+  const int tasks = (atoms + kTask - 1) / kTask;
+#pragma omp parallel for schedule(static)
+  for (int t = 0; t < tasks; ++t) {
+    const int first = t * kTask;
+    const int last = std::min(atoms, first + kTask);
+    int i = first;
+    if (engine.block != nullptr) {
+      for (; i + engine.lanes <= last; i += engine.lanes) {
+        engine.block(i, neighbours, nl, x, y, z, fx, fy, fz);
+      }
+    }
+    Atoms(i, last, neighbours, nl, x, y, z, fx, fy, fz);
+  }
+}
+
+}  // namespace md
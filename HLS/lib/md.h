@@ -0,0 +1,37 @@
+#ifndef MD_H_
+#define MD_H_
+
+// Lennard-Jones forces of data/sources/md_kernel.c for any number of atoms
+// and neighbours per atom. Positions and forces are separate x, y, z arrays;
+// the neighbours of atom i are nl[i * neighbours .. (i + 1) * neighbours).
+namespace md {
+
+// The loop nest of md_kernel.
+void ForcesReference(int atoms, int neighbours, const int* nl,
+                     const double* x, const double* y, const double* z,
+                     double* fx, double* fy, double* fz);
+
+// One SIMD lane per atom: the neighbour positions of a block of atoms are
+// packed into SoA buffers, then the lanes step through their neighbours
+// together. Every atom sums its neighbours in the original order, so the
+// forces are bitwise identical to ForcesReference (NaN for an atom listed
+// as its own neighbour, as there). Blocks of atoms are spread over the
+// OpenMP threads.
+void Forces(int atoms, int neighbours, const int* nl, const double* x,
+            const double* y, const double* z, double* fx, double* fy,
+            double* fz);
+
+enum class Isa { kGeneric, kAvx2, kAvx512 };
+
+// The widest instruction set the block kernel can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace md
+
+#endif
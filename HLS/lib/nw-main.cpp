@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "kernels.h"
+#include "nw.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using kernels::Args;
+
+namespace {
+
+// Checks that an alignment spells both sequences and scores M[kCells - 1].
+bool ValidAlignment(const char* seqa, const char* seqb, const char* aligned_a,
+                    const char* aligned_b, int expected) {
+  int a_idx = nw::kLen;
+  int b_idx = nw::kLen;
+  int score = 0;
+  for (int i = 0; i < nw::kAlignedLen && aligned_a[i] != '_'; ++i) {
+    if (aligned_a[i] != '-' && aligned_a[i] != seqa[--a_idx]) return false;
+    if (aligned_b[i] != '-' && aligned_b[i] != seqb[--b_idx]) return false;
+    if (aligned_a[i] == '-' || aligned_b[i] == '-') {
+      score -= 1;
+    } else {
+      score += aligned_a[i] == aligned_b[i] ? 1 : -1;
+    }
+  }
+  return a_idx == 0 && b_idx == 0 && score == expected;
+}
+
+// Runs needwun on pair i through args and compares the batch's results for
+// it.
+bool SameAsNeedwun(const kernels::Kernel& kernel, Args& args, int i,
+                   const vector<char>& seqa, const vector<char>& seqb,
+                   const vector<int>& m, const vector<char>& ptr,
+                   const vector<char>& aligned_a,
+                   const vector<char>& aligned_b) {
+  std::memcpy(args.Data(0), &seqa[i * nw::kLen], nw::kLen);
+  std::memcpy(args.Data(1), &seqb[i * nw::kLen], nw::kLen);
+  kernel.run(args);
+  const int* ref_m = args.Ptr<int*>(4);
+  const char* ref_ptr = args.Ptr<char*>(5);
+  const size_t base = static_cast<size_t>(i) * nw::kCells;
+  bool same = std::memcmp(ref_m, &m[base], nw::kCells * sizeof(int)) == 0;
+  for (int b = 1; b <= nw::kLen; ++b) {
+    const int row = b * (nw::kLen + 1) + 1;
+    same = same && std::memcmp(ref_ptr + row, &ptr[base + row], nw::kLen) == 0;
+  }
+  return same && ValidAlignment(&seqa[i * nw::kLen], &seqb[i * nw::kLen],
+                                &aligned_a[i * nw::kAlignedLen],
+                                &aligned_b[i * nw::kAlignedLen],
+                                ref_m[nw::kCells - 1]);
+}
+
+}  // namespace
+
+// Aligns a batch of random pairs with the wavefront engine and checks every
+// pair against needwun from the registry: M identical, ptr identical outside
+// the first row and column, and a traceback that reproduces the score.
+int main(int argc, char** argv) {
+  if (argc > 2) {
+    clog << "Usage: " << argv[0] << " [pairs]\n";
+    return EXIT_FAILURE;
+  }
+  const int count = argc == 2 ? atoi(argv[1]) : 4096;
+  const kernels::Kernel& kernel = *kernels::FindKernel("nw");
+
+  vector<char> seqa(count * nw::kLen), seqb(count * nw::kLen);
+  kernels::Rng rng(42);
+  kernels::FillSequence(seqa.data(), seqa.size(), rng);
+  kernels::FillSequence(seqb.data(), seqb.size(), rng);
+  vector<int> m(static_cast<size_t>(count) * nw::kCells);
+  vector<char> ptr(static_cast<size_t>(count) * nw::kCells);
+  vector<char> aligned_a(count * nw::kAlignedLen);
+  vector<char> aligned_b(count * nw::kAlignedLen);
+
+  // Every strip kernel the CPU supports on the first pairs, then the timed
+  // batch with the best one.
+  int error = 0;
+  Args args = kernels::MakeArgs(kernel);
+  const int checked = std::min(count, 256);
+  for (nw::Isa isa : {nw::Isa::kGeneric, nw::Isa::kAvx2, nw::Isa::kAvx512}) {
+    if (!nw::SetIsa(isa)) continue;
+    clog << "Check " << nw::IsaName(isa) << endl;
+    nw::AlignBatch(checked, seqa.data(), seqb.data(), m.data(), ptr.data(),
+                   aligned_a.data(), aligned_b.data());
+    for (int i = 0; i < checked; ++i) {
+      if (!SameAsNeedwun(kernel, args, i, seqa, seqb, m, ptr, aligned_a,
+                         aligned_b)) {
+        clog << nw::IsaName(isa) << ": pair " << i << " differs from needwun"
+             << endl;
+        ++error;
+        break;
+      }
+    }
+  }
+  nw::SetIsa(nw::BestIsa());
+
+  clog << "Align " << count << " pairs" << endl;
+  bench::Timing batch = bench::Measure(1, 5, [] {}, [&] {
+    nw::AlignBatch(count, seqa.data(), seqb.data(), m.data(), ptr.data(),
+                   aligned_a.data(), aligned_b.data());
+  });
+
+  bench::Timing original = bench::Measure(0, 1, [] {}, [&] {
+    for (int i = 0; i < count; ++i) {
+      if (!SameAsNeedwun(kernel, args, i, seqa, seqb, m, ptr, aligned_a,
+                         aligned_b)) {
+        if (error == 0) clog << "Pair " << i << " differs from needwun" << endl;
+        ++error;
+      }
+    }
+  });
+
+  cout << "needwun: " << count / original.median << " pairs/s" << endl;
+  cout << "wavefront batch with traceback: " << count / batch.median
+       << " pairs/s" << endl;
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,283 @@
+#include "nw.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace nw {
+
+namespace {
+
+const int kStride = kLen + 1;
+const int kMaxLanes = 16;
+const int kMaxSteps = kLen + kMaxLanes;
+
+// The matrix is filled in strips of `lanes` rows. Within a strip, lane r holds
+// row b0 + r and step t computes column a = t - r of every lane, i.e. one
+// anti-diagonal segment per step: the up and up-left neighbours come from
+// lane r - 1 at steps t - 1 and t - 2 and the left neighbour from lane r at
+// step t - 1, so whole diagonals stay in registers and only lane shifts are
+// needed. Scores and pointers are stored skewed, tile[t][r], and unskewed
+// into the row-major matrices afterwards.
+struct Strip {
+  int b0;
+  int lanes;
+  const int* seqa;   // [kMaxSteps], seqa[t] = SEQA[t - 1], 0 outside
+  const int* seqb;   // [kMaxLanes], SEQB[b0 + r - 1]
+  const int* above;  // [kMaxSteps], row b0 - 1 of M, clamped at kLen
+  int* tile_m;       // [kLen + lanes][lanes]
+  int* tile_dir;     // [kLen + lanes][lanes]
+};
+
+__attribute__((target("avx512f"))) void StripAvx512(const Strip& s) {
+  const __m512i one = _mm512_set1_epi32(1);
+  const __m512i minus_one = _mm512_set1_epi32(-1);
+  const __m512i align = _mm512_set1_epi32(kAlign);
+  const __m512i skip_a = _mm512_set1_epi32(kSkipA);
+  const __m512i skip_b = _mm512_set1_epi32(kSkipB);
+  const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                         11, 12, 13, 14, 15);
+  // M[b][0] = -b, entering lane r at step r.
+  const __m512i boundary =
+      _mm512_sub_epi32(_mm512_set1_epi32(-s.b0), lane);
+  const __m512i sb = _mm512_loadu_si512(s.seqb);
+  __m512i sa = _mm512_setzero_si512();
+  __m512i prev = _mm512_setzero_si512();     // step t - 1, lane r
+  __m512i prev_up = _mm512_setzero_si512();  // step t - 2, lane r - 1
+  for (int t = 0; t < kLen + 16; ++t) {
+    // Shift every lane up by one, feeding lane 0 from outside the strip.
+    __m512i up = _mm512_alignr_epi32(prev, _mm512_set1_epi32(s.above[t]), 15);
+    sa = _mm512_alignr_epi32(sa, _mm512_set1_epi32(s.seqa[t]), 15);
+    __m512i score =
+        _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(sa, sb), minus_one, one);
+    __m512i up_left = _mm512_add_epi32(prev_up, score);
+    __m512i up_gap = _mm512_add_epi32(up, minus_one);
+    __m512i left_gap = _mm512_add_epi32(prev, minus_one);
+    __m512i max =
+        _mm512_max_epi32(up_left, _mm512_max_epi32(up_gap, left_gap));
+    __m512i dir = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(max, up_gap),
+                                          align, skip_a);
+    dir = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(max, left_gap), dir,
+                                  skip_b);
+    max = _mm512_mask_blend_epi32(
+        _mm512_cmpeq_epi32_mask(lane, _mm512_set1_epi32(t)), max, boundary);
+    _mm512_storeu_si512(s.tile_m + t * 16, max);
+    _mm512_storeu_si512(s.tile_dir + t * 16, dir);
+    prev_up = up;
+    prev = max;
+  }
+}
+
+__attribute__((target("avx2"))) void StripAvx2(const Strip& s) {
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i minus_one = _mm256_set1_epi32(-1);
+  const __m256i align = _mm256_set1_epi32(kAlign);
+  const __m256i skip_a = _mm256_set1_epi32(kSkipA);
+  const __m256i skip_b = _mm256_set1_epi32(kSkipB);
+  const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i rotate = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+  const __m256i boundary = _mm256_sub_epi32(_mm256_set1_epi32(-s.b0), lane);
+  const __m256i sb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.seqb));
+  __m256i sa = _mm256_setzero_si256();
+  __m256i prev = _mm256_setzero_si256();
+  __m256i prev_up = _mm256_setzero_si256();
+  for (int t = 0; t < kLen + 8; ++t) {
+    __m256i up = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(prev, rotate),
+                                    _mm256_set1_epi32(s.above[t]), 1);
+    sa = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(sa, rotate),
+                            _mm256_set1_epi32(s.seqa[t]), 1);
+    __m256i score =
+        _mm256_blendv_epi8(minus_one, one, _mm256_cmpeq_epi32(sa, sb));
+    __m256i up_left = _mm256_add_epi32(prev_up, score);
+    __m256i up_gap = _mm256_add_epi32(up, minus_one);
+    __m256i left_gap = _mm256_add_epi32(prev, minus_one);
+    __m256i max =
+        _mm256_max_epi32(up_left, _mm256_max_epi32(up_gap, left_gap));
+    __m256i dir =
+        _mm256_blendv_epi8(align, skip_a, _mm256_cmpeq_epi32(max, up_gap));
+    dir = _mm256_blendv_epi8(dir, skip_b, _mm256_cmpeq_epi32(max, left_gap));
+    max = _mm256_blendv_epi8(max, boundary,
+                             _mm256_cmpeq_epi32(lane, _mm256_set1_epi32(t)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.tile_m + t * 8), max);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.tile_dir + t * 8), dir);
+    prev_up = up;
+    prev = max;
+  }
+}
+
+// Portable version of the same recurrence over 8 lanes.
+void StripGeneric(const Strip& s) {
+  const int kLanes = 8;
+  int sa[kLanes] = {};
+  int prev[kLanes] = {};
+  int prev_up[kLanes] = {};
+  for (int t = 0; t < kLen + kLanes; ++t) {
+    int up[kLanes];
+    up[0] = s.above[t];
+    for (int r = kLanes - 1; r > 0; --r) {
+      up[r] = prev[r - 1];
+      sa[r] = sa[r - 1];
+    }
+    sa[0] = s.seqa[t];
+    for (int r = 0; r < kLanes; ++r) {
+      int score = sa[r] == s.seqb[r] ? 1 : -1;
+      int up_left = prev_up[r] + score;
+      int up_gap = up[r] - 1;
+      int left_gap = prev[r] - 1;
+      int max = std::max(up_left, std::max(up_gap, left_gap));
+      s.tile_dir[t * kLanes + r] = max == left_gap ? kSkipB
+                                   : max == up_gap ? kSkipA
+                                                   : kAlign;
+      if (r == t) max = -(s.b0 + r);
+      s.tile_m[t * kLanes + r] = max;
+      prev[r] = max;
+      prev_up[r] = up[r];
+    }
+  }
+}
+
+struct Engine {
+  Isa isa;
+  int lanes;
+  void (*strip)(const Strip& s);
+};
+
+const Engine kEngines[] = {
+    {Isa::kGeneric, 8, StripGeneric},
+    {Isa::kAvx2, 8, StripAvx2},
+    {Isa::kAvx512, 16, StripAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx2: return __builtin_cpu_supports("avx2");
+    case Isa::kAvx512: return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+}
+
+// Set by SetIsa; read from the OpenMP threads of AlignBatch.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+// m may be null; the row above each strip is then taken from the tile only.
+void FillImpl(const char* seqa, const char* seqb, int* m, char* ptr) {
+  const Engine& engine = Selected();
+  const int lanes = engine.lanes;
+  alignas(64) int seqa_steps[kMaxSteps] = {};
+  alignas(64) int above[kMaxSteps];
+  alignas(64) int seqb_lanes[kMaxLanes];
+  alignas(64) int tile_m[kMaxSteps * kMaxLanes];
+  alignas(64) int tile_dir[kMaxSteps * kMaxLanes];
+  for (int t = 1; t <= kLen; ++t) seqa_steps[t] = seqa[t - 1];
+  for (int a = 0; a < kMaxSteps; ++a) above[a] = -std::min(a, kLen);
+
+  if (m != nullptr) {
+    for (int a = 0; a <= kLen; ++a) m[a] = -a;
+    for (int b = 0; b <= kLen; ++b) m[b * kStride] = -b;
+  }
+
+  for (int b0 = 1; b0 <= kLen; b0 += lanes) {
+    for (int r = 0; r < lanes; ++r) seqb_lanes[r] = seqb[b0 + r - 1];
+    engine.strip({b0, lanes, seqa_steps, seqb_lanes, above, tile_m, tile_dir});
+    for (int r = 0; r < lanes; ++r) {
+      const int* m_src = tile_m + r * lanes + r;
+      const int* dir_src = tile_dir + r * lanes + r;
+      const int row = (b0 + r) * kStride;
+      for (int a = 1; a <= kLen; ++a) {
+        if (m != nullptr) m[row + a] = m_src[a * lanes];
+        ptr[row + a] = static_cast<char>(dir_src[a * lanes]);
+      }
+    }
+    const int* last = tile_m + (lanes - 1) * lanes + lanes - 1;
+    above[0] = -(b0 + lanes - 1);
+    for (int a = 1; a < kMaxSteps; ++a) {
+      above[a] = last[std::min(a, kLen) * lanes];
+    }
+  }
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  if (Supported(Isa::kAvx2)) return Isa::kAvx2;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx2: return "avx2";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void Fill(const char seqa[kLen], const char seqb[kLen], int m[kCells],
+          char ptr[kCells]) {
+  FillImpl(seqa, seqb, m, ptr);
+}
+
+void Traceback(const char seqa[kLen], const char seqb[kLen],
+               const char ptr[kCells], char aligned_a[kAlignedLen],
+               char aligned_b[kAlignedLen]) {
+  int a_idx = kLen;
+  int b_idx = kLen;
+  int a_str_idx = 0;
+  int b_str_idx = 0;
+  while (a_idx > 0 || b_idx > 0) {
+    char move = b_idx == 0   ? kSkipB
+                : a_idx == 0 ? kSkipA
+                             : ptr[b_idx * kStride + a_idx];
+    if (move == kAlign) {
+      aligned_a[a_str_idx++] = seqa[a_idx - 1];
+      aligned_b[b_str_idx++] = seqb[b_idx - 1];
+      a_idx--;
+      b_idx--;
+    } else if (move == kSkipB) {
+      aligned_a[a_str_idx++] = seqa[a_idx - 1];
+      aligned_b[b_str_idx++] = '-';
+      a_idx--;
+    } else {
+      aligned_a[a_str_idx++] = '-';
+      aligned_b[b_str_idx++] = seqb[b_idx - 1];
+      b_idx--;
+    }
+  }
+  std::fill(aligned_a + a_str_idx, aligned_a + kAlignedLen, '_');
+  std::fill(aligned_b + b_str_idx, aligned_b + kAlignedLen, '_');
+}
+
+void AlignBatch(int count, const char* seqa, const char* seqb, int* m,
+                char* ptr, char* aligned_a, char* aligned_b) {
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int i = 0; i < count; ++i) {
+    const char* a = seqa + static_cast<long>(i) * kLen;
+    const char* b = seqb + static_cast<long>(i) * kLen;
+    char* p = ptr + static_cast<long>(i) * kCells;
+    FillImpl(a, b, m != nullptr ? m + static_cast<long>(i) * kCells : nullptr,
+             p);
+    if (aligned_a != nullptr) {
+      Traceback(a, b, p, aligned_a + static_cast<long>(i) * kAlignedLen,
+                aligned_b + static_cast<long>(i) * kAlignedLen);
+    }
+  }
+}
+
+}  // namespace nw
@@ -0,0 +1,53 @@
+#ifndef NW_H_
+#define NW_H_
+
+// Needleman-Wunsch alignment of 128-character sequences with the scoring of
+// data/sources/nw_kernel.c (match +1, mismatch -1, gap -1), computed along
+// anti-diagonals so that the cells of one diagonal fill SIMD lanes.
+namespace nw {
+
+const int kLen = 128;
+const int kCells = (kLen + 1) * (kLen + 1);
+const int kAlignedLen = 2 * kLen;
+
+// Traceback pointers, as stored in ptr.
+const char kAlign = '\\';
+const char kSkipA = '^';
+const char kSkipB = '<';
+
+// Fills the score matrix M and the pointer matrix ptr of one pair, both
+// row-major with SEQB along the rows. The results are identical to needwun;
+// like needwun, the first row and column of ptr are left untouched.
+void Fill(const char seqa[kLen], const char seqb[kLen], int m[kCells],
+          char ptr[kCells]);
+
+// Follows ptr back from the bottom-right cell and writes both aligned
+// sequences reversed, padded with '_' to kAlignedLen (the traceback of
+// MachSuite's nw, which nw_kernel.c keeps commented out). On the first row
+// or column the only possible move is taken.
+void Traceback(const char seqa[kLen], const char seqb[kLen],
+               const char ptr[kCells], char aligned_a[kAlignedLen],
+               char aligned_b[kAlignedLen]);
+
+// Aligns `count` pairs stored back to back (kLen characters per sequence,
+// kCells entries per matrix, kAlignedLen characters per aligned sequence),
+// spreading the pairs over the OpenMP threads. m may be null when the scores
+// are not needed; aligned_a and aligned_b may both be null to skip the
+// traceback.
+void AlignBatch(int count, const char* seqa, const char* seqb, int* m,
+                char* ptr, char* aligned_a, char* aligned_b);
+
+enum class Isa { kGeneric, kAvx2, kAvx512 };
+
+// The widest instruction set the strip kernel can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace nw
+
+#endif
@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "bench.h"
+#include "kernels.h"
+#include "seidel.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::vector;
+
+using kernels::Args;
+
+// Checks the wavefront-tiled Gauss-Seidel sweep bit for bit against
+// kernel_seidel_2d and against the sequential loop nest on other grid sizes
+// and tile widths, then times both on the given grid sizes.
+int main(int argc, char** argv) {
+  vector<int> sizes;
+  for (int i = 1; i < argc; ++i) {
+    int n = atoi(argv[i]);
+    if (n < 3) {
+      clog << "Usage: " << argv[0] << " [n...]\n";
+      return EXIT_FAILURE;
+    }
+    sizes.push_back(n);
+  }
+  if (sizes.empty()) sizes = {120, 500, 1000};
+
+  int error = 0;
+  const kernels::Kernel& kernel = *kernels::FindKernel("seidel-2d");
+  Args ref = kernels::MakeArgs(kernel);
+  Args out = ref;
+  kernel.run(ref);
+  seidel::Wavefront(40, 120, out.Ptr<double*>(2));
+  if (std::memcmp(ref.Data(2), out.Data(2), ref.Bytes(2)) != 0) {
+    clog << "Wavefront differs from kernel_seidel_2d" << endl;
+    ++error;
+  }
+
+  kernels::Rng rng(42);
+  for (int n : {3, 4, 17, 70, 129}) {
+    for (int width : {1, 5, 32, 200}) {
+      vector<double> a(n * n);
+      kernels::FillUniform(a.data(), a.size(), rng);
+      vector<double> b = a;
+      seidel::Sequential(7, n, a.data());
+      seidel::Wavefront(7, n, b.data(), width);
+      if (std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) != 0) {
+        clog << "Wavefront differs at n=" << n << " width=" << width << endl;
+        ++error;
+      }
+    }
+  }
+
+  for (int n : sizes) {
+    vector<double> input(static_cast<size_t>(n) * n);
+    kernels::FillUniform(input.data(), input.size(), rng);
+    vector<double> a = input;
+    bench::Timing sequential = bench::Measure(
+        1, 3, [&] { a = input; }, [&] { seidel::Sequential(40, n, a.data()); });
+    bench::Timing wavefront = bench::Measure(
+        1, 3, [&] { a = input; }, [&] { seidel::Wavefront(40, n, a.data()); });
+    cout << "n=" << n << ": sequential " << sequential.median
+         << " s, wavefront " << wavefront.median << " s, speedup "
+         << sequential.median / wavefront.median << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+#include "seidel.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace seidel {
+
+namespace {
+
+// Tiles run in lockstep by one thread: enough independent chains along j to
+// hide the latency of the additions and the division.
+const int kVectors = 2;
+const int kInterleave = 8 * kVectors;
+
+struct Tile {
+  double* start;  // first point of the tile
+  int length;
+};
+
+inline void Update(double* p, int n) {
+  p[0] = (p[-n - 1] + p[-n] + p[-n + 1] + p[-1] + p[0] + p[1] + p[n - 1] +
+          p[n] + p[n + 1]) /
+         9.0;
+}
+
+__attribute__((target("avx512f"))) inline __m512d Gather(__m512i index,
+                                                         long offset,
+                                                         const double* a) {
+  return _mm512_i64gather_pd(
+      _mm512_add_epi64(index, _mm512_set1_epi64(offset)), a, 8);
+}
+
+// kInterleave full-width tiles, one per lane of kVectors vectors. Along a
+// tile, six of the nine inputs of a point are inputs or the result of the
+// previous point, so only three gathers and one scatter are needed per step.
+// Tiles of one wavefront never write what another one reads, so the carried
+// values stay current.
+__attribute__((target("avx512f"))) void RunTilesAvx512(const Tile* tiles,
+                                                       int width, int n,
+                                                       double* a) {
+  alignas(64) long offsets[kInterleave];
+  for (int k = 0; k < kInterleave; ++k) offsets[k] = tiles[k].start - a;
+  const __m512d nine = _mm512_set1_pd(9.0);
+  __m512i index[kVectors];
+  __m512d up0[kVectors], up1[kVectors], left[kVectors], mid[kVectors];
+  __m512d down0[kVectors], down1[kVectors];
+  for (int v = 0; v < kVectors; ++v) {
+    index[v] = _mm512_load_si512(offsets + 8 * v);
+    up0[v] = Gather(index[v], -n - 1, a);
+    up1[v] = Gather(index[v], -n, a);
+    left[v] = Gather(index[v], -1, a);
+    mid[v] = Gather(index[v], 0, a);
+    down0[v] = Gather(index[v], n - 1, a);
+    down1[v] = Gather(index[v], n, a);
+  }
+  for (int x = 0; x < width; ++x) {
+    for (int v = 0; v < kVectors; ++v) {
+      __m512d up2 = Gather(index[v], x - n + 1, a);
+      __m512d right = Gather(index[v], x + 1, a);
+      __m512d down2 = Gather(index[v], x + n + 1, a);
+      __m512d sum = _mm512_add_pd(up0[v], up1[v]);
+      sum = _mm512_add_pd(sum, up2);
+      sum = _mm512_add_pd(sum, left[v]);
+      sum = _mm512_add_pd(sum, mid[v]);
+      sum = _mm512_add_pd(sum, right);
+      sum = _mm512_add_pd(sum, down0[v]);
+      sum = _mm512_add_pd(sum, down1[v]);
+      sum = _mm512_add_pd(sum, down2);
+      __m512d value = _mm512_div_pd(sum, nine);
+      _mm512_i64scatter_pd(
+          a, _mm512_add_epi64(index[v], _mm512_set1_epi64(x)), value, 8);
+      up0[v] = up1[v];
+      up1[v] = up2;
+      left[v] = value;
+      mid[v] = right;
+      down0[v] = down1[v];
+      down1[v] = down2;
+    }
+  }
+}
+
+void RunTiles(const Tile* tiles, int count, int width, int n, double* a) {
+  static const bool avx512 = __builtin_cpu_supports("avx512f");
+  if (count == kInterleave && avx512) {
+    bool full = true;
+    for (int k = 0; k < kInterleave; ++k) full = full && tiles[k].length == width;
+    if (full) {
+      RunTilesAvx512(tiles, width, n, a);
+      return;
+    }
+  }
+  if (count == kInterleave) {
+    for (int x = 0; x < width; ++x) {
+      for (int k = 0; k < kInterleave; ++k) {
+        if (x < tiles[k].length) Update(tiles[k].start + x, n);
+      }
+    }
+    return;
+  }
+  for (int k = 0; k < count; ++k) {
+    for (int x = 0; x < tiles[k].length; ++x) Update(tiles[k].start + x, n);
+  }
+}
+
+}  // namespace
+
+void Sequential(int tsteps, int n, double* a) {
+  for (int t = 0; t < tsteps; t++) {
+    for (int i = 1; i <= n - 2; i++) {
+      for (int j = 1; j <= n - 2; j++) Update(a + i * n + j, n);
+    }
+  }
+}
+
+void Wavefront(int tsteps, int n, double* a, int width) {
+  const int rows = n - 2;
+  if (tsteps <= 0 || rows <= 0) return;
+  width = std::max(1, width);
+  const int blocks = (rows + width - 1) / width;
+  const int last = 4 * (tsteps - 1) + 2 * (rows - 1) + blocks - 1;
+
+  std::vector<Tile> tiles;
+  for (int w = 0; w <= last; ++w) {
+    tiles.clear();
+    // Rows i = r + 1 and column blocks jb with 4t + 2r + jb = w.
+    for (int t = 0; t < tsteps && 4 * t <= w; ++t) {
+      const int rest = w - 4 * t;
+      const int r_lo = std::max(0, (rest - blocks + 2) / 2);
+      const int r_hi = std::min(rows - 1, rest / 2);
+      for (int r = r_lo; r <= r_hi; ++r) {
+        const int jb = rest - 2 * r;
+        if (jb >= blocks) continue;
+        tiles.push_back({a + (r + 1) * n + 1 + jb * width,
+                         std::min(width, rows - jb * width)});
+      }
+    }
+    // Full-width tiles first, so that the narrow last column block of each
+    // row does not break up the groups.
+    std::stable_partition(tiles.begin(), tiles.end(),
+                          [width](const Tile& t) { return t.length == width; });
+    const int count = static_cast<int>(tiles.size());
+    const int groups = (count + kInterleave - 1) / kInterleave;
+#pragma omp parallel for schedule(static) if (groups > 1)
+    for (int g = 0; g < groups; ++g) {
+      const int first = g * kInterleave;
+      RunTiles(&tiles[first], std::min(kInterleave, count - first), width, n,
+               a);
+    }
+  }
+}
+
+}  // namespace seidel
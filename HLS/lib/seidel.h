@@ -0,0 +1,23 @@
+#ifndef SEIDEL_H_
+#define SEIDEL_H_
+
+// In-place 9-point Gauss-Seidel sweeps of data/sources/seidel-2d_kernel.c on
+// an n x n row-major grid of any size. Both versions perform the same updates
+// on the same values, so their results are bitwise identical.
+namespace seidel {
+
+// The loop nest of kernel_seidel_2d: tsteps sweeps over rows 1..n-2 and
+// columns 1..n-2, each point averaging itself and its eight neighbours.
+void Sequential(int tsteps, int n, double* a);
+
+// Wavefront-tiled version. The iteration space is cut into tiles of one row
+// and `width` columns per timestep; tile (t, i, jb) runs at wavefront
+// 4t + 2i + jb, which orders every flow and anti dependence of the original
+// update order, so the tiles of one wavefront are independent. They are
+// spread over the OpenMP threads, and each thread interleaves several tiles
+// to overlap their dependence chains along j.
+void Wavefront(int tsteps, int n, double* a, int width = 32);
+
+}  // namespace seidel
+
+#endif
@@ -0,0 +1,169 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "kernels-sized.h"
+#include "kernels.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using kernels::Args;
+using kernels::Kernel;
+
+namespace sized = kernels::sized;
+
+namespace {
+
+const Kernel* FindSource(const string& source) {
+  for (const Kernel& kernel : kernels::Registry()) {
+    if (kernel.source == source) return &kernel;
+  }
+  return nullptr;
+}
+
+int FindArg(const Kernel& kernel, const string& name) {
+  for (size_t i = 0; i < kernel.args.size(); ++i) {
+    if (kernel.args[i].name == name) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+// A sized kernel at the sizes of its source against the registry entry of the
+// source: same argument specs, same inputs from the same seed, and bit for bit
+// the same results.
+int CheckDefault(const Kernel& sized, unsigned seed) {
+  const Kernel* original = FindSource(sized.source);
+  if (original == nullptr) {
+    clog << sized.name << ": no registry entry for " << sized.source << endl;
+    return 1;
+  }
+  bool same = original->args.size() == sized.args.size();
+  for (size_t i = 0; same && i < sized.args.size(); ++i) {
+    same = original->args[i].name == sized.args[i].name &&
+           original->args[i].type == sized.args[i].type &&
+           original->args[i].shape == sized.args[i].shape;
+  }
+  if (!same) {
+    clog << sized.name << ": arguments differ from " << original->name << endl;
+    return 1;
+  }
+  Args expected = kernels::MakeArgs(*original, seed);
+  Args out = kernels::MakeArgs(sized, seed);
+  int error = 0;
+  for (int i = 0; i < out.Size(); ++i) {
+    if (std::memcmp(expected.Data(i), out.Data(i), out.Bytes(i)) != 0) {
+      clog << sized.name << ": input " << out.Spec(i).name << " differs from "
+           << original->name << endl;
+      ++error;
+    }
+  }
+  original->run(expected);
+  sized.run(out);
+  for (int i = 0; i < out.Size(); ++i) {
+    if (std::memcmp(expected.Data(i), out.Data(i), out.Bytes(i)) != 0) {
+      clog << sized.name << ": " << out.Spec(i).name << " differs from "
+           << original->name << endl;
+      ++error;
+    }
+  }
+  return error;
+}
+
+// A sized kernel instantiated at the sizes of one of the -medium or -large
+// copies of its source, on the inputs of the copy. The copies may drop the
+// size scalars, so arrays are matched by name.
+int CheckVariant(const Kernel& sized, const string& variant) {
+  const Kernel& original = *kernels::FindKernel(variant);
+  Args expected = kernels::MakeArgs(original);
+  Args out = kernels::MakeArgs(sized);
+  int error = 0;
+  for (int i = 0; i < expected.Size(); ++i) {
+    if (original.args[i].shape.empty()) continue;
+    const int j = FindArg(sized, original.args[i].name);
+    if (j < 0 || out.Bytes(j) != expected.Bytes(i)) {
+      clog << sized.name << ": no array like " << original.args[i].name
+           << " of " << variant << endl;
+      return error + 1;
+    }
+    std::memcpy(out.Data(j), expected.Data(i), expected.Bytes(i));
+  }
+  original.run(expected);
+  sized.run(out);
+  for (int i = 0; i < expected.Size(); ++i) {
+    if (original.args[i].shape.empty()) continue;
+    const int j = FindArg(sized, original.args[i].name);
+    if (std::memcmp(expected.Data(i), out.Data(j), expected.Bytes(i)) != 0) {
+      clog << sized.name << ": " << original.args[i].name << " differs from "
+           << variant << endl;
+      ++error;
+    }
+  }
+  return error;
+}
+
+void Time(const Kernel& kernel) {
+  const Args input = kernels::MakeArgs(kernel);
+  Args args = input;
+  bench::Timing timing =
+      bench::Measure(1, 5, [&] { args = input; }, [&] { kernel.run(args); });
+  cout << kernel.name << ": " << timing.median * 1e3 << " ms" << endl;
+}
+
+}  // namespace
+
+// Checks the size-templated kernels of kernels-sized.h against the registry,
+// at the sizes of their sources and at those of the -medium and -large copies,
+// then times a few of them over growing sizes.
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    clog << "Usage: " << argv[0] << "\n";
+    return EXIT_FAILURE;
+  }
+
+  int error = 0;
+  const vector<Kernel> defaults = sized::Defaults();
+  for (const Kernel& kernel : defaults) {
+    for (unsigned seed : {42u, 7u}) error += CheckDefault(kernel, seed);
+  }
+  cout << defaults.size() << " sized kernels match the registry" << endl;
+
+  error += CheckVariant(sized::k_atax::Instance<390, 410>(), "atax-medium");
+  error += CheckVariant(sized::k_bicg::Instance<410, 390>(), "bicg-medium");
+  error += CheckVariant(sized::k_bicg::Instance<410, 390>(), "bicg-large");
+  error += CheckVariant(sized::k_fdtd_2d::Instance<100, 200, 240>(),
+                        "fdtd-2d-large");
+  error += CheckVariant(sized::k_gemm_p::Instance<200, 220, 240>(),
+                        "gemm-p-large");
+  error += CheckVariant(sized::k_gemver::Instance<400>(), "gemver-medium");
+  error += CheckVariant(sized::k_gesummv::Instance<250>(), "gesummv-medium");
+  error += CheckVariant(sized::k_mvt::Instance<400>(), "mvt-medium");
+  error += CheckVariant(sized::k_symm_opt::Instance<200, 240>(),
+                        "symm-opt-medium");
+
+  for (const Kernel& kernel :
+       {sized::k_gemm_ncubed::Instance<64>(),
+        sized::k_gemm_ncubed::Instance<128>(),
+        sized::k_gemm_ncubed::Instance<256>(),
+        sized::k_jacobi_2d::Instance<40, 90>(),
+        sized::k_jacobi_2d::Instance<40, 360>(),
+        sized::k_jacobi_2d::Instance<40, 1440>(),
+        sized::k_md::Instance<256, 16>(), sized::k_md::Instance<4096, 16>(),
+        sized::k_md::Instance<65536, 16>()}) {
+    Time(kernel);
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+#include "spmv.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+struct Matrix {
+  int rows;
+  vector<int> row_ptr;
+  vector<int> cols;
+  vector<double> val;
+};
+
+// A square matrix with skewed row lengths: most rows are short, every
+// hundredth is ten times longer. Half of the columns lie near the diagonal,
+// the rest anywhere.
+Matrix RandomMatrix(int rows, double mean_length, kernels::Rng& rng) {
+  std::geometric_distribution<int> length(1.0 / mean_length);
+  std::uniform_int_distribution<int> any(0, rows - 1);
+  std::uniform_int_distribution<int> near(-1000, 1000);
+  Matrix a;
+  a.rows = rows;
+  a.row_ptr.push_back(0);
+  for (int i = 0; i < rows; ++i) {
+    int n = i % 100 == 99 ? 10 * static_cast<int>(mean_length) : length(rng);
+    for (int k = 0; k < n; ++k) {
+      a.cols.push_back(k % 2 == 0 ? std::clamp(i + near(rng), 0, rows - 1)
+                                  : any(rng));
+    }
+    a.row_ptr.push_back(static_cast<int>(a.cols.size()));
+  }
+  a.val.resize(a.cols.size());
+  kernels::FillUniform(a.val.data(), a.val.size(), rng);
+  return a;
+}
+
+// Checks SELL-C-sigma and merge-path CRS against the given reference result,
+// for several sigmas and partition counts.
+int Check(const string& name, const Matrix& a, const vector<double>& x,
+          const vector<double>& expected) {
+  int error = 0;
+  vector<double> y(a.rows);
+  for (int sigma : {1, 8, 32, 256, a.rows}) {
+    spmv::Sell sell = spmv::ToSell(a.rows, a.row_ptr.data(), a.cols.data(),
+                                   a.val.data(), sigma);
+    std::fill(y.begin(), y.end(), 0.0);
+    spmv::SellSpmv(sell, x.data(), y.data());
+    if (!check::Same({y}, {expected})) {
+      clog << name << ": SELL-C-sigma differs with sigma " << sigma << endl;
+      ++error;
+    }
+  }
+  for (int parts : {1, 2, 3, 7, 64, 1000}) {
+    std::fill(y.begin(), y.end(), 0.0);
+    spmv::CrsMergePath(a.rows, a.row_ptr.data(), a.cols.data(), a.val.data(),
+                       x.data(), y.data(), parts);
+    double e = check::Error({y}, {expected});
+    if (parts == 1 ? !check::Same({y}, {expected}) : !(e <= 1e-12)) {
+      clog << name << ": merge path differs with " << parts
+           << " parts, error " << e << endl;
+      ++error;
+    }
+  }
+  return error;
+}
+
+// Interleaves `count` vectors of length n: x[r * n + i] to [i * count + r].
+vector<double> Interleave(const vector<double>& x, int count) {
+  const size_t n = x.size() / count;
+  vector<double> y(x.size());
+  for (int r = 0; r < count; ++r) {
+    for (size_t i = 0; i < n; ++i) y[i * count + r] = x[r * n + i];
+  }
+  return y;
+}
+
+// Checks column-major ELL, single and batched, against the row-major loop
+// on `count` right-hand sides, each starting from its own y.
+int CheckEll(const string& name, int rows, int width, const vector<int>& cols,
+             const vector<double>& val, int count, kernels::Rng& rng) {
+  vector<double> x(static_cast<size_t>(count) * rows);
+  vector<double> y0(x.size());
+  kernels::FillUniform(x.data(), x.size(), rng);
+  kernels::FillUniform(y0.data(), y0.size(), rng);
+  vector<double> expected = y0;
+  for (int r = 0; r < count; ++r) {
+    spmv::EllRowMajor(rows, width, cols.data(), val.data(),
+                      x.data() + r * rows, expected.data() + r * rows);
+  }
+  spmv::Ell ell = spmv::ToColumnMajorEll(rows, width, cols.data(), val.data());
+  vector<double> y = y0;
+  for (int r = 0; r < count; ++r) {
+    spmv::EllSpmv(ell, x.data() + r * rows, y.data() + r * rows);
+  }
+  int error = 0;
+  if (!check::Same({y}, {expected})) {
+    clog << name << ": column-major ELL differs" << endl;
+    ++error;
+  }
+  y = Interleave(y0, count);
+  spmv::EllSpmvBatch(ell, count, Interleave(x, count).data(), y.data());
+  if (!check::Same({y}, {Interleave(expected, count)})) {
+    clog << name << ": batched ELL differs with " << count
+         << " right-hand sides" << endl;
+    ++error;
+  }
+  return error;
+}
+
+}  // namespace
+
+// Checks the SpMV kernels against spmv() and ellpack() at the registry size
+// and against the plain CRS and ELL loops on large random matrices, then
+// times them there:
+//   spmv [rows...]
+int main(int argc, char** argv) {
+  vector<int> sizes;
+  for (int i = 1; i < argc; ++i) {
+    int rows = std::atoi(argv[i]);
+    if (rows <= 0) {
+      clog << "Usage: " << argv[0] << " [rows...]\n";
+      return EXIT_FAILURE;
+    }
+    sizes.push_back(rows);
+  }
+  // The rows of spmv-crs, then out-of-cache sizes.
+  if (sizes.empty()) sizes = {494, 100000, 1000000};
+
+  int error = 0;
+  kernels::Rng rng(42);
+  for (int seed = 1; seed <= 3; ++seed) {
+    const kernels::Kernel& kernel = *kernels::FindKernel("spmv-crs");
+    kernels::Args args = kernels::MakeArgs(kernel, seed);
+    Matrix a;
+    a.rows = args.Count(4);
+    a.val.assign(args.Ptr<double*>(0), args.Ptr<double*>(0) + args.Count(0));
+    a.cols.assign(args.Ptr<int*>(1), args.Ptr<int*>(1) + args.Count(1));
+    a.row_ptr.assign(args.Ptr<int*>(2), args.Ptr<int*>(2) + args.Count(2));
+    vector<double> x(args.Ptr<double*>(3), args.Ptr<double*>(3) + a.rows);
+    kernel.run(args);
+    vector<double> expected(args.Ptr<double*>(4),
+                            args.Ptr<double*>(4) + a.rows);
+    error += Check("spmv-crs seed " + std::to_string(seed), a, x, expected);
+
+    const kernels::Kernel& ellpack = *kernels::FindKernel("spmv-ellpack");
+    kernels::Args ell_args = kernels::MakeArgs(ellpack, seed);
+    const int rows = ell_args.Count(3);
+    const int width = ell_args.Count(0) / rows;
+    vector<double> val(ell_args.Ptr<double*>(0),
+                       ell_args.Ptr<double*>(0) + ell_args.Count(0));
+    vector<int> cols(ell_args.Ptr<int*>(1),
+                     ell_args.Ptr<int*>(1) + ell_args.Count(1));
+    vector<double> y(ell_args.Ptr<double*>(3), ell_args.Ptr<double*>(3) + rows);
+    spmv::Ell ell =
+        spmv::ToColumnMajorEll(rows, width, cols.data(), val.data());
+    spmv::EllSpmv(ell, ell_args.Ptr<double*>(2), y.data());
+    ellpack.run(ell_args);
+    const vector<double> expected_y(ell_args.Ptr<double*>(3),
+                                    ell_args.Ptr<double*>(3) + rows);
+    if (!check::Same({y}, {expected_y})) {
+      clog << "spmv-ellpack seed " << seed << ": column-major ELL differs"
+           << endl;
+      ++error;
+    }
+    for (int count = 1; count <= 19; ++count) {
+      error += CheckEll("spmv-ellpack seed " + std::to_string(seed), rows,
+                        width, cols, val, count, rng);
+    }
+  }
+
+  for (int rows : sizes) {
+    Matrix a = RandomMatrix(rows, 16, rng);
+    vector<double> x(rows);
+    kernels::FillUniform(x.data(), x.size(), rng);
+    vector<double> expected(rows);
+    bench::Timing crs = bench::Measure(1, 5, [] {}, [&] {
+      spmv::Crs(rows, a.row_ptr.data(), a.cols.data(), a.val.data(), x.data(),
+                expected.data());
+    });
+    const string name = std::to_string(rows) + " rows";
+    error += Check(name, a, x, expected);
+
+    vector<double> y(rows);
+    bench::Timing merge = bench::Measure(1, 5, [] {}, [&] {
+      spmv::CrsMergePath(rows, a.row_ptr.data(), a.cols.data(), a.val.data(),
+                         x.data(), y.data());
+    });
+    spmv::Sell sell;
+    bench::Timing convert = bench::Measure(0, 1, [] {}, [&] {
+      sell = spmv::ToSell(rows, a.row_ptr.data(), a.cols.data(), a.val.data());
+    });
+    bench::Timing sell_time = bench::Measure(
+        1, 5, [] {}, [&] { spmv::SellSpmv(sell, x.data(), y.data()); });
+    const double flops = 2.0 * a.val.size();
+    cout << name << ", " << a.val.size() << " nonzeros: CRS "
+         << flops / crs.median * 1e-9 << " GFLOP/s, merge path "
+         << flops / merge.median * 1e-9 << " GFLOP/s, SELL-8-256 "
+         << flops / sell_time.median * 1e-9 << " GFLOP/s (fill "
+         << sell.Fill() << ", conversion " << convert.median / crs.median
+         << " CRS products), speedup " << crs.median / sell_time.median << "x"
+         << endl;
+
+    // ELL with ten entries per row, as in spmv-ellpack, cycling through the
+    // columns of each CRS row; column 0 for empty rows.
+    const int width = 10;
+    const int batch = 8;
+    vector<int> cols(static_cast<size_t>(rows) * width);
+    for (int i = 0; i < rows; ++i) {
+      const int length = a.row_ptr[i + 1] - a.row_ptr[i];
+      for (int j = 0; j < width; ++j) {
+        cols[i * width + j] =
+            length == 0 ? 0 : a.cols[a.row_ptr[i] + j % length];
+      }
+    }
+    vector<double> val(cols.size());
+    kernels::FillUniform(val.data(), val.size(), rng);
+    error += CheckEll(name + " ELL", rows, width, cols, val, 5, rng);
+    vector<double> xs(static_cast<size_t>(batch) * rows);
+    kernels::FillUniform(xs.data(), xs.size(), rng);
+    vector<double> ys(xs.size());
+    bench::Timing row_major = bench::Measure(1, 5, [] {}, [&] {
+      spmv::EllRowMajor(rows, width, cols.data(), val.data(), x.data(),
+                        y.data());
+    });
+    spmv::Ell ell =
+        spmv::ToColumnMajorEll(rows, width, cols.data(), val.data());
+    bench::Timing column_major = bench::Measure(
+        1, 5, [] {}, [&] { spmv::EllSpmv(ell, x.data(), y.data()); });
+    bench::Timing single = bench::Measure(1, 5, [] {}, [&] {
+      for (int r = 0; r < batch; ++r) {
+        spmv::EllSpmv(ell, xs.data() + r * rows, ys.data() + r * rows);
+      }
+    });
+    vector<double> interleaved = Interleave(xs, batch);
+    bench::Timing batched = bench::Measure(1, 5, [] {}, [&] {
+      spmv::EllSpmvBatch(ell, batch, interleaved.data(), ys.data());
+    });
+    const double ell_flops = 2.0 * rows * width;
+    cout << name << " ELL: row-major " << ell_flops / row_major.median * 1e-9
+         << " GFLOP/s, column-major " << ell_flops / column_major.median * 1e-9
+         << " GFLOP/s, " << batch << " right-hand sides one by one "
+         << batch * ell_flops / single.median * 1e-9 << " GFLOP/s, batched "
+         << batch * ell_flops / batched.median * 1e-9 << " GFLOP/s" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,329 @@
+#include "spmv.h"
+
+#include <immintrin.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace spmv {
+
+namespace {
+
+struct Coordinate {
+  int row;  // rows whose end has been consumed
+  int nz;   // nonzeros consumed
+};
+
+// The point where diagonal `d` crosses the merge path of the row ends
+// row_end[0..rows) and the nonzero indices 0..nnz: ties go to the row end, so
+// a row is closed once all its nonzeros are consumed.
+Coordinate MergePathSearch(int d, const int* row_end, int rows, int nnz) {
+  int lo = std::max(d - nnz, 0);
+  int hi = std::min(d, rows);
+  while (lo < hi) {
+    const int pivot = lo + (hi - lo) / 2;
+    if (row_end[pivot] <= d - pivot - 1) {
+      lo = pivot + 1;
+    } else {
+      hi = pivot;
+    }
+  }
+  return {lo, d - lo};
+}
+
+// The products are added one by one, without contraction, so that every lane
+// rounds like the scalar loop.
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+ChunkAvx512(const int* cols, const double* val, int width, const double* x,
+            double* sum) {
+  __m512d acc = _mm512_setzero_pd();
+  for (int j = 0; j < width; ++j) {
+    __m256i index = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(cols + j * kChunk));
+    __m512d product = _mm512_mul_pd(_mm512_loadu_pd(val + j * kChunk),
+                                    _mm512_i32gather_pd(index, x, 8));
+    acc = _mm512_add_pd(acc, product);
+  }
+  _mm512_storeu_pd(sum, acc);
+}
+
+void ChunkGeneric(const int* cols, const double* val, int width,
+                  const double* x, double* sum) {
+  for (int l = 0; l < kChunk; ++l) sum[l] = 0.0;
+  for (int j = 0; j < width; ++j) {
+    for (int l = 0; l < kChunk; ++l) {
+      sum[l] = sum[l] + val[j * kChunk + l] * x[cols[j * kChunk + l]];
+    }
+  }
+}
+
+// `chunks` chunks of kChunk rows, entry j of a chunk at cols/val + j * stride,
+// against kRhs right-hand sides interleaved `count` apart: y[i * count + r]
+// += the products of row i with x[c * count + r].
+template <int kRhs>
+__attribute__((target("avx512f"), optimize("fp-contract=off"))) void
+EllAvx512(const int* cols, const double* val, long stride, int width,
+          int chunks, int count, const double* x, double* y) {
+  const __m256i scale = _mm256_set1_epi32(count);
+  const __m256i lanes = _mm256_mullo_epi32(
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), scale);
+  for (int c = 0; c < chunks; ++c) {
+    double* y_c = y + static_cast<long>(c) * kChunk * count;
+    __m512d acc[kRhs];
+    for (int r = 0; r < kRhs; ++r) {
+      acc[r] = count == 1 ? _mm512_loadu_pd(y_c)
+                          : _mm512_i32gather_pd(lanes, y_c + r, 8);
+    }
+    for (int j = 0; j < width; ++j) {
+      const long k = j * stride + c * kChunk;
+      __m256i index = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(cols + k));
+      if (count > 1) index = _mm256_mullo_epi32(index, scale);
+      __m512d v = _mm512_loadu_pd(val + k);
+      for (int r = 0; r < kRhs; ++r) {
+        acc[r] = _mm512_add_pd(
+            acc[r], _mm512_mul_pd(v, _mm512_i32gather_pd(index, x + r, 8)));
+      }
+    }
+    for (int r = 0; r < kRhs; ++r) {
+      if (count == 1) {
+        _mm512_storeu_pd(y_c, acc[r]);
+      } else {
+        _mm512_i32scatter_pd(y_c + r, lanes, acc[r], 8);
+      }
+    }
+  }
+}
+
+template <int kRhs>
+void EllGeneric(const int* cols, const double* val, long stride, int width,
+                int chunks, int count, const double* x, double* y) {
+  for (int c = 0; c < chunks; ++c) {
+    double sum[kRhs][kChunk];
+    double* y_c = y + static_cast<long>(c) * kChunk * count;
+    for (int r = 0; r < kRhs; ++r) {
+      for (int l = 0; l < kChunk; ++l) sum[r][l] = y_c[l * count + r];
+    }
+    for (int j = 0; j < width; ++j) {
+      const long k = j * stride + c * kChunk;
+      for (int r = 0; r < kRhs; ++r) {
+        for (int l = 0; l < kChunk; ++l) {
+          const long col = cols[k + l];
+          sum[r][l] = sum[r][l] + val[k + l] * x[col * count + r];
+        }
+      }
+    }
+    for (int r = 0; r < kRhs; ++r) {
+      for (int l = 0; l < kChunk; ++l) y_c[l * count + r] = sum[r][l];
+    }
+  }
+}
+
+using EllKernel = void (*)(const int*, const double*, long, int, int, int,
+                           const double*, double*);
+
+template <int kRhs>
+EllKernel SelectEll() {
+  return __builtin_cpu_supports("avx512f") ? EllAvx512<kRhs>
+                                           : EllGeneric<kRhs>;
+}
+
+// Right-hand sides held in registers at a time.
+const int kMaxRhs = 8;
+
+// Chunks per parallel task.
+const int kEllTask = 256;
+
+}  // namespace
+
+void Crs(int rows, const int* row_ptr, const int* cols, const double* val,
+         const double* x, double* y) {
+  for (int i = 0; i < rows; i++) {
+    double sum = 0.0;
+    for (int j = row_ptr[i]; j < row_ptr[i + 1]; j++) {
+      sum = sum + val[j] * x[cols[j]];
+    }
+    y[i] = sum;
+  }
+}
+
+void CrsMergePath(int rows, const int* row_ptr, const int* cols,
+                  const double* val, const double* x, double* y, int parts) {
+  if (rows <= 0) return;
+  if (parts <= 0) parts = omp_get_max_threads();
+  if (parts == 1) {
+    Crs(rows, row_ptr, cols, val, x, y);
+    return;
+  }
+  const int* row_end = row_ptr + 1;
+  const int nnz = row_ptr[rows] - row_ptr[0];
+  const int* col0 = cols + row_ptr[0];
+  const double* val0 = val + row_ptr[0];
+  // Nonzero indices on the path are relative to row_ptr[0].
+  std::vector<int> ends(row_end, row_end + rows);
+  for (int& end : ends) end -= row_ptr[0];
+  const long total = static_cast<long>(rows) + nnz;
+  const long share = (total + parts - 1) / parts;
+
+  // Each part writes the rows it closes; what it sums of the row left open at
+  // its end is carried out and added once all parts are done.
+  std::vector<int> carry_row(parts);
+  std::vector<double> carry_value(parts);
+#pragma omp parallel for schedule(static)
+  for (int p = 0; p < parts; ++p) {
+    const int d_begin = static_cast<int>(std::min(total, p * share));
+    const int d_end = static_cast<int>(std::min(total, (p + 1) * share));
+    Coordinate c = MergePathSearch(d_begin, ends.data(), rows, nnz);
+    const Coordinate end = MergePathSearch(d_end, ends.data(), rows, nnz);
+    for (; c.row < end.row; ++c.row) {
+      double sum = 0.0;
+      for (; c.nz < ends[c.row]; ++c.nz) {
+        sum = sum + val0[c.nz] * x[col0[c.nz]];
+      }
+      y[c.row] = sum;
+    }
+    double sum = 0.0;
+    for (; c.nz < end.nz; ++c.nz) sum = sum + val0[c.nz] * x[col0[c.nz]];
+    carry_row[p] = end.row;
+    carry_value[p] = sum;
+  }
+  for (int p = 0; p < parts - 1; ++p) {
+    if (carry_row[p] < rows) y[carry_row[p]] += carry_value[p];
+  }
+}
+
+double Sell::Fill() const {
+  return nnz == 0 ? 1.0 : static_cast<double>(val.size()) / nnz;
+}
+
+Sell ToSell(int rows, const int* row_ptr, const int* cols, const double* val,
+            int sigma) {
+  Sell a;
+  a.rows = rows;
+  a.nnz = rows > 0 ? row_ptr[rows] - row_ptr[0] : 0;
+  a.sigma = std::max(1, sigma);
+  auto length = [&](int i) { return row_ptr[i + 1] - row_ptr[i]; };
+
+  // Sort each window of sigma rows by decreasing length; the stable sort
+  // keeps the original order of rows of equal length.
+  const int chunks = (rows + kChunk - 1) / kChunk;
+  a.row.assign(static_cast<size_t>(chunks) * kChunk, -1);
+  std::iota(a.row.begin(), a.row.begin() + rows, 0);
+  for (int w = 0; w < rows; w += a.sigma) {
+    std::stable_sort(a.row.begin() + w,
+                     a.row.begin() + std::min(rows, w + a.sigma),
+                     [&](int i, int j) { return length(i) > length(j); });
+  }
+
+  a.chunk_start.resize(chunks + 1);
+  a.chunk_width.resize(chunks);
+  a.chunk_start[0] = 0;
+  for (int c = 0; c < chunks; ++c) {
+    int width = 0;
+    for (int l = 0; l < kChunk; ++l) {
+      const int i = a.row[c * kChunk + l];
+      if (i >= 0) width = std::max(width, length(i));
+    }
+    a.chunk_width[c] = width;
+    a.chunk_start[c + 1] = a.chunk_start[c] + width * kChunk;
+  }
+
+  a.cols.assign(a.chunk_start[chunks], 0);
+  a.val.assign(a.chunk_start[chunks], 0.0);
+#pragma omp parallel for schedule(static)
+  for (int c = 0; c < chunks; ++c) {
+    for (int l = 0; l < kChunk; ++l) {
+      const int i = a.row[c * kChunk + l];
+      if (i < 0) continue;
+      for (int j = 0; j < length(i); ++j) {
+        const int k = a.chunk_start[c] + j * kChunk + l;
+        a.cols[k] = cols[row_ptr[i] + j];
+        a.val[k] = val[row_ptr[i] + j];
+      }
+    }
+  }
+  return a;
+}
+
+void SellSpmv(const Sell& a, const double* x, double* y) {
+  static const auto chunk_kernel =
+      __builtin_cpu_supports("avx512f") ? ChunkAvx512 : ChunkGeneric;
+  const int chunks = a.Chunks();
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int c = 0; c < chunks; ++c) {
+    alignas(64) double sum[kChunk];
+    chunk_kernel(a.cols.data() + a.chunk_start[c],
+                 a.val.data() + a.chunk_start[c], a.chunk_width[c], x, sum);
+    const int* row = a.row.data() + c * kChunk;
+    for (int l = 0; l < kChunk; ++l) {
+      if (row[l] >= 0) y[row[l]] = sum[l];
+    }
+  }
+}
+
+void EllRowMajor(int rows, int width, const int* cols, const double* val,
+                 const double* x, double* y) {
+  for (int i = 0; i < rows; i++) {
+    double sum = y[i];
+    for (int j = 0; j < width; j++) {
+      sum += val[j + i * width] * x[cols[j + i * width]];
+    }
+    y[i] = sum;
+  }
+}
+
+Ell ToColumnMajorEll(int rows, int width, const int* cols, const double* val) {
+  Ell a;
+  a.rows = rows;
+  a.padded_rows = (rows + kChunk - 1) / kChunk * kChunk;
+  a.width = width;
+  a.cols.assign(static_cast<size_t>(a.padded_rows) * width, 0);
+  a.val.assign(static_cast<size_t>(a.padded_rows) * width, 0.0);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < width; ++j) {
+      a.cols[static_cast<size_t>(j) * a.padded_rows + i] = cols[i * width + j];
+      a.val[static_cast<size_t>(j) * a.padded_rows + i] = val[i * width + j];
+    }
+  }
+  return a;
+}
+
+void EllSpmv(const Ell& a, const double* x, double* y) {
+  EllSpmvBatch(a, 1, x, y);
+}
+
+void EllSpmvBatch(const Ell& a, int count, const double* x, double* y) {
+  static const EllKernel kernels[kMaxRhs] = {
+      SelectEll<1>(), SelectEll<2>(), SelectEll<3>(), SelectEll<4>(),
+      SelectEll<5>(), SelectEll<6>(), SelectEll<7>(), SelectEll<8>()};
+  auto run = [&](int first, int chunks, double* y_first) {
+    for (int r0 = 0; r0 < count; r0 += kMaxRhs) {
+      const int n = std::min(kMaxRhs, count - r0);
+      kernels[n - 1](a.cols.data() + first, a.val.data() + first,
+                     a.padded_rows, a.width, chunks, count, x + r0,
+                     y_first + r0);
+    }
+  };
+  // Full chunks update y in place; a partial last chunk goes through a
+  // buffer so that its padding rows leave y alone.
+  const int full = a.rows / kChunk;
+  const int tasks = (full + kEllTask - 1) / kEllTask;
+#pragma omp parallel for schedule(static)
+  for (int t = 0; t < tasks; ++t) {
+    const int first = t * kEllTask * kChunk;
+    const int chunks = std::min(kEllTask, full - t * kEllTask);
+    run(first, chunks, y + static_cast<long>(first) * count);
+  }
+  const int first = full * kChunk;
+  if (first < a.rows) {
+    std::vector<double> buffer(static_cast<size_t>(kChunk) * count, 0.0);
+    double* y_first = y + static_cast<long>(first) * count;
+    std::copy(y_first, y_first + (a.rows - first) * count, buffer.begin());
+    run(first, 1, buffer.data());
+    std::copy(buffer.begin(), buffer.begin() + (a.rows - first) * count,
+              y_first);
+  }
+}
+
+}  // namespace spmv
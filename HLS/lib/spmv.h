@@ -0,0 +1,87 @@
+#ifndef SPMV_H_
+#define SPMV_H_
+
+#include <vector>
+
+// Sparse matrix-vector products over the CRS arrays of
+// data/sources/spmv-crs_kernel.c (rowDelimiters, cols, val) for any size:
+// a merge-path parallel CRS kernel and the SELL-C-sigma format with a SIMD
+// kernel, y = A * x. The ELLPACK arrays of spmv-ellpack_kernel.c get a
+// column-major layout for SIMD and burst access, y += A * x.
+namespace spmv {
+
+// The loop of spmv(): each row summed in storage order.
+void Crs(int rows, const int* row_ptr, const int* cols, const double* val,
+         const double* x, double* y);
+
+// CRS split into `parts` pieces of equal rows + nonzeros along the merge path
+// of row ends and nonzeros (0: one per OpenMP thread), run in parallel. A
+// row cut by a split is summed in two pieces that are added afterwards, so it
+// can differ from Crs in the last bits.
+void CrsMergePath(int rows, const int* row_ptr, const int* cols,
+                  const double* val, const double* x, double* y,
+                  int parts = 0);
+
+// SELL-C-sigma with C = kChunk: rows are sorted by decreasing length within
+// windows of sigma rows, grouped into chunks of kChunk rows and each chunk is
+// stored column-major, padded to its longest row with zeros that refer to
+// column 0.
+const int kChunk = 8;
+
+struct Sell {
+  int rows = 0;
+  int nnz = 0;
+  int sigma = 0;
+  std::vector<int> chunk_start;  // offset of chunk c in cols/val, c <= chunks
+  std::vector<int> chunk_width;  // longest row of chunk c
+  std::vector<int> row;          // original row of each slot, -1 if padding
+  std::vector<int> cols;
+  std::vector<double> val;
+
+  int Chunks() const { return static_cast<int>(chunk_width.size()); }
+  // Stored entries over nonzeros.
+  double Fill() const;
+};
+
+Sell ToSell(int rows, const int* row_ptr, const int* cols, const double* val,
+            int sigma = 256);
+
+// Sums every row in the order of its CRS entries, so for a finite x the
+// result is bitwise identical to Crs. Chunks are spread over the OpenMP
+// threads; the AVX-512 kernel gathers x for eight rows at a time.
+void SellSpmv(const Sell& a, const double* x, double* y);
+
+// ELLPACK with a fixed number of entries per row. ellpack() stores row i at
+// nzval[i * width .. (i + 1) * width), so consecutive rows are `width` apart.
+// The loop of ellpack(): y[i] += the products of row i in storage order.
+void EllRowMajor(int rows, int width, const int* cols, const double* val,
+                 const double* x, double* y);
+
+// The same matrix transposed: entry j of row i at j * padded_rows + i, with
+// the rows padded to a multiple of kChunk by zero entries that refer to
+// column 0. Entry j of kChunk consecutive rows is one unit-stride load, and
+// each of the width columns is one contiguous burst.
+struct Ell {
+  int rows = 0;
+  int padded_rows = 0;
+  int width = 0;
+  std::vector<int> cols;
+  std::vector<double> val;
+};
+
+Ell ToColumnMajorEll(int rows, int width, const int* cols, const double* val);
+
+// Adds the products to y in the order of EllRowMajor, so for a finite x the
+// result is bitwise identical to it. kChunk rows at a time, spread over the
+// OpenMP threads; the AVX-512 kernel gathers x for all eight.
+void EllSpmv(const Ell& a, const double* x, double* y);
+
+// EllSpmv for `count` right-hand sides stored interleaved, x[c * count + r]
+// and y[i * count + r], so that the right-hand sides of one column share
+// cache lines. Each block of val and cols is loaded once for up to eight of
+// them.
+void EllSpmvBatch(const Ell& a, int count, const double* x, double* y);
+
+}  // namespace spmv
+
+#endif
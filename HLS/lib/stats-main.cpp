@@ -0,0 +1,158 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+#include "stats.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+// Welford's update and the blocked product reassociate the sums.
+const double kTolerance = 1e-9;
+
+// The arrays a run leaves behind: data, the matrix, mean and, for
+// correlation, stddev.
+using Outputs = check::Arrays;
+
+struct Problem {
+  int n;
+  int m;
+  double float_n;
+  vector<double> data;
+};
+
+Outputs Run(bool correlation, bool fast, Problem p) {
+  Outputs out = {p.data, vector<double>(static_cast<size_t>(p.m) * p.m),
+                 vector<double>(p.m)};
+  if (correlation) {
+    out.emplace_back(p.m);
+    (fast ? stats::Correlation : stats::CorrelationReference)(
+        p.n, p.m, p.float_n, out[0].data(), out[1].data(), out[2].data(),
+        out[3].data());
+  } else {
+    (fast ? stats::Covariance : stats::CovarianceReference)(
+        p.n, p.m, p.float_n, out[0].data(), out[1].data(), out[2].data());
+  }
+  return out;
+}
+
+// Checks both versions of one kernel on a problem against `expected`, the
+// reference bit for bit and the fast one to kTolerance.
+int Check(const string& name, bool correlation, const Problem& p,
+          const Outputs& expected) {
+  int error = 0;
+  if (!check::Same(Run(correlation, false, p), expected)) {
+    clog << name << ": reference differs" << endl;
+    ++error;
+  }
+  const double e = check::Error(Run(correlation, true, p), expected);
+  if (!(e <= kTolerance)) {
+    clog << name << ": fast version differs, error " << e << endl;
+    ++error;
+  }
+  return error;
+}
+
+Problem RandomProblem(int n, int m, double offset, kernels::Rng& rng) {
+  Problem p{n, m, static_cast<double>(n),
+            vector<double>(static_cast<size_t>(n) * m)};
+  kernels::FillUniform(p.data.data(), p.data.size(), rng);
+  for (double& x : p.data) x += offset;
+  return p;
+}
+
+}  // namespace
+
+// Checks the Welford/SYRK correlation and covariance against
+// kernel_correlation, kernel_covariance and the reference loops on many
+// shapes, then times both on n x m data:
+//   stats [n m]...
+int main(int argc, char** argv) {
+  vector<std::pair<int, int>> sizes;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    sizes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1])});
+  }
+  for (auto [n, m] : sizes) {
+    if (n < 2 || m < 1) argc = 0;
+  }
+  if (argc % 2 == 0) {
+    clog << "Usage: " << argv[0] << " [n m]...\n";
+    return EXIT_FAILURE;
+  }
+  if (sizes.empty()) sizes = {{1000, 500}, {2000, 1000}};
+
+  int error = 0;
+  for (bool correlation : {true, false}) {
+    const string name = correlation ? "correlation" : "covariance";
+    const kernels::Kernel& kernel = *kernels::FindKernel(name);
+    const int first = correlation ? 1 : 3;
+    for (int seed = 1; seed <= 3; ++seed) {
+      kernels::Args args = kernels::MakeArgs(kernel, seed);
+      const int m = static_cast<int>(args.Count(first + 2));
+      Problem p{static_cast<int>(args.Count(first)) / m, m,
+                args.Value<double>(first - 1),
+                vector<double>(args.Ptr<double*>(first),
+                               args.Ptr<double*>(first) + args.Count(first))};
+      kernel.run(args);
+      Outputs expected;
+      for (int i = first; i < args.Size(); ++i) {
+        const double* data = args.Ptr<double*>(i);
+        expected.emplace_back(data, data + args.Count(i));
+      }
+      error += Check(name + " seed " + std::to_string(seed), correlation, p,
+                     expected);
+    }
+  }
+
+  kernels::Rng rng(42);
+  for (auto [n, m] : {std::pair<int, int>{2, 1}, {3, 2}, {7, 30}, {100, 80},
+                      {300, 17}, {17, 300}, {700, 513}, {2000, 40}}) {
+    for (double offset : {0.0, 1000.0}) {
+      const Problem p = RandomProblem(n, m, offset, rng);
+      for (bool correlation : {true, false}) {
+        const string name = (correlation ? "correlation " : "covariance ") +
+                            std::to_string(n) + " x " + std::to_string(m) +
+                            " + " + std::to_string(offset);
+        error += Check(name, correlation, p, Run(correlation, false, p));
+      }
+    }
+  }
+
+  for (auto [n, m] : sizes) {
+    const Problem p = RandomProblem(n, m, 0.0, rng);
+    for (bool correlation : {true, false}) {
+      Outputs expected, out;
+      bench::Timing reference = bench::Measure(
+          0, 1, [] {}, [&] { expected = Run(correlation, false, p); });
+      bench::Timing fast = bench::Measure(
+          1, 3, [] {}, [&] { out = Run(correlation, true, p); });
+      const string name = (correlation ? "correlation " : "covariance ") +
+                          std::to_string(n) + " x " + std::to_string(m);
+      const double e = check::Error(out, expected);
+      if (!(e <= kTolerance)) {
+        clog << name << ": fast version differs, error " << e << endl;
+        ++error;
+      }
+      cout << name << ": reference " << reference.median << " s, fast "
+           << fast.median << " s, speedup " << reference.median / fast.median
+           << "x" << endl;
+    }
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+#include "stats.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gemm.h"
+
+namespace stats {
+
+namespace {
+
+using gemm::Trans;
+
+// Fewest rows per thread in the moments pass and per task when centring.
+const int kMinRows = 256;
+// Rows of the product per SYRK task.
+const int kBlock = 256;
+// Near-zero standard deviations are replaced by 1, as in kernel_correlation.
+const double kEps = 0.1;
+
+// Welford's update over rows i0..i1 of every column.
+void Welford(int i0, int i1, int m, const double* data, double* mean,
+             double* m2) {
+  std::fill(mean, mean + m, 0.0);
+  std::fill(m2, m2 + m, 0.0);
+  for (int i = i0; i < i1; ++i) {
+    const double* row = data + static_cast<long>(i) * m;
+    const double inv = 1.0 / (i - i0 + 1);
+    for (int j = 0; j < m; ++j) {
+      const double delta = row[j] - mean[j];
+      mean[j] += delta * inv;
+      m2[j] += delta * (row[j] - mean[j]);
+    }
+  }
+}
+
+// Means of the kernels, sum / float_n, from the Welford means of n rows.
+void KernelMeans(int n, int m, double float_n, const double* welford,
+                 double* mean) {
+  const double scale = n / float_n;
+  for (int j = 0; j < m; ++j) mean[j] = welford[j] * scale;
+}
+
+// Sum of squared deviations from the kernel's mean rather than the Welford
+// one, which differ when float_n is not n.
+double Deviations(int n, double welford, double m2, double mean) {
+  const double shift = welford - mean;
+  return m2 + n * shift * shift;
+}
+
+// data[i][j] = (data[i][j] - mean[j]) / divisor[j], or without the division
+// when divisor is null.
+void Centre(int n, int m, double* data, const double* mean,
+            const double* divisor) {
+#pragma omp parallel for schedule(static) if (n >= 2 * kMinRows)
+  for (int i = 0; i < n; ++i) {
+    double* row = data + static_cast<long>(i) * m;
+    if (divisor == nullptr) {
+      for (int j = 0; j < m; ++j) row[j] -= mean[j];
+    } else {
+      for (int j = 0; j < m; ++j) row[j] = (row[j] - mean[j]) / divisor[j];
+    }
+  }
+}
+
+// c = data^T * data for the n x m data, scaled by 1 / divisor, with ones on
+// the diagonal when unit_diagonal. Each task computes a block row of the lower
+// triangle, one GEMM left of the diagonal block and a triangular one for it,
+// then copies the block row to the matching block column above the diagonal,
+// which no other task touches.
+void SymmetricProduct(int n, int m, const double* data, double* c,
+                      double divisor, bool unit_diagonal) {
+  const int blocks = (m + kBlock - 1) / kBlock;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int b = blocks - 1; b >= 0; --b) {
+    const int i0 = b * kBlock;
+    const int rows = std::min(kBlock, m - i0);
+    double* block = c + static_cast<long>(i0) * m;
+    gemm::Dgemm(Trans::kYes, Trans::kNo, rows, i0, n, 1.0, data + i0, m, data,
+                m, 0.0, block, m);
+    gemm::DgemmLower(Trans::kYes, Trans::kNo, rows, n, 1.0, data + i0, m,
+                     data + i0, m, 0.0, block + i0, m);
+    for (int i = i0; i < i0 + rows; ++i) {
+      double* row = c + static_cast<long>(i) * m;
+      if (divisor != 1.0) {
+        for (int j = 0; j <= i; ++j) row[j] /= divisor;
+      }
+      if (unit_diagonal) row[i] = 1.0;
+    }
+    for (int j = 0; j < i0 + rows; ++j) {
+      double* row = c + static_cast<long>(j) * m;
+      for (int i = std::max(i0, j + 1); i < i0 + rows; ++i) {
+        row[i] = c[static_cast<long>(i) * m + j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void CorrelationReference(int n, int m, double float_n, double* data,
+                          double* corr, double* mean, double* stddev) {
+  for (int j = 0; j < m; j++) {
+    mean[j] = 0.0;
+    for (int i = 0; i < n; i++) mean[j] += data[i * m + j];
+    mean[j] /= float_n;
+  }
+  for (int j = 0; j < m; j++) {
+    stddev[j] = 0.0;
+    for (int i = 0; i < n; i++) {
+      stddev[j] += std::pow(data[i * m + j] - mean[j], 2.0);
+    }
+    stddev[j] /= float_n;
+    stddev[j] = std::sqrt(stddev[j]);
+    stddev[j] = stddev[j] <= kEps ? 1.0 : stddev[j];
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < m; j++) {
+      data[i * m + j] -= mean[j];
+      data[i * m + j] /= std::sqrt(float_n) * stddev[j];
+    }
+  }
+  for (int i = 0; i < m - 1; i++) {
+    corr[i * m + i] = 1.0;
+    for (int j = i + 1; j < m; j++) {
+      corr[i * m + j] = 0.0;
+      for (int k = 0; k < n; k++) {
+        corr[i * m + j] += data[k * m + i] * data[k * m + j];
+      }
+      corr[j * m + i] = corr[i * m + j];
+    }
+  }
+  corr[(m - 1) * m + m - 1] = 1.0;
+}
+
+void CovarianceReference(int n, int m, double float_n, double* data,
+                         double* cov, double* mean) {
+  for (int j = 0; j < m; j++) {
+    mean[j] = 0.0;
+    for (int i = 0; i < n; i++) mean[j] += data[i * m + j];
+    mean[j] /= float_n;
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < m; j++) data[i * m + j] -= mean[j];
+  }
+  for (int i = 0; i < m; i++) {
+    for (int j = i; j < m; j++) {
+      cov[i * m + j] = 0.0;
+      for (int k = 0; k < n; k++) {
+        cov[i * m + j] += data[k * m + i] * data[k * m + j];
+      }
+      cov[i * m + j] /= float_n - 1.0;
+      cov[j * m + i] = cov[i * m + j];
+    }
+  }
+}
+
+void Moments(int n, int m, const double* data, double* mean, double* m2) {
+  const int bands =
+      std::max(1, std::min(omp_get_max_threads(), n / kMinRows));
+  if (bands == 1) {
+    Welford(0, n, m, data, mean, m2);
+    return;
+  }
+  const int height = (n + bands - 1) / bands;
+  std::vector<double> means(static_cast<size_t>(bands) * m);
+  std::vector<double> m2s(means.size());
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < bands; ++b) {
+    Welford(b * height, std::min(n, (b + 1) * height), m, data,
+            means.data() + static_cast<long>(b) * m,
+            m2s.data() + static_cast<long>(b) * m);
+  }
+  // Chan et al.'s merge of the bands' moments, in order.
+  std::copy(means.begin(), means.begin() + m, mean);
+  std::copy(m2s.begin(), m2s.begin() + m, m2);
+  double count = std::min(n, height);
+  for (int b = 1; b < bands; ++b) {
+    const double rows = std::min(n, (b + 1) * height) - b * height;
+    const double total = count + rows;
+    const double* band_mean = means.data() + static_cast<long>(b) * m;
+    const double* band_m2 = m2s.data() + static_cast<long>(b) * m;
+    for (int j = 0; j < m; ++j) {
+      const double delta = band_mean[j] - mean[j];
+      mean[j] += delta * (rows / total);
+      m2[j] += band_m2[j] + delta * delta * (count * rows / total);
+    }
+    count = total;
+  }
+}
+
+void Correlation(int n, int m, double float_n, double* data, double* corr,
+                 double* mean, double* stddev) {
+  if (n < 1 || m < 1) return;
+  std::vector<double> welford(m), m2(m), divisor(m);
+  Moments(n, m, data, welford.data(), m2.data());
+  KernelMeans(n, m, float_n, welford.data(), mean);
+  for (int j = 0; j < m; ++j) {
+    const double s =
+        std::sqrt(Deviations(n, welford[j], m2[j], mean[j]) / float_n);
+    stddev[j] = s <= kEps ? 1.0 : s;
+    divisor[j] = std::sqrt(float_n) * stddev[j];
+  }
+  Centre(n, m, data, mean, divisor.data());
+  SymmetricProduct(n, m, data, corr, 1.0, true);
+}
+
+void Covariance(int n, int m, double float_n, double* data, double* cov,
+                double* mean) {
+  if (n < 1 || m < 1) return;
+  std::vector<double> welford(m), m2(m);
+  Moments(n, m, data, welford.data(), m2.data());
+  KernelMeans(n, m, float_n, welford.data(), mean);
+  Centre(n, m, data, mean, nullptr);
+  SymmetricProduct(n, m, data, cov, float_n - 1.0, false);
+}
+
+}  // namespace stats
@@ -0,0 +1,37 @@
+#ifndef STATS_H_
+#define STATS_H_
+
+// Correlation and covariance matrices of data/sources/correlation_kernel.c and
+// data/sources/covariance_kernel.c for an n x m row-major data matrix of n
+// observations of m variables. float_n is the observation count the kernels
+// divide by; n = 100, m = 80 and float_n = 100 give kernel_correlation and
+// kernel_covariance. Both versions leave data centred (and, for correlation,
+// reduced) in place, as the kernels do.
+namespace stats {
+
+// The loop nests of kernel_correlation and kernel_covariance: a pass for the
+// means, one for the standard deviations, one to centre the data, then a dot
+// product per entry of the upper triangle, mirrored below it.
+void CorrelationReference(int n, int m, double float_n, double* data,
+                          double* corr, double* mean, double* stddev);
+void CovarianceReference(int n, int m, double float_n, double* data,
+                         double* cov, double* mean);
+
+// Means and sums of squared deviations of the m columns in one pass over the
+// rows with Welford's update, vectorised across the columns. Bands of rows
+// are spread over the OpenMP threads and their moments merged.
+void Moments(int n, int m, const double* data, double* mean, double* m2);
+
+// One Welford pass gives the means and standard deviations, a second centres
+// the data, and the m x m product data^T * data is a blocked SYRK on the GEMM
+// engine: one triangle is computed, by block rows spread over the threads,
+// and mirrored. The sums are reassociated, so results agree with the kernels
+// to rounding rather than bit for bit.
+void Correlation(int n, int m, double float_n, double* data, double* corr,
+                 double* mean, double* stddev);
+void Covariance(int n, int m, double float_n, double* data, double* cov,
+                double* mean);
+
+}  // namespace stats
+
+#endif
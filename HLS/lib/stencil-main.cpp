@@ -0,0 +1,179 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "kernels.h"
+#include "stencil.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace {
+
+template <typename T>
+bool Same(const vector<T>& x, const T* y) {
+  return std::memcmp(x.data(), y, x.size() * sizeof(T)) == 0;
+}
+
+// Checks the 2-D filter on a rows x cols grid against the reference loops.
+int Check2d(int rows, int cols, kernels::Rng& rng) {
+  vector<int> orig(static_cast<size_t>(rows) * cols), filter(9);
+  kernels::FillInt(orig.data(), orig.size(), -1000, 1000, rng);
+  kernels::FillInt(filter.data(), filter.size(), -100, 100, rng);
+  vector<int> expected(orig.size()), sol(orig.size());
+  kernels::FillInt(expected.data(), expected.size(), -100, 100, rng);
+  sol = expected;
+  stencil::Filter2dReference(rows, cols, orig.data(), expected.data(),
+                             filter.data());
+  stencil::Filter2d(rows, cols, orig.data(), sol.data(), filter.data());
+  if (!Same(sol, expected.data())) {
+    clog << "stencil " << rows << " x " << cols << " differs" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int Check3d(int planes, int rows, int cols, kernels::Rng& rng) {
+  vector<long> orig(static_cast<size_t>(planes) * rows * cols);
+  kernels::FillInt(orig.data(), orig.size(), -1000L, 1000L, rng);
+  vector<long> expected(orig.size()), sol(orig.size());
+  kernels::FillInt(expected.data(), expected.size(), -100L, 100L, rng);
+  sol = expected;
+  stencil::Stencil3dReference(planes, rows, cols, 3, -2, orig.data(),
+                              expected.data());
+  stencil::Stencil3d(planes, rows, cols, 3, -2, orig.data(), sol.data());
+  if (!Same(sol, expected.data())) {
+    clog << "stencil3d " << planes << " x " << rows << " x " << cols
+         << " differs" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+
+// Checks the SIMD stencils against stencil(), stencil3d() and the reference
+// loops on many grid shapes, then times both on an n x n grid and an
+// n3 x n3 x n3 one:
+//   stencil [n n3]
+int main(int argc, char** argv) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 4096;
+  const int n3 = argc > 2 ? std::atoi(argv[2]) : 256;
+  if (argc > 3 || n < 3 || n3 < 3) {
+    clog << "Usage: " << argv[0] << " [n n3]\n";
+    return EXIT_FAILURE;
+  }
+
+  int error = 0;
+  kernels::Rng rng(42);
+  for (stencil::Isa isa : {stencil::Isa::kGeneric, stencil::Isa::kAvx512}) {
+    if (!stencil::SetIsa(isa)) continue;
+    clog << "Check " << stencil::IsaName(isa) << endl;
+    for (int seed = 1; seed <= 3; ++seed) {
+      const kernels::Kernel& kernel = *kernels::FindKernel("stencil");
+      kernels::Args args = kernels::MakeArgs(kernel, seed);
+      const int* orig = args.Ptr<int*>(0);
+      const int* filter = args.Ptr<int*>(2);
+      vector<int> reference(args.Ptr<int*>(1),
+                            args.Ptr<int*>(1) + args.Count(1));
+      vector<int> sol = reference;
+      stencil::Filter2dReference(128, 64, orig, reference.data(), filter);
+      stencil::Filter2d(128, 64, orig, sol.data(), filter);
+      kernel.run(args);
+      if (!Same(reference, args.Ptr<int*>(1))) {
+        clog << "stencil seed " << seed << ": reference differs" << endl;
+        ++error;
+      }
+      if (!Same(sol, args.Ptr<int*>(1))) {
+        clog << "stencil seed " << seed << ": SIMD filter differs" << endl;
+        ++error;
+      }
+
+      const kernels::Kernel& kernel3d = *kernels::FindKernel("stencil-3d");
+      kernels::Args args3d = kernels::MakeArgs(kernel3d, seed);
+      const long c0 = args3d.Value<long>(0);
+      const long c1 = args3d.Value<long>(1);
+      const long* orig3d = args3d.Ptr<long*>(2);
+      vector<long> reference3d(args3d.Ptr<long*>(3),
+                               args3d.Ptr<long*>(3) + args3d.Count(3));
+      vector<long> sol3d = reference3d;
+      stencil::Stencil3dReference(34, 34, 34, c0, c1, orig3d,
+                                  reference3d.data());
+      stencil::Stencil3d(34, 34, 34, c0, c1, orig3d, sol3d.data());
+      kernel3d.run(args3d);
+      if (!Same(reference3d, args3d.Ptr<long*>(3))) {
+        clog << "stencil-3d seed " << seed << ": reference differs" << endl;
+        ++error;
+      }
+      if (!Same(sol3d, args3d.Ptr<long*>(3))) {
+        clog << "stencil-3d seed " << seed << ": SIMD stencil differs" << endl;
+        ++error;
+      }
+    }
+
+    for (int rows : {3, 4, 17, 40}) {
+      for (int cols : {3, 4, 17, 18, 19, 33, 100}) {
+        error += Check2d(rows, cols, rng);
+        error += Check3d(rows, cols, rows + cols - 3, rng);
+      }
+    }
+    // Every row length up to two vectors of the 3-D stencil, so that the
+    // masks of the vector after the row's end cover -6..8 points.
+    for (int cols = 3; cols <= 17; ++cols) error += Check3d(4, 5, cols, rng);
+  }
+  stencil::SetIsa(stencil::BestIsa());
+
+  {
+    vector<int> orig(static_cast<size_t>(n) * n), filter(9);
+    kernels::FillInt(orig.data(), orig.size(), -1000, 1000, rng);
+    kernels::FillInt(filter.data(), filter.size(), -100, 100, rng);
+    vector<int> expected(orig.size()), sol(orig.size());
+    bench::Timing reference = bench::Measure(1, 3, [] {}, [&] {
+      stencil::Filter2dReference(n, n, orig.data(), expected.data(),
+                                 filter.data());
+    });
+    bench::Timing simd = bench::Measure(1, 5, [] {}, [&] {
+      stencil::Filter2d(n, n, orig.data(), sol.data(), filter.data());
+    });
+    if (!Same(sol, expected.data())) {
+      clog << "stencil " << n << " x " << n << " differs" << endl;
+      ++error;
+    }
+    cout << "stencil " << n << " x " << n << ": reference " << reference.median
+         << " s, SIMD " << simd.median << " s, speedup "
+         << reference.median / simd.median << "x" << endl;
+  }
+  {
+    vector<long> orig(static_cast<size_t>(n3) * n3 * n3);
+    kernels::FillInt(orig.data(), orig.size(), -1000L, 1000L, rng);
+    vector<long> expected(orig.size()), sol(orig.size());
+    bench::Timing reference = bench::Measure(1, 3, [] {}, [&] {
+      stencil::Stencil3dReference(n3, n3, n3, 2, -1, orig.data(),
+                                  expected.data());
+    });
+    bench::Timing simd = bench::Measure(1, 5, [] {}, [&] {
+      stencil::Stencil3d(n3, n3, n3, 2, -1, orig.data(), sol.data());
+    });
+    if (!Same(sol, expected.data())) {
+      clog << "stencil3d " << n3 << "^3 differs" << endl;
+      ++error;
+    }
+    cout << "stencil3d " << n3 << "^3: reference " << reference.median
+         << " s, SIMD " << simd.median << " s, speedup "
+         << reference.median / simd.median << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+#include "stencil.h"
+
+#include <immintrin.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace stencil {
+
+namespace {
+
+// Fewest output rows per thread in the 2-D filter.
+const int kMinBand = 16;
+
+__attribute__((target("avx512f"))) __mmask16 Mask16(int left) {
+  return left >= 16 ? 0xffff
+                    : left <= 0 ? 0 : static_cast<__mmask16>((1u << left) - 1);
+}
+
+// Output rows r0..r1 of the filter. Input rows are read once, left to
+// right: the strip of 16 outputs from column c needs columns c..c+17, the
+// vector of this strip and the next, aligned into the three shifted ones,
+// and the next strip reuses the second. Input row i adds its three weighted
+// sums to output rows i - 2, i - 1 and i; the partial rows i - 1 and i wait
+// in two line buffers that rotate down the band.
+__attribute__((target("avx512f"))) void Filter2dAvx512(int r0, int r1,
+                                                       int cols,
+                                                       const int* orig,
+                                                       int* sol,
+                                                       const int* filter) {
+  __m512i f[9];
+  for (int k = 0; k < 9; ++k) f[k] = _mm512_set1_epi32(filter[k]);
+  const int outputs = cols - 2;
+  thread_local std::vector<int> lines;
+  lines.resize(2 * static_cast<size_t>(outputs + 15) / 16 * 16);
+  int* upper = lines.data();
+  int* lower = upper + lines.size() / 2;
+  for (int i = r0; i < r1 + 2; ++i) {
+    const int* row = orig + static_cast<long>(i) * cols;
+    int* out = sol + static_cast<long>(i - 2) * cols;
+    __m512i x0 = _mm512_maskz_loadu_epi32(Mask16(cols), row);
+    for (int c = 0; c < outputs; c += 16) {
+      const __mmask16 m = Mask16(outputs - c);
+      const __m512i next = _mm512_maskz_loadu_epi32(Mask16(cols - c - 16),
+                                                    row + c + 16);
+      const __m512i x1 = _mm512_alignr_epi32(next, x0, 1);
+      const __m512i x2 = _mm512_alignr_epi32(next, x0, 2);
+      __m512i h[3];
+      for (int k = 0; k < 3; ++k) {
+        h[k] = _mm512_add_epi32(
+            _mm512_add_epi32(_mm512_mullo_epi32(f[3 * k], x0),
+                             _mm512_mullo_epi32(f[3 * k + 1], x1)),
+            _mm512_mullo_epi32(f[3 * k + 2], x2));
+      }
+      if (i >= r0 + 2) {
+        _mm512_mask_storeu_epi32(
+            out + c, m, _mm512_add_epi32(_mm512_loadu_si512(upper + c), h[2]));
+      }
+      if (i >= r0 + 1) {
+        _mm512_storeu_si512(
+            upper + c, _mm512_add_epi32(_mm512_loadu_si512(lower + c), h[1]));
+      }
+      _mm512_storeu_si512(lower + c, h[0]);
+      x0 = next;
+    }
+  }
+}
+
+void Filter2dGeneric(int r0, int r1, int cols, const int* orig, int* sol,
+                     const int* filter) {
+  for (int r = r0; r < r1; r++) {
+    int* out = sol + static_cast<long>(r) * cols;
+    for (int c = 0; c < cols - 2; c++) out[c] = 0;
+    for (int k1 = 0; k1 < 3; k1++) {
+      const int* in = orig + static_cast<long>(r + k1) * cols;
+      for (int c = 0; c < cols - 2; c++) {
+        out[c] += filter[k1 * 3] * in[c] + filter[k1 * 3 + 1] * in[c + 1] +
+                  filter[k1 * 3 + 2] * in[c + 2];
+      }
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) __mmask8 Mask8(int left) {
+  return left >= 8 ? 0xff
+                   : left <= 0 ? 0 : static_cast<__mmask8>((1u << left) - 1);
+}
+
+// Interior rows of plane p, eight points at a time along each row. The
+// row's vectors are loaded once and rotate through registers, the
+// neighbours along it aligned from the previous, current and next one; the
+// rows above and below and the neighbouring planes come from the cache.
+__attribute__((target("avx512f,avx512dq"))) void Plane3dAvx512(
+    int p, int rows, int cols, long c0, long c1, const long* orig,
+    long* sol) {
+  const __m512i c0_v = _mm512_set1_epi64(c0);
+  const __m512i c1_v = _mm512_set1_epi64(c1);
+  const long plane = static_cast<long>(rows) * cols;
+  for (int j = 1; j < rows - 1; ++j) {
+    const long start = p * plane + static_cast<long>(j) * cols;
+    const long* row = orig + start;
+    // Vectors start at k = 1; `prev` holds k - 8 .. k - 1.
+    __m512i prev = _mm512_maskz_loadu_epi64(1, row);
+    prev = _mm512_alignr_epi64(prev, _mm512_setzero_si512(), 1);
+    __m512i here = _mm512_maskz_loadu_epi64(Mask8(cols - 1), row + 1);
+    for (int k = 1; k < cols - 1; k += 8) {
+      const __mmask8 m = Mask8(cols - 1 - k);
+      const __m512i next =
+          _mm512_maskz_loadu_epi64(Mask8(cols - k - 8), row + k + 8);
+      const __m512i right = _mm512_alignr_epi64(next, here, 1);
+      const __m512i left = _mm512_alignr_epi64(here, prev, 7);
+      const long* at = row + k;
+      __m512i sum = _mm512_add_epi64(_mm512_maskz_loadu_epi64(m, at + plane),
+                                     _mm512_maskz_loadu_epi64(m, at - plane));
+      sum = _mm512_add_epi64(
+          sum, _mm512_add_epi64(_mm512_maskz_loadu_epi64(m, at + cols),
+                                _mm512_maskz_loadu_epi64(m, at - cols)));
+      sum = _mm512_add_epi64(sum, _mm512_add_epi64(right, left));
+      const __m512i out = _mm512_add_epi64(_mm512_mullo_epi64(here, c0_v),
+                                           _mm512_mullo_epi64(sum, c1_v));
+      _mm512_mask_storeu_epi64(sol + start + k, m, out);
+      prev = here;
+      here = next;
+    }
+  }
+}
+
+void Plane3dGeneric(int p, int rows, int cols, long c0, long c1,
+                    const long* orig, long* sol) {
+  const long plane = static_cast<long>(rows) * cols;
+  for (int j = 1; j < rows - 1; j++) {
+    const long at = p * plane + static_cast<long>(j) * cols;
+    for (int k = 1; k < cols - 1; k++) {
+      const long sum = orig[at + k + plane] + orig[at + k - plane] +
+                       orig[at + k + cols] + orig[at + k - cols] +
+                       orig[at + k + 1] + orig[at + k - 1];
+      sol[at + k] = orig[at + k] * c0 + sum * c1;
+    }
+  }
+}
+
+struct Engine {
+  Isa isa;
+  void (*filter2d)(int r0, int r1, int cols, const int* orig, int* sol,
+                   const int* filter);
+  void (*plane3d)(int p, int rows, int cols, long c0, long c1,
+                  const long* orig, long* sol);
+};
+
+const Engine kEngines[] = {
+    {Isa::kGeneric, Filter2dGeneric, Plane3dGeneric},
+    {Isa::kAvx512, Filter2dAvx512, Plane3dAvx512},
+};
+
+bool Supported(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return true;
+    case Isa::kAvx512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512dq");
+  }
+  return false;
+}
+
+// Set by SetIsa; read at the start of every stencil call.
+std::atomic<const Engine*> forced{nullptr};
+
+const Engine& Selected() {
+  static const Engine& best = kEngines[static_cast<int>(BestIsa())];
+  const Engine* engine = forced.load(std::memory_order_acquire);
+  return engine != nullptr ? *engine : best;
+}
+
+}  // namespace
+
+Isa BestIsa() {
+  if (Supported(Isa::kAvx512)) return Isa::kAvx512;
+  return Isa::kGeneric;
+}
+
+Isa CurrentIsa() { return Selected().isa; }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  forced.store(&kEngines[static_cast<int>(isa)], std::memory_order_release);
+  return true;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kGeneric: return "generic";
+    case Isa::kAvx512: return "avx512";
+  }
+  return "?";
+}
+
+void Filter2dReference(int rows, int cols, const int* orig, int* sol,
+                       const int* filter) {
+  for (int r = 0; r < rows - 2; r++) {
+    for (int c = 0; c < cols - 2; c++) {
+      int temp = 0;
+      for (int k1 = 0; k1 < 3; k1++) {
+        for (int k2 = 0; k2 < 3; k2++) {
+          temp += filter[k1 * 3 + k2] * orig[(r + k1) * cols + c + k2];
+        }
+      }
+      sol[r * cols + c] = temp;
+    }
+  }
+}
+
+void Filter2d(int rows, int cols, const int* orig, int* sol,
+              const int* filter) {
+  const int outputs = rows - 2;
+  if (outputs <= 0 || cols < 3) return;
+  const Engine& engine = Selected();
+  const int bands =
+      std::max(1, std::min(omp_get_max_threads(), outputs / kMinBand));
+  const int height = (outputs + bands - 1) / bands;
+#pragma omp parallel for schedule(static)
+  for (int b = 0; b < bands; ++b) {
+    const int r0 = b * height;
+    engine.filter2d(r0, std::min(outputs, r0 + height), cols, orig, sol,
+                    filter);
+  }
+}
+
+void Stencil3dReference(int planes, int rows, int cols, long c0, long c1,
+                        const long* orig, long* sol) {
+  const long plane = static_cast<long>(rows) * cols;
+  for (int i = 1; i < planes - 1; i++) {
+    for (int j = 1; j < rows - 1; j++) {
+      for (int k = 1; k < cols - 1; k++) {
+        const long at = i * plane + static_cast<long>(j) * cols + k;
+        const long sum0 = orig[at];
+        const long sum1 = orig[at + plane] + orig[at - plane] +
+                          orig[at + cols] + orig[at - cols] + orig[at + 1] +
+                          orig[at - 1];
+        sol[at] = sum0 * c0 + sum1 * c1;
+      }
+    }
+  }
+}
+
+void Stencil3d(int planes, int rows, int cols, long c0, long c1,
+               const long* orig, long* sol) {
+  if (rows < 3 || cols < 3) return;
+  const Engine& engine = Selected();
+#pragma omp parallel for schedule(static)
+  for (int p = 1; p < planes - 1; ++p) {
+    engine.plane3d(p, rows, cols, c0, c1, orig, sol);
+  }
+}
+
+}  // namespace stencil
@@ -0,0 +1,48 @@
+#ifndef STENCIL_H_
+#define STENCIL_H_
+
+// The integer stencils of data/sources/stencil_stencil2d_kernel.c and
+// stencil-3d_kernel.c for any grid size. Grids are row-major; only interior
+// points of sol are written, as in the kernels, and the results are exact.
+namespace stencil {
+
+// 3 x 3 filter over a rows x cols grid: sol[r][c] for r < rows - 2 and
+// c < cols - 2 is the filter applied at orig[r..r+2][c..c+2]. rows = 128 and
+// cols = 64 give stencil().
+void Filter2dReference(int rows, int cols, const int* orig, int* sol,
+                       const int* filter);
+
+// Each input row is loaded once per strip of 16 columns, its shifted copies
+// built in registers, and its three weighted row sums added to the three
+// output rows that use it, which rotate down the strip. Bands of output rows
+// are spread over the OpenMP threads.
+void Filter2d(int rows, int cols, const int* orig, int* sol,
+              const int* filter);
+
+// 7-point stencil over a planes x rows x cols grid:
+// sol = c0 * centre + c1 * (sum of the six neighbours) at every interior
+// point. A 34 x 34 x 34 grid gives stencil3d().
+void Stencil3dReference(int planes, int rows, int cols, long c0, long c1,
+                        const long* orig, long* sol);
+
+// Eight points along a row per SIMD vector. Walking down the rows of a
+// plane, the row above, the row itself and the row below stay in registers
+// and rotate, so only the neighbouring planes and the shifted row are loaded
+// per output. Planes are spread over the OpenMP threads.
+void Stencil3d(int planes, int rows, int cols, long c0, long c1,
+               const long* orig, long* sol);
+
+enum class Isa { kGeneric, kAvx512 };
+
+// The widest instruction set the row kernels can use on this CPU.
+Isa BestIsa();
+// The instruction set in use, BestIsa() unless overridden.
+Isa CurrentIsa();
+// Forces an instruction set, to test each path on one machine. Returns false
+// and keeps the current one when the CPU lacks it.
+bool SetIsa(Isa isa);
+const char* IsaName(Isa isa);
+
+}  // namespace stencil
+
+#endif
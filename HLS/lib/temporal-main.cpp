@@ -0,0 +1,154 @@
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "check.h"
+#include "kernels.h"
+#include "temporal.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using kernels::Args;
+using temporal::Blocking;
+
+namespace {
+
+// Runs one stencil on the given arrays with the given blocking.
+using Stencil = std::function<void(vector<vector<double>>& arrays, Blocking)>;
+
+struct Case {
+  string kernel;           // registry name
+  vector<int> registry;    // registry arguments, in the order of `arrays`
+  Stencil native;          // at the registry size
+  vector<size_t> sizes;    // array sizes of the large instance
+  Stencil large;
+  Blocking blocking;       // default blocking of the stencil
+};
+
+vector<Case> Cases() {
+  using namespace temporal;
+  const int n1 = 4000000, n2 = 2000, n3 = 160, nx = 2000, ny = 2000;
+  return {
+      {"jacobi-1d", {2, 3},
+       [](vector<vector<double>>& x, Blocking b) {
+         Jacobi1d(40, 120, x[0].data(), x[1].data(), b);
+       },
+       {n1, n1},
+       [=](vector<vector<double>>& x, Blocking b) {
+         Jacobi1d(40, n1, x[0].data(), x[1].data(), b);
+       },
+       kJacobi1dBlocking},
+      {"jacobi-2d", {2, 3},
+       [](vector<vector<double>>& x, Blocking b) {
+         Jacobi2d(40, 90, x[0].data(), x[1].data(), b);
+       },
+       {n2 * n2, n2 * n2},
+       [=](vector<vector<double>>& x, Blocking b) {
+         Jacobi2d(40, n2, x[0].data(), x[1].data(), b);
+       },
+       kJacobi2dBlocking},
+      {"heat-3d", {2, 3},
+       [](vector<vector<double>>& x, Blocking b) {
+         Heat3d(40, 20, x[0].data(), x[1].data(), b);
+       },
+       {n3 * n3 * n3, n3 * n3 * n3},
+       [=](vector<vector<double>>& x, Blocking b) {
+         Heat3d(40, n3, x[0].data(), x[1].data(), b);
+       },
+       kHeat3dBlocking},
+      {"fdtd-2d", {3, 4, 5, 6},
+       [](vector<vector<double>>& x, Blocking b) {
+         Fdtd2d(40, 60, 80, x[0].data(), x[1].data(), x[2].data(),
+                x[3].data(), b);
+       },
+       {nx * ny, nx * ny, nx * ny, 40},
+       [=](vector<vector<double>>& x, Blocking b) {
+         Fdtd2d(40, nx, ny, x[0].data(), x[1].data(), x[2].data(),
+                x[3].data(), b);
+       },
+       kFdtd2dBlocking},
+      {"fdtd-2d-large", {3, 4, 5, 6},
+       [](vector<vector<double>>& x, Blocking b) {
+         Fdtd2d(100, 200, 240, x[0].data(), x[1].data(), x[2].data(),
+                x[3].data(), b);
+       },
+       {}, nullptr, kFdtd2dBlocking},
+  };
+}
+
+}  // namespace
+
+// Checks the temporally blocked stencils bit for bit against the reference
+// kernels under several blockings, then times blocked against step-by-step
+// sweeps on grids that no longer fit in cache.
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    clog << "Usage: " << argv[0] << "\n";
+    return EXIT_FAILURE;
+  }
+  const Blocking blockings[] = {{1, 1}, {2, 3}, {3, 7}, {8, 16}, {5, 64},
+                                {40, 1000}, {200, 2}};
+
+  int error = 0;
+  kernels::Rng rng(42);
+  for (const Case& c : Cases()) {
+    const kernels::Kernel& kernel = *kernels::FindKernel(c.kernel);
+    Args ref = kernels::MakeArgs(kernel);
+    vector<vector<double>> input;
+    for (int i : c.registry) {
+      const double* data = ref.Ptr<double*>(i);
+      input.emplace_back(data, data + ref.Count(i));
+    }
+    kernel.run(ref);
+    vector<vector<double>> expected;
+    for (int i : c.registry) {
+      const double* data = ref.Ptr<double*>(i);
+      expected.emplace_back(data, data + ref.Count(i));
+    }
+    for (Blocking b : blockings) {
+      vector<vector<double>> x = input;
+      c.native(x, b);
+      if (!check::Same(x, expected)) {
+        clog << c.kernel << " differs with band " << b.band << ", width "
+             << b.width << endl;
+        ++error;
+      }
+    }
+
+    if (!c.large) continue;
+    vector<vector<double>> large;
+    for (size_t size : c.sizes) {
+      large.emplace_back(size);
+      kernels::FillUniform(large.back().data(), size, rng);
+    }
+    vector<vector<double>> x;
+    bench::Timing unblocked = bench::Measure(
+        0, 3, [&] { x = large; }, [&] { c.large(x, temporal::kUnblocked); });
+    vector<vector<double>> unblocked_result = x;
+    bench::Timing blocked =
+        bench::Measure(0, 3, [&] { x = large; }, [&] { c.large(x, c.blocking); });
+    if (!check::Same(x, unblocked_result)) {
+      clog << c.kernel << " differs from step-by-step sweeps at large size"
+           << endl;
+      ++error;
+    }
+    cout << c.kernel << " large: step by step " << unblocked.median
+         << " s, blocked " << blocked.median << " s, speedup "
+         << unblocked.median / blocked.median << "x" << endl;
+  }
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
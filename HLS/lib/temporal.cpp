@@ -0,0 +1,83 @@
+#include "temporal.h"
+
+namespace temporal {
+
+namespace {
+
+const int kJacobi1dChunk = 64;
+
+}  // namespace
+
+void Jacobi1d(int tsteps, int n, double* a, double* b, Blocking blocking) {
+  // Step 2t computes B from A, step 2t + 1 computes A from B. A row of the
+  // engine is a chunk of kJacobi1dChunk points, which keeps the dependences
+  // within one row either side and gives the inner loop something to
+  // vectorise.
+  const int chunks = (n - 2 + kJacobi1dChunk - 1) / kJacobi1dChunk;
+  Run(2 * tsteps, 0, chunks - 1, blocking, [=](int s, int r) {
+    const double* in = s % 2 == 0 ? a : b;
+    double* out = s % 2 == 0 ? b : a;
+    const int end = std::min(n - 1, 1 + (r + 1) * kJacobi1dChunk);
+    for (int i = 1 + r * kJacobi1dChunk; i < end; i++) {
+      out[i] = 0.33333 * (in[i - 1] + in[i] + in[i + 1]);
+    }
+  });
+}
+
+void Jacobi2d(int tsteps, int n, double* a, double* b, Blocking blocking) {
+  Run(2 * tsteps, 1, n - 2, blocking, [=](int s, int i) {
+    const double* in = (s % 2 == 0 ? a : b) + i * n;
+    double* out = (s % 2 == 0 ? b : a) + i * n;
+    for (int j = 1; j < n - 1; j++) {
+      out[j] = 0.2 * (in[j] + in[j - 1] + in[1 + j] + in[n + j] + in[-n + j]);
+    }
+  });
+}
+
+void Heat3d(int tsteps, int n, double* a, double* b, Blocking blocking) {
+  const long plane = static_cast<long>(n) * n;
+  Run(2 * tsteps, 1, n - 2, blocking, [=](int s, int i) {
+    const double* in = (s % 2 == 0 ? a : b) + i * plane;
+    double* out = (s % 2 == 0 ? b : a) + i * plane;
+    for (int j = 1; j < n - 1; j++) {
+      for (int k = 1; k < n - 1; k++) {
+        const double* p = in + j * n + k;
+        out[j * n + k] = 0.125 * (p[plane] - 2.0 * p[0] + p[-plane]) +
+                         0.125 * (p[n] - 2.0 * p[0] + p[-n]) +
+                         0.125 * (p[1] - 2.0 * p[0] + p[-1]) + p[0];
+      }
+    }
+  });
+}
+
+void Fdtd2d(int tmax, int nx, int ny, double* ex, double* ey, double* hz,
+            const double* fict, Blocking blocking) {
+  // Step t, row i: ey row i, ex row i, then hz row i - 1, which needs ey rows
+  // i - 1 and i and ex row i - 1 of the same step.
+  Run(tmax, 0, nx - 1, blocking, [=](int t, int i) {
+    double* ey_i = ey + i * ny;
+    double* ex_i = ex + i * ny;
+    double* hz_i = hz + i * ny;
+    if (i == 0) {
+      for (int j = 0; j < ny; j++) ey_i[j] = fict[t];
+    } else {
+      for (int j = 0; j < ny; j++) {
+        ey_i[j] = ey_i[j] - 0.5 * (hz_i[j] - hz_i[j - ny]);
+      }
+    }
+    for (int j = 1; j < ny; j++) {
+      ex_i[j] = ex_i[j] - 0.5 * (hz_i[j] - hz_i[j - 1]);
+    }
+    if (i > 0) {
+      double* hz_up = hz_i - ny;
+      const double* ex_up = ex_i - ny;
+      const double* ey_up = ey_i - ny;
+      for (int j = 0; j < ny - 1; j++) {
+        hz_up[j] = hz_up[j] - 0.7 * (ex_up[j + 1] - ex_up[j] + ey_i[j] -
+                                     ey_up[j]);
+      }
+    }
+  });
+}
+
+}  // namespace temporal
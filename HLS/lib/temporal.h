@@ -0,0 +1,85 @@
+#ifndef TEMPORAL_H_
+#define TEMPORAL_H_
+
+#include <algorithm>
+
+// Temporal blocking of the time-stepped stencils of data/sources. A stencil
+// is described as a sequence of steps, each updating the rows first..last of
+// its outermost dimension (points, rows or planes) in increasing order, where
+//   - update(s, i) reads what the updates (s - 1, i - 1..i + 1) and
+//     (s, i - 1) wrote, and
+//   - update(s, i) may overwrite data last read by (s - 1, i - 1..i + 1),
+// which covers in-place sweeps (fdtd-2d) as well as ping-pong sweeps between
+// two arrays (jacobi, heat-3d: one step per half timestep).
+//
+// The engine skews the (step, row) space to x = i + s and cuts it into tiles
+// of `band` steps by `width` skewed rows. A tile applies its steps to a window
+// of rows that stays cache resident, and tiles run on wavefronts b + k (band
+// b, column k) in parallel. Every update reads the same data as in the plain
+// step-by-step order, so results are bitwise identical to the reference loops.
+namespace temporal {
+
+struct Blocking {
+  int band;   // steps per tile
+  int width;  // skewed rows per tile
+};
+
+// One step at a time, all rows per step: the order of the reference loops.
+const Blocking kUnblocked = {1, 1 << 30};
+
+template <typename Update>
+void Run(int steps, int first, int last, Blocking blocking, Update update) {
+  if (steps <= 0 || last < first) return;
+  const int band = std::max(1, blocking.band);
+  const int width = std::max(1, blocking.width);
+  const int bands = (steps + band - 1) / band;
+  // Columns of band b: skewed rows first + s0 .. last + s1.
+  auto column_lo = [&](int b) { return (first + b * band) / width; };
+  auto column_hi = [&](int b) {
+    return (last + std::min(steps, (b + 1) * band) - 1) / width;
+  };
+  const int w_lo = column_lo(0);
+  const int w_hi = bands - 1 + column_hi(bands - 1);
+
+  auto run_tile = [&](int b, int k) {
+    if (k < column_lo(b) || k > column_hi(b)) return;
+    const int s_end = std::min(steps, (b + 1) * band);
+    for (int s = b * band; s < s_end; ++s) {
+      const int i_lo = std::max(first, k * width - s);
+      const int i_hi = std::min(last, (k + 1) * width - 1 - s);
+      for (int i = i_lo; i <= i_hi; ++i) update(s, i);
+    }
+  };
+  for (int w = w_lo; w <= w_hi; ++w) {
+    const int b_lo = std::max(0, w - column_hi(bands - 1));
+    const int b_hi = std::min(bands - 1, w - w_lo);
+    if (b_lo == b_hi) {
+      run_tile(b_lo, w - b_lo);
+      continue;
+    }
+#pragma omp parallel for schedule(dynamic)
+    for (int b = b_lo; b <= b_hi; ++b) run_tile(b, w - b);
+  }
+}
+
+// The time-stepped stencils of data/sources for any grid size. Arrays are
+// row-major; the default blockings keep a tile in L2 on large grids.
+// Jacobi1d counts rows in chunks of 64 points.
+const Blocking kJacobi1dBlocking = {40, 128};
+const Blocking kJacobi2dBlocking = {16, 16};
+const Blocking kHeat3dBlocking = {8, 8};
+const Blocking kFdtd2dBlocking = {16, 16};
+
+void Jacobi1d(int tsteps, int n, double* a, double* b,
+              Blocking blocking = kJacobi1dBlocking);
+void Jacobi2d(int tsteps, int n, double* a, double* b,
+              Blocking blocking = kJacobi2dBlocking);
+void Heat3d(int tsteps, int n, double* a, double* b,
+            Blocking blocking = kHeat3dBlocking);
+// ex, ey and hz are nx x ny; fict holds tmax values.
+void Fdtd2d(int tmax, int nx, int ny, double* ex, double* ey, double* hz,
+            const double* fict, Blocking blocking = kFdtd2dBlocking);
+
+}  // namespace temporal
+
+#endif
@@ -0,0 +1,294 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cache.h"
+#include "jobs.h"
+#include "kernels.h"
+#include "verify.h"
+
+using std::clog;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// The response directories of one model and prompt, by response number.
+using Responses = std::map<int, fs::path>;
+
+std::map<std::pair<string, string>, Responses> FindResponses(
+    const fs::path& root) {
+  const std::regex response("prompt_(.+)_res_(\\d+)");
+  std::map<std::pair<string, string>, Responses> found;
+  for (const fs::directory_entry& model : fs::directory_iterator(root)) {
+    if (!model.is_directory()) continue;
+    for (const fs::directory_entry& dir : fs::directory_iterator(model)) {
+      std::smatch match;
+      const string name = dir.path().filename().string();
+      if (!dir.is_directory() || !std::regex_match(name, match, response)) {
+        continue;
+      }
+      found[{model.path().filename().string(), match[1]}]
+           [std::stoi(match[2])] = dir.path();
+    }
+  }
+  return found;
+}
+
+// One build to check: a transformed source as compiled for one target, and
+// every transformed source that normalises to the same text.
+struct Build {
+  size_t target;  // index in verify::Targets()
+  fs::path source;
+  string function;  // the top-level function, empty when there is none
+  string key;       // of the object, see cache::Key
+  string verdict;   // the key of the outcome: object, checker and function
+  std::unique_ptr<verify::Library> library;
+  void (*call)() = nullptr;
+  verify::Outcome outcome = verify::Outcome::kCompileError;
+  string detail;  // the worst element, see verify::Explain
+  vector<fs::path> sources;  // that share the build, in results order
+};
+
+// The results line of a source, with the path as test.py writes it.
+string Line(const fs::path& shown, const fs::path& sources,
+            const fs::path& source, const Build& build) {
+  string line = (shown / fs::relative(source, sources)).string() + ": " +
+                verify::Describe(build.outcome);
+  if (!build.detail.empty()) line += " " + build.detail;
+  return line;
+}
+
+}  // namespace
+
+// Checks every transformed kernel of the verification set under
+// transformed_sources/<model>/prompt_<p>_res_<r> against its original and
+// writes results_<model>_prompt_<p>.txt, one line per response and kernel in
+// the order of test.py. Outputs beyond the harness's 1e-6 but within the ULPs
+// allowed for the kernel (see verify::Target) are reported as rounding, and
+// lines of differing outputs name the worst element. Compiles and checks run
+// on `jobs` threads, one per core by default, and verdicts are printed as they
+// come. Objects and verdicts are kept in a cache directory keyed by the
+// normalised source (see cache::Normalize), so that sources repeated across
+// responses are compiled and checked once, and later runs only those they
+// have not seen. Failed compiles and loads and timeouts are not kept:
+//   verify [-j jobs] [-c cache-dir | --no-cache]
+//          [transformed-dir [results-dir]]
+int main(int argc, char** argv) {
+  int workers = 0;
+  string cache_dir = "verify-cache";
+  vector<string> paths;
+  bool usage = false;
+  for (int i = 1; i < argc; ++i) {
+    const string arg = argv[i];
+    if (arg == "-j" && i + 1 < argc) {
+      workers = std::atoi(argv[++i]);
+    } else if (arg.rfind("-j", 0) == 0 && arg.size() > 2) {
+      workers = std::atoi(arg.c_str() + 2);
+    } else if (arg == "-c" && i + 1 < argc) {
+      cache_dir = argv[++i];
+    } else if (arg == "--no-cache") {
+      cache_dir.clear();
+    } else if (arg.rfind("-", 0) == 0) {
+      usage = true;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (usage || paths.size() > 2 || workers < 0) {
+    clog << "Usage: " << argv[0]
+         << " [-j jobs] [-c cache-dir | --no-cache]"
+            " [transformed-dir [results-dir]]\n";
+    return EXIT_FAILURE;
+  }
+  const fs::path sources =
+      fs::path(paths.size() > 0 ? paths[0] : "../transformed_sources")
+          .lexically_normal();
+  const fs::path results = paths.size() > 1 ? paths[1] : "../verification";
+  fs::create_directories(results);
+  const fs::path shown = sources.has_filename()
+                             ? sources.filename()
+                             : sources.parent_path().filename();
+
+  int error = 0;
+  vector<const kernels::Kernel*> originals;
+  vector<verify::Checker> checkers;
+  for (const verify::Target& target : verify::Targets()) {
+    originals.push_back(kernels::FindKernel(target.kernel));
+    checkers.emplace_back(*originals.back(), target.outputs, target.tolerance);
+  }
+
+  std::unique_ptr<cache::Store> store;
+  if (!cache_dir.empty()) store = std::make_unique<cache::Store>(cache_dir);
+  const string flags =
+      string(verify::kCompileFlags) + " gcc " + verify::CompilerVersion();
+
+  char temp[] = "/tmp/verify-XXXXXX";
+  if (mkdtemp(temp) == nullptr) {
+    clog << "Cannot create a temporary directory" << endl;
+    return EXIT_FAILURE;
+  }
+  const fs::path objects = temp;
+
+  // One results file per model and prompt, one source per line of it, each
+  // pointing at its build.
+  vector<std::pair<fs::path, vector<std::pair<fs::path, Build*>>>> files;
+  std::map<string, Build> builds;  // by verdict key
+  for (const auto& [run, responses] : FindResponses(sources)) {
+    files.emplace_back(
+        results / ("results_" + run.first + "_prompt_" + run.second + ".txt"),
+        vector<std::pair<fs::path, Build*>>());
+    for (const auto& [number, dir] : responses) {
+      for (size_t t = 0; t < originals.size(); ++t) {
+        const fs::path source = dir / originals[t]->source;
+        if (!fs::exists(source)) {
+          clog << source.string() << " is missing" << endl;
+          ++error;
+          continue;
+        }
+        const string code = verify::ReadFile(source);
+        const string function =
+            verify::TopLevelFunction(code, originals[t]->function);
+        const string key = cache::Key(code, flags);
+        const string verdict = cache::Hasher()
+                                   .Add(key)
+                                   .Add(checkers[t].Fingerprint())
+                                   .Add(function)
+                                   .Hex();
+        Build& build = builds[verdict];
+        if (build.sources.empty()) {
+          build.target = t;
+          build.source = source;
+          build.function = function;
+          build.key = key;
+          build.verdict = verdict;
+        }
+        build.sources.push_back(source);
+        files.back().second.emplace_back(source, &build);
+      }
+    }
+  }
+
+  std::mutex mutex;
+  std::map<verify::Outcome, int> counts;
+  int compiled = 0;
+  int cached = 0;
+  auto report = [&](const Build& build) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const fs::path& source : build.sources) {
+      ++counts[build.outcome];
+      cout << Line(shown, sources, source, build) << endl;
+    }
+  };
+
+  jobs::Graph graph;
+  int objects_made = 0;
+  for (auto& [verdict, build] : builds) {
+    // A stored verdict is its description, then the detail on a line.
+    string stored;
+    if (store && store->GetOutcome(verdict, &stored) &&
+        verify::Parse(stored.substr(0, stored.find('\n')), &build.outcome) &&
+        build.outcome != verify::Outcome::kCompileError) {
+      if (stored.find('\n') != string::npos) {
+        build.detail = stored.substr(stored.find('\n') + 1);
+      }
+      ++cached;
+      report(build);
+      continue;
+    }
+    const fs::path object = objects / (std::to_string(objects_made++) + ".so");
+    const jobs::Graph::Id made = graph.Add([&, object] {
+      verify::Loaded loaded = verify::LoadBuild(
+          build.source, build.key, build.function, store.get(), object);
+      if (loaded.compiled) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++compiled;
+      }
+      build.library = std::move(loaded.library);
+      build.call = loaded.call;
+    });
+    graph.Add(
+        [&] {
+          if (build.call != nullptr) {
+            verify::Worst worst;
+            build.outcome = checkers[build.target].Check(build.call, &worst);
+            if (build.outcome == verify::Outcome::kRounding ||
+                build.outcome == verify::Outcome::kDifferent) {
+              build.detail = verify::Explain(
+                  *originals[build.target], worst,
+                  verify::Targets()[build.target].tolerance);
+            }
+          } else if (build.library) {
+            build.outcome = verify::Outcome::kLoadError;
+            build.detail = !build.library->Loaded()
+                               ? "The object does not load: " +
+                                     build.library->Error() + "."
+                           : build.function.empty()
+                               ? "The source defines no function."
+                               : "It defines no " + build.function + ".";
+          }
+          build.library.reset();
+          // Only the verdicts of a check are stored: a failed compile or load
+          // may be a one-off, and a timeout may only mean a busy machine, so
+          // those are tried again.
+          if (store && build.call != nullptr &&
+              build.outcome != verify::Outcome::kTimeout) {
+            store->PutOutcome(build.verdict,
+                              string(verify::Describe(build.outcome)) + "\n" +
+                                  build.detail);
+          }
+          report(build);
+        },
+        {made});
+  }
+
+  const auto begin = std::chrono::steady_clock::now();
+  graph.Run(workers);
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - begin)
+                             .count();
+  fs::remove_all(objects);
+
+  for (const auto& [file, lines] : files) {
+    std::ofstream out(file);
+    for (const auto& [source, build] : lines) {
+      out << Line(shown, sources, source, *build) << "\n";
+    }
+    if (!out) {
+      clog << "Cannot write " << file.string() << endl;
+      ++error;
+    }
+  }
+
+  int total = 0;
+  for (const auto& [outcome, count] : counts) {
+    cout << verify::Describe(outcome) << " " << count << endl;
+    total += count;
+  }
+  cout << total << " transformed kernels checked in " << seconds << " s: "
+       << builds.size() << " distinct, " << cached << " known from the cache, "
+       << compiled << " compiled" << endl;
+
+  if (error != 0) {
+    clog << "Found " << error << " error" << (error > 1 ? "s\n" : "\n");
+    clog << "FAIL" << endl;
+    return EXIT_FAILURE;
+  }
+  clog << "PASS" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,424 @@
+#include "verify.h"
+
+#include "cache.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+
+namespace verify {
+
+namespace {
+
+std::string Quote(const std::string& s) {
+  std::string quoted = "'";
+  for (char c : s) {
+    if (c == '\'') {
+      quoted += "'\\''";
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "'";
+}
+
+// Runs a shell command and returns whether it exited with 0, with its output
+// in *output.
+bool Run(const std::string& command, std::string* output) {
+  FILE* pipe = popen(command.c_str(), "r");
+  if (pipe == nullptr) {
+    throw std::system_error(errno, std::generic_category(), "popen");
+  }
+  output->clear();
+  char buffer[4096];
+  size_t n;
+  while ((n = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+    output->append(buffer, n);
+  }
+  const int status = pclose(pipe);
+  return status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Zeroes the stack below the caller, so that a transformed kernel reading
+// locals it never set sees zeros, whichever thread forked the child.
+__attribute__((noinline)) void ScrubStack() {
+  char scratch[1 << 16];
+  std::memset(scratch, 0, sizeof(scratch));
+  asm volatile("" : : "r"(scratch) : "memory");
+}
+
+// Exit codes of the checking child, clear of the 0 and 1 of a transformed
+// kernel that calls exit().
+enum ExitCode { kExitSame = 70, kExitDifferent = 71, kExitRounding = 72 };
+
+// Element j of array i as a double, for reporting.
+double Element(const kernels::Args& args, int i, size_t j) {
+  const void* data = args.Data(i);
+  switch (args.Spec(i).type) {
+    case kernels::Type::kChar: return static_cast<const char*>(data)[j];
+    case kernels::Type::kUChar:
+      return static_cast<const unsigned char*>(data)[j];
+    case kernels::Type::kInt: return static_cast<const int*>(data)[j];
+    case kernels::Type::kLong:
+      return static_cast<double>(static_cast<const long*>(data)[j]);
+    case kernels::Type::kDouble: return static_cast<const double*>(data)[j];
+  }
+  return 0.0;
+}
+
+// Stats of an array that must match exactly: every differing element is
+// beyond tolerance, and the first is the worst.
+compare::Stats CompareExactly(const kernels::Args& expected,
+                              const kernels::Args& out, int i) {
+  compare::Stats stats;
+  stats.count = out.Count(i);
+  if (std::memcmp(expected.Data(i), out.Data(i), out.Bytes(i)) == 0) {
+    return stats;
+  }
+  const size_t size = kernels::SizeOf(out.Spec(i).type);
+  const char* e = static_cast<const char*>(expected.Data(i));
+  const char* o = static_cast<const char*>(out.Data(i));
+  for (size_t j = stats.count; j-- > 0;) {
+    if (std::memcmp(e + j * size, o + j * size, size) == 0) continue;
+    ++stats.differing;
+    stats.worst = j;
+  }
+  stats.beyond = stats.beyond_absolute = stats.differing;
+  stats.max_ulps = stats.worst_ulps = compare::kMaxUlps;
+  stats.worst_expected = Element(expected, i, stats.worst);
+  stats.worst_actual = Element(out, i, stats.worst);
+  return stats;
+}
+
+// The rank of an array's stats for picking the worst one.
+std::tuple<bool, bool, uint64_t> Rank(const compare::Stats& stats) {
+  return {stats.beyond > 0, stats.beyond_absolute > 0, stats.worst_ulps};
+}
+
+}  // namespace
+
+// test.py's plain gcc, which also keeps the behaviour of transformed code that
+// relies on undefined behaviour, and the headers it pastes in front of the
+// kernels, which often call sqrt or pow without including math.h.
+const char* const kCompileFlags =
+    "-shared -fPIC -O0 -w -include stdio.h -include stdlib.h -include math.h "
+    "-include time.h -include string.h";
+
+const std::vector<Target>& Targets() {
+  // ULPs allowed by how many terms a reordered loop may sum per element:
+  // dot products over a dimension, a few neighbours for stencils, and the
+  // sqrt and division after the sums for correlation. Integer arrays compare
+  // exactly regardless.
+  static const std::vector<Target> targets = {
+      {"bicg", {"s", "q"}, {1e-6, 64}},
+      {"doitgen", {"sum"}, {1e-6, 64}},
+      {"atax", {"y", "tmp"}, {1e-6, 64}},
+      {"gemver", {"w", "x", "y", "z"}, {1e-6, 64}},
+      {"syrk", {"C"}, {1e-6, 64}},
+      {"md", {"force_x", "force_y", "force_z"}, {1e-6, 64}},
+      {"heat-3d", {"B"}, {1e-6, 16}},
+      {"fdtd-2d", {"ex", "ey", "hz"}, {1e-6, 16}},
+      {"stencil", {"sol"}, {1e-6, 0}},
+      {"adi", {"u", "v", "p", "q"}, {1e-6, 16}},
+      {"seidel-2d", {"A"}, {1e-6, 16}},
+      {"covariance", {"cov", "mean"}, {1e-6, 64}},
+      {"correlation", {"corr"}, {1e-6, 256}},
+  };
+  return targets;
+}
+
+const Target* FindTarget(const std::string& kernel) {
+  for (const Target& target : Targets()) {
+    if (target.kernel == kernel) return &target;
+  }
+  return nullptr;
+}
+
+const char* Describe(Outcome outcome) {
+  switch (outcome) {
+    case Outcome::kEquivalent:
+      return "Success: The outputs of both functions are equivalent.";
+    case Outcome::kRounding:
+      return "Success: The outputs differ only by rounding.";
+    case Outcome::kDifferent:
+      return "Failure: The outputs of the functions differ.";
+    case Outcome::kCompileError: return "Compilation failed.";
+    case Outcome::kLoadError:
+      return "Failure: The transformed function could not be loaded.";
+    case Outcome::kCrash: return "Failure: The transformed function crashed.";
+    case Outcome::kTimeout:
+      return "Failure: The transformed function timed out.";
+  }
+  return "?";
+}
+
+bool Parse(const std::string& text, Outcome* outcome) {
+  for (Outcome o : {Outcome::kEquivalent, Outcome::kRounding,
+                    Outcome::kDifferent, Outcome::kCompileError,
+                    Outcome::kLoadError, Outcome::kCrash,
+                    Outcome::kTimeout}) {
+    if (text == Describe(o)) {
+      *outcome = o;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string CompilerVersion() {
+  std::string version;
+  if (!Run("gcc -dumpfullversion -dumpversion 2>/dev/null", &version)) {
+    return "";
+  }
+  while (!version.empty() &&
+         std::isspace(static_cast<unsigned char>(version.back()))) {
+    version.pop_back();
+  }
+  return version;
+}
+
+bool Compile(const std::string& source, const std::string& object,
+             std::string* log) {
+  return Run(std::string("gcc ") + kCompileFlags + " -o " + Quote(object) +
+                 " " + Quote(source) + " -lm 2>&1",
+             log);
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+std::string TopLevelFunction(const std::string& code,
+                             const std::string& original) {
+  const std::regex named("\\bvoid\\s+" + original + "\\s*\\(");
+  if (std::regex_search(code, named)) {
+    return original;
+  }
+  std::smatch match;
+  if (std::regex_search(code, match, std::regex("\\bvoid\\s+(\\w+)\\s*\\("))) {
+    return match[1];
+  }
+  return "";
+}
+
+Library::Library(const std::string& object)
+    : handle_(dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL)) {
+  if (handle_ == nullptr) {
+    error_ = dlerror();
+    // dlerror names the object first.
+    if (error_.rfind(object + ": ", 0) == 0) {
+      error_.erase(0, object.size() + 2);
+    }
+  }
+}
+
+Library::~Library() {
+  if (handle_ != nullptr) dlclose(handle_);
+}
+
+void (*Library::Function(const std::string& name) const)() {
+  if (handle_ == nullptr) return nullptr;
+  return reinterpret_cast<void (*)()>(dlsym(handle_, name.c_str()));
+}
+
+Loaded LoadBuild(const std::string& source, const std::string& key,
+                 const std::string& function, const cache::Store* store,
+                 const std::string& object) {
+  Loaded loaded;
+  std::string built = object;
+  if (store != nullptr && store->HasObject(key)) {
+    built = store->Object(key);
+  } else {
+    std::string log;
+    if (!Compile(source, object, &log)) return loaded;
+    loaded.compiled = true;
+    if (store != nullptr) {
+      store->PutObject(key, object);
+      built = store->Object(key);
+    }
+  }
+  loaded.library = std::make_unique<Library>(built);
+  if (store == nullptr) std::remove(object.c_str());
+  if (!function.empty()) loaded.call = loaded.library->Function(function);
+  return loaded;
+}
+
+Checker::Checker(const kernels::Kernel& kernel,
+                 const std::vector<std::string>& outputs,
+                 const compare::Tolerance& tolerance, unsigned seed)
+    : kernel_(kernel),
+      outputs_(OutputIndices(kernel, outputs)),
+      tolerance_(tolerance),
+      input_(kernels::MakeArgs(kernel, seed)),
+      expected_(input_) {
+  kernel_.run(expected_);
+
+  cache::Hasher hash;
+  hash.Add(kernel.name).Add(&tolerance_.absolute, sizeof(tolerance_.absolute));
+  hash.Add(&tolerance_.ulps, sizeof(tolerance_.ulps));
+  hash.Add(&kTimeoutSeconds, sizeof(kTimeoutSeconds));
+  for (int i : outputs_) hash.Add(&i, sizeof(i));
+  for (int i = 0; i < input_.Size(); ++i) {
+    hash.Add(input_.Data(i), input_.Bytes(i));
+    hash.Add(expected_.Data(i), expected_.Bytes(i));
+  }
+  fingerprint_ = hash.Hex();
+}
+
+Outcome Checker::Check(void (*function)(), Worst* worst) const {
+  // The child leaves the worst array here for the parent.
+  void* shared = mmap(nullptr, sizeof(Worst), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "mmap");
+  }
+  Worst* found = new (shared) Worst;
+  std::fflush(nullptr);
+  const pid_t pid = fork();
+  if (pid < 0) throw std::system_error(errno, std::generic_category(), "fork");
+  if (pid == 0) {
+    Silence();
+    alarm(kTimeoutSeconds);
+    const kernels::Args out = CallGuarded(kernel_, function, input_);
+    switch (Judge(expected_, out, outputs_, tolerance_, found)) {
+      case Outcome::kEquivalent: _exit(kExitSame);
+      case Outcome::kRounding: _exit(kExitRounding);
+      default: _exit(kExitDifferent);
+    }
+  }
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "waitpid");
+    }
+  }
+  if (worst != nullptr) *worst = *found;
+  munmap(shared, sizeof(Worst));
+  if (WIFSIGNALED(status)) {
+    return WTERMSIG(status) == SIGALRM ? Outcome::kTimeout : Outcome::kCrash;
+  }
+  switch (WIFEXITED(status) ? WEXITSTATUS(status) : -1) {
+    case kExitSame: return Outcome::kEquivalent;
+    case kExitRounding: return Outcome::kRounding;
+    case kExitDifferent: return Outcome::kDifferent;
+    default: return Outcome::kCrash;
+  }
+}
+
+std::vector<int> OutputIndices(const kernels::Kernel& kernel,
+                               const std::vector<std::string>& outputs) {
+  std::vector<int> indices;
+  if (outputs.empty()) {
+    for (size_t i = 0; i < kernel.args.size(); ++i) {
+      if (!kernel.args[i].shape.empty()) indices.push_back(static_cast<int>(i));
+    }
+    return indices;
+  }
+  for (const std::string& name : outputs) {
+    int index = -1;
+    for (size_t i = 0; i < kernel.args.size(); ++i) {
+      if (kernel.args[i].name == name) index = static_cast<int>(i);
+    }
+    if (index < 0) {
+      throw std::invalid_argument(kernel.name + " has no argument " + name);
+    }
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+Outcome Judge(const kernels::Args& expected, const kernels::Args& out,
+              const std::vector<int>& outputs,
+              const compare::Tolerance& tolerance, Worst* worst) {
+  Worst local;
+  if (worst == nullptr) worst = &local;
+  *worst = Worst();
+  for (int i : outputs) {
+    const compare::Stats stats =
+        out.Spec(i).type == kernels::Type::kDouble
+            ? compare::Compare(static_cast<const double*>(expected.Data(i)),
+                               static_cast<const double*>(out.Data(i)),
+                               out.Count(i), tolerance)
+            : CompareExactly(expected, out, i);
+    if (stats.differing > 0 &&
+        (worst->arg < 0 || Rank(stats) > Rank(worst->stats))) {
+      worst->arg = i;
+      worst->stats = stats;
+    }
+  }
+  if (worst->arg < 0 || worst->stats.beyond_absolute == 0) {
+    return Outcome::kEquivalent;
+  }
+  return worst->stats.beyond == 0 ? Outcome::kRounding : Outcome::kDifferent;
+}
+
+std::string Explain(const kernels::Kernel& kernel, const Worst& worst,
+                    const compare::Tolerance& tolerance) {
+  if (worst.arg < 0) return "";
+  const kernels::ArgSpec& spec = kernel.args[worst.arg];
+  const compare::Stats& s = worst.stats;
+  std::ostringstream text;
+  text << std::setprecision(17) << "Worst: " << spec.name
+       << compare::Coordinates(s.worst, spec.shape) << " is " << s.worst_actual
+       << " instead of " << s.worst_expected << std::setprecision(2);
+  if (spec.type == kernels::Type::kDouble) {
+    text << " (";
+    if (s.worst_ulps == compare::kMaxUlps) {
+      text << "NaN or infinity";
+    } else {
+      text << s.worst_ulps << " ULPs";
+    }
+    text << "; max relative error " << s.max_relative << ")";
+  }
+  if (s.beyond > 0) {
+    text << "; " << s.beyond << " of " << s.count
+         << " elements beyond tolerance";
+  } else {
+    text << "; " << s.beyond_absolute << " of " << s.count
+         << " elements beyond " << tolerance.absolute << ", all within "
+         << tolerance.ulps << " ULPs";
+  }
+  if (s.nan_mismatches > 0) text << ", " << s.nan_mismatches << " NaN";
+  if (s.inf_mismatches > 0) text << ", " << s.inf_mismatches << " infinite";
+  text << ".";
+  return text.str();
+}
+
+void Silence() {
+  // Transformed kernels may print; keep that out of the results.
+  const int null = open("/dev/null", O_WRONLY);
+  if (null >= 0) {
+    dup2(null, STDOUT_FILENO);
+    dup2(null, STDERR_FILENO);
+  }
+}
+
+kernels::Args CallGuarded(const kernels::Kernel& kernel, void (*function)(),
+                          const kernels::Args& input) {
+  kernels::Args out = kernels::Args::Guarded(input);
+  ScrubStack();
+  kernel.call(function, out);
+  return out;
+}
+
+}  // namespace verify
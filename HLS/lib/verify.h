@@ -0,0 +1,180 @@
+#ifndef VERIFY_H_
+#define VERIFY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cache.h"
+#include "compare.h"
+#include "kernels.h"
+
+// Equivalence checks of transformed kernels against the originals in
+// data/sources, in place of the gcc+run cycle of verification/test.py. Each
+// transformed source is compiled once into a shared object and loaded with
+// dlopen; its top-level function is then called through the registry entry of
+// the original, on the inputs of the original, in a forked copy of the
+// checking process, so that a crash or an endless loop costs one verdict and
+// not the run.
+namespace verify {
+
+// A kernel of the verification set, the arrays its test_<kernel>.c harness
+// compares, and how far from the original's their elements may be for a
+// reordered computation: the harness's 1e-6, or else `tolerance.ulps`.
+struct Target {
+  std::string kernel;  // registry name
+  std::vector<std::string> outputs;
+  compare::Tolerance tolerance;
+};
+
+// The kernels test.py checks, in the order of its results files.
+const std::vector<Target>& Targets();
+
+// nullptr when `kernel` is not in the verification set.
+const Target* FindTarget(const std::string& kernel);
+
+// kEquivalent is the harness's verdict: every element within 1e-6. kRounding
+// has elements beyond that, but all within the ULPs of the kernel's tolerance,
+// as sums taken in another order round differently; kDifferent has elements
+// beyond both. kLoadError is a build that compiled but could not be loaded
+// or lacks the top-level function.
+enum class Outcome {
+  kEquivalent,
+  kRounding,
+  kDifferent,
+  kCompileError,
+  kLoadError,
+  kCrash,
+  kTimeout,
+};
+
+// The verdict as written after the path in the results files.
+const char* Describe(Outcome outcome);
+
+// The outcome `Describe` gives `text` for; false when there is none.
+bool Parse(const std::string& text, Outcome* outcome);
+
+// The gcc options of Compile.
+extern const char* const kCompileFlags;
+
+// The version gcc reports, for keying cached objects. Empty when gcc fails.
+std::string CompilerVersion();
+
+// Compiles a transformed kernel source into the shared object `object`, with
+// the headers test.py puts in front of every kernel. Returns false when gcc
+// fails, with its diagnostics in *log.
+bool Compile(const std::string& source, const std::string& object,
+             std::string* log);
+
+// The text of the file at `path`, e.g. a transformed source; empty when it
+// cannot be read.
+std::string ReadFile(const std::string& path);
+
+// The function of a transformed source that stands for the original top-level
+// function `original`: the function of that name, or else the first function
+// the source defines, as test.py renames it. Empty when there is none.
+std::string TopLevelFunction(const std::string& code,
+                             const std::string& original);
+
+// A shared object loaded with dlopen, unloaded on destruction.
+class Library {
+ public:
+  explicit Library(const std::string& object);
+  ~Library();
+  Library(const Library&) = delete;
+  Library& operator=(const Library&) = delete;
+
+  bool Loaded() const { return handle_ != nullptr; }
+  // Why dlopen failed, e.g. "undefined symbol: min".
+  const std::string& Error() const { return error_; }
+  // nullptr when the library does not define `name`.
+  void (*Function(const std::string& name) const)();
+
+ private:
+  void* handle_;
+  std::string error_;
+};
+
+// A transformed source as LoadBuild leaves it.
+struct Loaded {
+  std::unique_ptr<Library> library;  // null when gcc failed
+  // null unless the library loaded and defines the function
+  void (*call)() = nullptr;
+  bool compiled = false;  // whether gcc ran, rather than the store had it
+};
+
+// Takes the object of `key` from `store` when it has one, or else compiles
+// `source` into `object` and moves that into the store, if any, under `key`;
+// without a store the object is removed once loaded. Then loads it and looks
+// up `function`, unless that is empty. Safe to call from several threads.
+Loaded LoadBuild(const std::string& source, const std::string& key,
+                 const std::string& function, const cache::Store* store,
+                 const std::string& object);
+
+// The compared array that is furthest off, with the element that is.
+struct Worst {
+  int arg = -1;  // -1 when every array matches exactly
+  compare::Stats stats;
+};
+
+// Runs the original of a target once from a seed and checks transformed
+// builds of its function against the result.
+class Checker {
+ public:
+  static constexpr unsigned kTimeoutSeconds = 10;
+
+  // Double arrays are compared with compare::Compare; other arrays must match
+  // exactly.
+  Checker(const kernels::Kernel& kernel,
+          const std::vector<std::string>& outputs,
+          const compare::Tolerance& tolerance = {}, unsigned seed = 42);
+
+  // Runs `function` in a forked child on a guarded copy of the inputs (see
+  // kernels::Args::Guarded), so that out-of-bounds accesses get the same
+  // verdict whichever thread checks, and fills *worst, when given, for
+  // kRounding and kDifferent. Safe to call from several threads.
+  Outcome Check(void (*function)(), Worst* worst = nullptr) const;
+
+  // A hash of everything a verdict depends on besides the function: the
+  // inputs, the original's outputs, the compared arrays and the limits.
+  const std::string& Fingerprint() const { return fingerprint_; }
+
+ private:
+  const kernels::Kernel& kernel_;
+  std::vector<int> outputs_;
+  compare::Tolerance tolerance_;
+  kernels::Args input_;
+  kernels::Args expected_;
+  std::string fingerprint_;
+};
+
+// The parts of Check, for checks that fork children of their own.
+
+// The indices of the arguments of `kernel` named in `outputs`, or of all its
+// arrays when `outputs` is empty. Throws std::invalid_argument for a name the
+// kernel does not have.
+std::vector<int> OutputIndices(const kernels::Kernel& kernel,
+                               const std::vector<std::string>& outputs);
+
+// kEquivalent, kRounding or kDifferent for the `outputs` of `out` against
+// those of `expected`, with the worst array in *worst when given.
+Outcome Judge(const kernels::Args& expected, const kernels::Args& out,
+              const std::vector<int>& outputs,
+              const compare::Tolerance& tolerance, Worst* worst = nullptr);
+
+// The worst element of a check for a results line, e.g. "Worst: corr[3][7]
+// is 0.25 instead of 0.5 (...)". Empty when every array matches exactly.
+std::string Explain(const kernels::Kernel& kernel, const Worst& worst,
+                    const compare::Tolerance& tolerance);
+
+// Sends the output of the calling process, a checking child, to /dev/null.
+void Silence();
+
+// Runs `function` through `kernel` on a guarded copy of `input` (see
+// kernels::Args::Guarded) from a scrubbed stack, and returns the copy.
+kernels::Args CallGuarded(const kernels::Kernel& kernel, void (*function)(),
+                          const kernels::Args& input);
+
+}  // namespace verify
+
+#endif